@@ -0,0 +1,566 @@
+/**
+ * Traitement par lots des fichiers de matrices d'un repertoire.
+ * \file main.cpp
+ * \author Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ * \date 27 Février 2020
+ *
+ * Usage : ./batch repertoire recette [-t entiers|pixels] [-j travailleurs]
+ *                 [-m megaoctets] [-o repertoire]
+ *
+ * Chaque fichier du repertoire (texte, binaire pour l'extension .bin ou, en
+ * pixels, image PPM P3 ou P6 pour l'extension .ppm) est charge, transforme
+ * par la recette, puis ecrit dans le repertoire -o, au meme format (P6 pour
+ * une image PPM) et sous le meme nom, s'il est donne. La recette est une suite
+ * d'etapes separees par des virgules, appliquees dans l'ordre :
+ *   droite, gauche, demi, miroir-h, miroir-v   pivotements
+ *   x2, x3, ..., x64                           agrandissement entier
+ *   taille=HxW[:filtre], facteur=F[:filtre]    redimensionnement, filtre
+ *                                              proche, boite ou bilineaire
+ *   moyenne=R, gauss=S, sobel-x, sobel-y,      convolutions (bords etendus)
+ *   nettete[=F]
+ *   gris, gamma=G, luminosite=L                couleurs (pixels seulement)
+ * Par exemple : ./batch images droite,x2,gauss=1.5 -j 4 -o sortie
+ *
+ * Un lecteur charge les fichiers pendant que -j travailleurs (par defaut un
+ * par coeur) appliquent la recette, chacun a son image. Le lecteur s'arrete
+ * tant que les matrices chargees et pas encore ecrites occupent plus de -m
+ * megaoctets (256 par defaut, au moins 1) ; le budget peut etre depasse de
+ * la derniere matrice chargee, et les transformations qui agrandissent
+ * l'image ne sont pas comptees. Chaque fichier est rapporte avec ses temps
+ * de chargement, d'attente, de traitement et d'ecriture et sa latence
+ * totale ; le bilan donne le debit en fichiers et en megapixels par seconde.
+ **/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "FichierPPM.h"
+#include "Image.h"
+#include "Matrice.h"
+#include "Pixel.h"
+
+namespace
+{
+    using Horloge = std::chrono::steady_clock;
+
+    // Plus grand rapport d'agrandissement entier d'une etape xN
+    constexpr size_t RAPPORT_MAXIMAL = 64;
+
+    double millisecondes(Horloge::time_point debut, Horloge::time_point fin)
+    {
+        return std::chrono::duration<double, std::milli>(fin - debut).count();
+    }
+
+    struct Options
+    {
+        std::string repertoire;
+        std::string recette;
+        std::string type = "pixels";
+        size_t travailleurs = std::max(1u, std::thread::hardware_concurrency());
+        size_t budget = 256;
+        std::string sortie;
+    };
+
+    /**
+     * Mesures d'un fichier, en millisecondes depuis le debut de son chargement
+     */
+    struct Resultat
+    {
+        std::string nom;
+        bool reussi = false;
+        size_t height = 0;
+        size_t width = 0;
+        double chargement = 0.0;
+        double attente = 0.0;
+        double traitement = 0.0;
+        double ecriture = 0.0;
+        double latence = 0.0;
+    };
+
+    template<typename T>
+    using Etape = std::function<bool(Image<Matrice<T>>&)>;
+
+    bool lireFiltre(const std::string& nom, Filtre& filtre)
+    {
+        if (nom == "proche")
+            filtre = Filtre::NearestNeighbour;
+        else if (nom == "boite")
+            filtre = Filtre::Box;
+        else if (nom == "bilineaire")
+            filtre = Filtre::Bilinear;
+        else
+            return false;
+        return true;
+    }
+
+    /**
+     * Lit un entier positif ou nul ecrit en base 10 ; false si texte contient
+     * autre chose que des chiffres
+     */
+    bool lireEntier(const std::string& texte, size_t& entier)
+    {
+        if (texte.empty() || !std::isdigit(static_cast<unsigned char>(texte[0])))
+            return false;
+        char* fin = nullptr;
+        entier = std::strtoul(texte.c_str(), &fin, 10);
+        return *fin == '\0';
+    }
+
+    /**
+     * Convertit une etape de la recette ; false si elle est inconnue ou ne
+     * s'applique pas au type T
+     */
+    template<typename T>
+    bool lireEtape(const std::string& texte, Etape<T>& etape)
+    {
+        size_t egal = texte.find('=');
+        std::string nom = texte.substr(0, egal);
+        std::string valeur = egal == std::string::npos ? "" : texte.substr(egal + 1);
+        std::string parametre = valeur.substr(0, valeur.find(':'));
+        Filtre filtre = Filtre::Bilinear;
+        if (valeur.find(':') != std::string::npos &&
+            !lireFiltre(valeur.substr(valeur.find(':') + 1), filtre))
+            return false;
+
+        const std::pair<const char*, Direction> directions[] = {
+            {"droite", Direction::Right},
+            {"gauche", Direction::Left},
+            {"demi", Direction::UpsideDown},
+            {"miroir-h", Direction::FlipHorizontal},
+            {"miroir-v", Direction::FlipVertical}};
+        for (const auto& [mot, direction] : directions)
+            if (nom == mot)
+            {
+                etape = [direction = direction](Image<Matrice<T>>& image) {
+                    return image.pivoterMatrice(direction);
+                };
+                return true;
+            }
+
+        if (nom.size() > 1 && nom[0] == 'x')
+        {
+            size_t rapport = 0;
+            if (!lireEntier(nom.substr(1), rapport) || rapport == 0 || rapport > RAPPORT_MAXIMAL)
+                return false;
+            etape = [rapport](Image<Matrice<T>>& image) {
+                image.redimensionnerImage(static_cast<unsigned int>(rapport));
+                return true;
+            };
+            return true;
+        }
+        if (nom == "taille")
+        {
+            size_t x = parametre.find('x');
+            size_t height = 0;
+            size_t width = 0;
+            if (x == std::string::npos || !lireEntier(parametre.substr(0, x), height) ||
+                !lireEntier(parametre.substr(x + 1), width))
+                return false;
+            etape = [height, width, filtre](Image<Matrice<T>>& image) {
+                image.redimensionnerImage(height, width, filtre);
+                return true;
+            };
+            return height > 0 && width > 0;
+        }
+
+        char* fin = nullptr;
+        float nombre = std::strtof(parametre.c_str(), &fin);
+        bool nombreLu = !parametre.empty() && *fin == '\0';
+        if (nom == "facteur" && nombreLu && nombre > 0.0f)
+        {
+            etape = [nombre, filtre](Image<Matrice<T>>& image) {
+                image.redimensionnerImage(nombre, filtre);
+                return true;
+            };
+            return true;
+        }
+
+        Noyau noyau = {};
+        if (nom == "moyenne" && nombreLu && nombre >= 0.0f)
+            noyau = noyauMoyenne(size_t(nombre));
+        else if (nom == "gauss" && nombreLu && nombre > 0.0f)
+            noyau = noyauGaussien(nombre);
+        else if (nom == "sobel-x" && valeur.empty())
+            noyau = noyauSobelX();
+        else if (nom == "sobel-y" && valeur.empty())
+            noyau = noyauSobelY();
+        else if (nom == "nettete" && (valeur.empty() || nombreLu))
+            noyau = noyauNettete(valeur.empty() ? 1.0f : nombre);
+        if (noyau.estValide())
+        {
+            etape = [noyau](Image<Matrice<T>>& image) { return image.convoluer(noyau); };
+            return true;
+        }
+
+        if constexpr (std::is_same_v<T, Pixel>)
+        {
+            if (nom == "gris" && valeur.empty())
+                etape = [](Image<Matrice<T>>& image) {
+                    image.convertirEnGris();
+                    return true;
+                };
+            else if (nom == "gamma" && nombreLu && nombre > 0.0f)
+                etape = [nombre](Image<Matrice<T>>& image) {
+                    image.appliquerGamma(nombre);
+                    return true;
+                };
+            else if (nom == "luminosite" && nombreLu)
+                etape = [nombre](Image<Matrice<T>>& image) {
+                    image.ajusterLuminositeContraste(int(nombre));
+                    return true;
+                };
+            return bool(etape);
+        }
+        return false;
+    }
+
+    template<typename T>
+    bool lireRecette(const std::string& recette, std::vector<Etape<T>>& etapes)
+    {
+        std::istringstream flux(recette);
+        std::string texte;
+        while (std::getline(flux, texte, ','))
+        {
+            Etape<T> etape;
+            if (!lireEtape<T>(texte, etape))
+            {
+                std::cerr << "Etape inconnue pour ce type : " << texte << std::endl;
+                return false;
+            }
+            etapes.push_back(std::move(etape));
+        }
+        return !etapes.empty();
+    }
+
+    bool estBinaire(const std::filesystem::path& chemin)
+    {
+        return chemin.extension() == ".bin";
+    }
+
+    template<typename T>
+    bool charger(const std::filesystem::path& chemin, Matrice<T>& matrice)
+    {
+        if constexpr (std::is_same_v<T, Pixel>)
+        {
+            if (chemin.extension() == ".ppm")
+                return chargerFichierPPM(matrice, chemin.string());
+        }
+        return estBinaire(chemin) ? matrice.chargerFichierBinaire(chemin.string())
+                                  : matrice.chargerDepuisFichier(chemin.string());
+    }
+
+    template<typename T>
+    bool sauvegarder(const std::filesystem::path& chemin, const Matrice<T>& matrice)
+    {
+        if constexpr (std::is_same_v<T, Pixel>)
+        {
+            if (chemin.extension() == ".ppm")
+                return sauvegarderFichierPPM(matrice, chemin.string());
+        }
+        return estBinaire(chemin) ? matrice.sauvegarderFichierBinaire(chemin.string())
+                                  : matrice.sauvegarderFichierTexte(chemin.string());
+    }
+
+    /**
+     * Fichier charge, en attente d'un travailleur
+     */
+    template<typename T>
+    struct Travail
+    {
+        std::filesystem::path chemin;
+        std::unique_ptr<Matrice<T>> matrice;
+        size_t octets;
+        Resultat resultat;
+        Horloge::time_point debut;
+        Horloge::time_point charge;
+    };
+
+    /**
+     * File entre le lecteur et les travailleurs, bornee par le nombre
+     * d'octets des matrices chargees et pas encore ecrites
+     */
+    template<typename T>
+    class FileTravaux
+    {
+    public:
+        explicit FileTravaux(size_t budget)
+            : budget_(budget)
+            , octets_(0)
+            , maximum_(0)
+            , terminee_(false)
+        {
+        }
+
+        void attendreBudget()
+        {
+            std::unique_lock<std::mutex> verrou(mutex_);
+            changement_.wait(verrou, [&] { return octets_ < budget_; });
+        }
+
+        void ajouter(Travail<T> travail)
+        {
+            std::lock_guard<std::mutex> garde(mutex_);
+            octets_ += travail.octets;
+            maximum_ = std::max(maximum_, octets_);
+            travaux_.push_back(std::move(travail));
+            changement_.notify_all();
+        }
+
+        bool prendre(Travail<T>& travail)
+        {
+            std::unique_lock<std::mutex> verrou(mutex_);
+            changement_.wait(verrou, [&] { return !travaux_.empty() || terminee_; });
+            if (travaux_.empty())
+                return false;
+            travail = std::move(travaux_.front());
+            travaux_.pop_front();
+            return true;
+        }
+
+        void liberer(size_t octets, Resultat resultat)
+        {
+            std::lock_guard<std::mutex> garde(mutex_);
+            octets_ -= octets;
+            resultats_.push_back(std::move(resultat));
+            changement_.notify_all();
+        }
+
+        void terminer()
+        {
+            std::lock_guard<std::mutex> garde(mutex_);
+            terminee_ = true;
+            changement_.notify_all();
+        }
+
+        std::vector<Resultat>& getResultats() { return resultats_; }
+        size_t getMaximum() const { return maximum_; }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable changement_;
+        std::deque<Travail<T>> travaux_;
+        std::vector<Resultat> resultats_;
+        size_t budget_;
+        size_t octets_;
+        size_t maximum_;
+        bool terminee_;
+    };
+
+    template<typename T>
+    void lireFichiers(const std::vector<std::filesystem::path>& chemins, FileTravaux<T>& file)
+    {
+        for (const std::filesystem::path& chemin : chemins)
+        {
+            file.attendreBudget();
+            Travail<T> travail;
+            travail.chemin = chemin;
+            travail.resultat.nom = chemin.filename().string();
+            travail.debut = Horloge::now();
+            travail.matrice = std::make_unique<Matrice<T>>();
+            travail.resultat.reussi = charger(chemin, *travail.matrice);
+            travail.charge = Horloge::now();
+            travail.resultat.chargement = millisecondes(travail.debut, travail.charge);
+            travail.resultat.height = travail.matrice->getHeight();
+            travail.resultat.width = travail.matrice->getWidth();
+            travail.octets = travail.resultat.height * travail.resultat.width * sizeof(T);
+            file.ajouter(std::move(travail));
+        }
+        file.terminer();
+    }
+
+    template<typename T>
+    void traiterFichiers(const std::vector<Etape<T>>& etapes, const std::string& sortie,
+                         FileTravaux<T>& file)
+    {
+        Travail<T> travail;
+        while (file.prendre(travail))
+        {
+            Resultat& resultat = travail.resultat;
+            Horloge::time_point debut = Horloge::now();
+            resultat.attente = millisecondes(travail.charge, debut);
+
+            // Un resultat trop grand pour la memoire (std::bad_alloc) fait
+            // echouer son fichier, sans arreter le thread ni les autres fichiers
+            Image<Matrice<T>> image(std::move(travail.matrice));
+            try
+            {
+                for (size_t i = 0; i < etapes.size() && resultat.reussi; ++i)
+                    resultat.reussi = etapes[i](image);
+            }
+            catch (const std::exception&)
+            {
+                resultat.reussi = false;
+            }
+            Horloge::time_point traite = Horloge::now();
+            resultat.traitement = millisecondes(debut, traite);
+
+            if (resultat.reussi && !sortie.empty())
+            {
+                std::filesystem::path chemin = std::filesystem::path(sortie) /
+                                               travail.chemin.filename();
+                try
+                {
+                    resultat.reussi = sauvegarder(chemin, *image.getMatrice());
+                }
+                catch (const std::exception&)
+                {
+                    resultat.reussi = false;
+                }
+            }
+            Horloge::time_point fin = Horloge::now();
+            resultat.ecriture = millisecondes(traite, fin);
+            resultat.latence = millisecondes(travail.debut, fin);
+            file.liberer(travail.octets, std::move(resultat));
+        }
+    }
+
+    double centile(std::vector<double> valeurs, double rang)
+    {
+        if (valeurs.empty())
+            return 0.0;
+        std::sort(valeurs.begin(), valeurs.end());
+        return valeurs[std::min(valeurs.size() - 1, size_t(rang * double(valeurs.size())))];
+    }
+
+    void afficherBilan(std::vector<Resultat>& resultats, double duree, size_t maximum)
+    {
+        std::sort(resultats.begin(), resultats.end(),
+                  [](const Resultat& premier, const Resultat& second) {
+                      return premier.nom < second.nom;
+                  });
+
+        std::cout << std::left << std::setw(24) << "fichier" << std::right << std::setw(13)
+                  << "dimensions" << std::setw(11) << "charg. ms" << std::setw(11) << "attente"
+                  << std::setw(11) << "traitement" << std::setw(11) << "ecriture"
+                  << std::setw(11) << "latence" << std::endl;
+        size_t reussis = 0;
+        double megapixels = 0.0;
+        std::vector<double> latences;
+        for (const Resultat& resultat : resultats)
+        {
+            std::ostringstream dimensions;
+            dimensions << resultat.height << " x " << resultat.width;
+            std::cout << std::left << std::setw(24) << resultat.nom << std::right << std::setw(13)
+                      << dimensions.str() << std::fixed << std::setprecision(2) << std::setw(11)
+                      << resultat.chargement << std::setw(11) << resultat.attente << std::setw(11)
+                      << resultat.traitement << std::setw(11) << resultat.ecriture
+                      << std::setw(11) << resultat.latence
+                      << (resultat.reussi ? "" : "  ECHEC") << std::endl;
+            if (!resultat.reussi)
+                continue;
+            reussis++;
+            megapixels += double(resultat.height * resultat.width) / 1e6;
+            latences.push_back(resultat.latence);
+        }
+
+        std::cout << std::endl
+                  << reussis << " fichiers traites sur " << resultats.size() << " en "
+                  << std::setprecision(1) << duree << " ms : "
+                  << double(reussis) * 1000.0 / duree << " fichiers/s, "
+                  << megapixels * 1000.0 / duree << " Mpx/s" << std::endl
+                  << "latence mediane " << centile(latences, 0.5) << " ms, p99 "
+                  << centile(latences, 0.99) << " ms, maximale " << centile(latences, 1.0)
+                  << " ms ; au plus " << double(maximum) / 1e6 << " Mo charges a la fois"
+                  << std::endl;
+    }
+
+    template<typename T>
+    int traiterRepertoire(const Options& options)
+    {
+        std::vector<Etape<T>> etapes;
+        if (!lireRecette<T>(options.recette, etapes))
+            return 1;
+
+        std::error_code erreur;
+        std::vector<std::filesystem::path> chemins;
+        for (const auto& entree : std::filesystem::directory_iterator(options.repertoire, erreur))
+            if (entree.is_regular_file())
+                chemins.push_back(entree.path());
+        if (erreur)
+        {
+            std::cerr << "Repertoire illisible : " << options.repertoire << std::endl;
+            return 1;
+        }
+        std::sort(chemins.begin(), chemins.end());
+        if (!options.sortie.empty())
+            std::filesystem::create_directories(options.sortie, erreur);
+
+        FileTravaux<T> file(options.budget * 1000000);
+        Horloge::time_point debut = Horloge::now();
+        std::thread lecteur([&] { lireFichiers(chemins, file); });
+        std::vector<std::thread> travailleurs;
+        for (size_t i = 0; i < options.travailleurs; ++i)
+            travailleurs.emplace_back([&] { traiterFichiers(etapes, options.sortie, file); });
+        lecteur.join();
+        for (std::thread& travailleur : travailleurs)
+            travailleur.join();
+
+        afficherBilan(file.getResultats(), millisecondes(debut, Horloge::now()),
+                      file.getMaximum());
+        return 0;
+    }
+
+    bool lireOptions(int argc, char* argv[], Options& options)
+    {
+        if (argc < 3)
+            return false;
+        options.repertoire = argv[1];
+        options.recette = argv[2];
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            std::string option = argv[i];
+            std::string valeur = argv[i + 1];
+            if (option == "-t")
+                options.type = valeur;
+            else if (option == "-j")
+            {
+                if (!lireEntier(valeur, options.travailleurs))
+                    return false;
+                options.travailleurs = std::max<size_t>(1, options.travailleurs);
+            }
+            else if (option == "-m")
+            {
+                // Un budget nul bloquerait le lecteur avant le premier fichier
+                if (!lireEntier(valeur, options.budget) || options.budget == 0)
+                    return false;
+            }
+            else if (option == "-o")
+                options.sortie = valeur;
+            else
+                return false;
+        }
+        return argc % 2 == 1 && (options.type == "entiers" || options.type == "pixels");
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!lireOptions(argc, argv, options))
+    {
+        std::cerr << "Usage : " << argv[0]
+                  << " repertoire recette [-t entiers|pixels] [-j travailleurs]"
+                     " [-m megaoctets] [-o repertoire]"
+                  << std::endl;
+        return 1;
+    }
+
+    if (options.type == "entiers")
+        return traiterRepertoire<int>(options);
+    return traiterRepertoire<Pixel>(options);
+}
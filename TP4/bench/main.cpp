@@ -0,0 +1,1249 @@
+/**
+ * Mesures de performance des classes generiques du TP4.
+ * \file main.cpp
+ * \author Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ * \date 27 Février 2020
+ *
+ * Usage : ./bench [taille]...   (par defaut : 100 1000)
+ *         ./bench threads [taille] (par defaut : 8192)
+ *         ./bench csv [-r repetitions] [-w echauffement] [taille]...
+ *                 (par defaut : 10 repetitions, 2 d'echauffement, 256 1024)
+ * Chaque taille N mesure les operations de chaque fonction mesurer* sur des
+ * matrices N x N. Le mode threads mesure l'acceleration avec 1, 2, 4 et 8
+ * travailleurs ; le mode csv ecrit une ligne CSV par operation, de quoi
+ * comparer deux commits.
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "CouleurInternee.h"
+#include "FichierPPM.h"
+#include "Image.h"
+#include "Matrice.h"
+#include "MatricePlanaire.h"
+#include "MatriceFixe.h"
+#include "MatriceTuilee.h"
+#include "MatriceVue.h"
+#include "Pixel.h"
+#include "TableSommes.h"
+
+namespace
+{
+    // Nombre d'appels a operator new depuis le debut du programme
+    std::atomic<size_t> nombreAllocations(0);
+} // namespace
+
+void* operator new(size_t taille)
+{
+    nombreAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memoire = std::malloc(taille != 0 ? taille : 1))
+        return memoire;
+    throw std::bad_alloc();
+}
+
+// GCC voit free() recevoir un pointeur de operator new une fois celui-ci remplace
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* memoire) noexcept
+{
+    std::free(memoire);
+}
+
+void operator delete(void* memoire, size_t) noexcept
+{
+    std::free(memoire);
+}
+#pragma GCC diagnostic pop
+
+namespace
+{
+    using Horloge = std::chrono::steady_clock;
+
+    double millisecondesDepuis(Horloge::time_point debut)
+    {
+        return std::chrono::duration<double, std::milli>(Horloge::now() - debut).count();
+    }
+
+    void ecrireMatriceNombres(const std::string& nomFichier, size_t taille)
+    {
+        std::ofstream fichier(nomFichier);
+        for (size_t y = 0; y < taille; y++)
+        {
+            fichier << "L\n";
+            for (size_t x = 0; x < taille; x++)
+                fichier << (y * 31 + x * 17) % 100 << '\n';
+        }
+    }
+
+    void ecrireMatricePixels(const std::string& nomFichier, size_t taille)
+    {
+        std::ofstream fichier(nomFichier);
+        for (size_t y = 0; y < taille; y++)
+        {
+            fichier << "L\n";
+            for (size_t x = 0; x < taille; x++)
+                fichier << (y * 7) % 256 << ' ' << (x * 13) % 256 << ' ' << (x + y) % 300
+                        << '\n';
+        }
+    }
+
+    void ecrireMatriceCouleurs(const std::string& nomFichier, size_t taille)
+    {
+        const char* noms[] = {"Rouge", "Vert", "Bleu", "Jaune", "Cyan", "Magenta", "Noir",
+                              "Blanc", "Orange", "Violet", "Turquoise", "Bordeaux"};
+        std::ofstream fichier(nomFichier);
+        for (size_t y = 0; y < taille; y++)
+        {
+            fichier << "L\n";
+            for (size_t x = 0; x < taille; x++)
+                fichier << noms[(y * 7 + x * 5) % 12] << '\n';
+        }
+    }
+
+    void afficherMesure(const std::string& operation, size_t taille, double ms)
+    {
+        std::cout << std::left << std::setw(16) << operation << std::right << std::setw(6)
+                  << taille << " x " << std::setw(6) << taille << " : " << std::fixed
+                  << std::setprecision(3) << std::setw(12) << ms << " ms" << std::endl;
+    }
+
+    void afficherDebit(const std::string& operation, size_t taille, double ms)
+    {
+        std::cout << std::left << std::setw(16) << operation << std::right << std::setw(6)
+                  << taille << " x " << std::setw(6) << taille << " : " << std::fixed
+                  << std::setprecision(1) << std::setw(12) << double(taille * taille) / ms / 1000.0
+                  << " Mpx/s" << std::endl;
+    }
+
+    /**
+     * @brief chargement texte d'une matrice d'entiers, puis son pivotement et son
+     * agrandissement x2
+     */
+    void mesurerNombres(size_t taille)
+    {
+        const std::string nomFichier = "bench_matrice_" + std::to_string(taille) + ".txt";
+        ecrireMatriceNombres(nomFichier, taille);
+
+        auto matrice = std::make_unique<Matrice<int>>();
+        Horloge::time_point debut = Horloge::now();
+        bool charge = matrice->chargerDepuisFichier(nomFichier);
+        afficherMesure("chargement", taille, millisecondesDepuis(debut));
+        std::remove(nomFichier.c_str());
+        if (!charge)
+        {
+            std::cerr << "Echec du chargement de " << nomFichier << std::endl;
+            return;
+        }
+
+        Image<Matrice<int>> image(std::move(matrice));
+
+        debut = Horloge::now();
+        image.pivoterMatrice(Direction::Left);
+        afficherMesure("pivotement", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        image.redimensionnerImage(2);
+        afficherMesure("agrandir x2", taille, millisecondesDepuis(debut));
+    }
+
+    /**
+     * @brief chargement d'une matrice de pixels en texte et en binaire projete en
+     * memoire, pivotement de la projection, puis ecriture et lecture en PPM (P6 puis P3)
+     */
+    void mesurerChargementPixels(size_t taille)
+    {
+        const std::string nomFichier = "bench_pixels_" + std::to_string(taille) + ".txt";
+        ecrireMatricePixels(nomFichier, taille);
+
+        Matrice<Pixel> matrice;
+        Horloge::time_point debut = Horloge::now();
+        matrice.chargerDepuisFichier(nomFichier);
+        afficherMesure("chargement px", taille, millisecondesDepuis(debut));
+        std::remove(nomFichier.c_str());
+
+        const std::string nomBinaire = "bench_pixels_" + std::to_string(taille) + ".bin";
+        matrice.sauvegarderFichierBinaire(nomBinaire);
+        Matrice<Pixel> projetee;
+        debut = Horloge::now();
+        projetee.chargerFichierBinaire(nomBinaire);
+        afficherMesure("projection px", taille, millisecondesDepuis(debut));
+
+        Image<Matrice<Pixel>> image(std::make_unique<Matrice<Pixel>>());
+        image.getMatrice()->chargerFichierBinaire(nomBinaire);
+        debut = Horloge::now();
+        image.pivoterMatrice(Direction::Right);
+        afficherMesure("pivot. proj.", taille, millisecondesDepuis(debut));
+        std::remove(nomBinaire.c_str());
+
+        const std::string nomPPM = "bench_pixels_" + std::to_string(taille) + ".ppm";
+        for (FormatPPM format : {FormatPPM::Binaire, FormatPPM::Texte})
+        {
+            const std::string variante = format == FormatPPM::Binaire ? " P6" : " P3";
+            debut = Horloge::now();
+            sauvegarderFichierPPM(matrice, nomPPM, format);
+            afficherMesure("ecriture" + variante, taille, millisecondesDepuis(debut));
+
+            Matrice<Pixel> lue;
+            debut = Horloge::now();
+            chargerFichierPPM(lue, nomPPM);
+            afficherMesure("lecture" + variante, taille, millisecondesDepuis(debut));
+        }
+        std::remove(nomPPM.c_str());
+    }
+
+    std::unique_ptr<Matrice<Pixel>> genererPixels(size_t height, size_t width)
+    {
+        auto matrice = std::make_unique<Matrice<Pixel>>(height, width);
+        for (size_t y = 0; y < height; y++)
+            for (size_t x = 0; x < width; x++)
+                matrice->ajouterElement(Pixel(uint8_t(y), uint8_t(x), uint8_t(x + y)), y, x);
+        return matrice;
+    }
+
+    /**
+     * @brief pivotements et miroir d'une image de pixels carree, puis quart de tour d'une
+     * image N x N/2
+     */
+    void mesurerPivotementsPixels(size_t taille)
+    {
+        const std::pair<Direction, std::string> directions[] = {
+            {Direction::Right, "px droite"},
+            {Direction::Left, "px gauche"},
+            {Direction::UpsideDown, "px demi-tour"},
+            {Direction::FlipHorizontal, "px miroir"},
+        };
+
+        Image<Matrice<Pixel>> image(genererPixels(taille, taille));
+        for (const auto& [direction, nom] : directions)
+        {
+            Horloge::time_point debut = Horloge::now();
+            image.pivoterMatrice(direction);
+            afficherMesure(nom, taille, millisecondesDepuis(debut));
+        }
+
+        Image<Matrice<Pixel>> rectangle(genererPixels(taille, taille / 2));
+        Horloge::time_point debut = Horloge::now();
+        rectangle.pivoterMatrice(Direction::Right);
+        afficherMesure("px rect. dr.", taille, millisecondesDepuis(debut));
+    }
+
+    /**
+     * @brief agrandissements x2 et x3 d'une image de pixels, puis reductions au quart
+     * avec chaque filtre
+     */
+    void mesurerAgrandissementsPixels(size_t taille)
+    {
+        for (unsigned int rapport : {2u, 3u})
+        {
+            Image<Matrice<Pixel>> image(genererPixels(taille, taille));
+            Horloge::time_point debut = Horloge::now();
+            image.redimensionnerImage(rapport);
+            afficherMesure("px agrandir x" + std::to_string(rapport), taille,
+                           millisecondesDepuis(debut));
+        }
+
+        const std::pair<Filtre, std::string> filtres[] = {
+            {Filtre::NearestNeighbour, "px /4 proche"},
+            {Filtre::Box, "px /4 boite"},
+            {Filtre::Bilinear, "px /4 bilin."},
+        };
+        for (const auto& [filtre, nom] : filtres)
+        {
+            Image<Matrice<Pixel>> image(genererPixels(taille, taille));
+            Horloge::time_point debut = Horloge::now();
+            image.redimensionnerImage(0.25f, filtre);
+            afficherMesure(nom, taille, millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief suite pivotement, miroir et agrandissement x3 en mode immediat, puis en mode
+     * differe (une seule passe)
+     */
+    void mesurerPipelinePixels(size_t taille)
+    {
+        for (bool differe : {false, true})
+        {
+            Image<Matrice<Pixel>> image(genererPixels(taille, taille));
+            image.setModeDiffere(differe);
+            Horloge::time_point debut = Horloge::now();
+            image.pivoterMatrice(Direction::Right);
+            image.pivoterMatrice(Direction::FlipVertical);
+            image.redimensionnerImage(3u);
+            image.materialiser();
+            afficherMesure(differe ? "px suite diff." : "px suite imm.", taille,
+                           millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief conversions vers et depuis MatricePlanaire, puis pivotement, agrandissement
+     * x2 et reduction bilineaire au quart en plans
+     */
+    void mesurerPlanaire(size_t taille)
+    {
+        std::unique_ptr<Matrice<Pixel>> entrelacee = genererPixels(taille, taille);
+        Horloge::time_point debut = Horloge::now();
+        auto planaire = std::make_unique<MatricePlanaire>(*entrelacee);
+        afficherMesure("pl. separer", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        entrelacee = planaire->versEntrelacee();
+        afficherMesure("pl. entrelacer", taille, millisecondesDepuis(debut));
+
+        using Operation = std::function<void(Image<MatricePlanaire>&)>;
+        const std::pair<std::string, Operation> operations[] = {
+            {"pl. droite",
+             [](Image<MatricePlanaire>& image) { image.pivoterMatrice(Direction::Right); }},
+            {"pl. x2", [](Image<MatricePlanaire>& image) { image.redimensionnerImage(2u); }},
+            {"pl. /4 bilin.",
+             [](Image<MatricePlanaire>& image) {
+                 image.redimensionnerImage(0.25f, Filtre::Bilinear);
+             }},
+        };
+        for (const auto& [nom, operation] : operations)
+        {
+            Image<MatricePlanaire> image(std::make_unique<MatricePlanaire>(*entrelacee));
+            debut = Horloge::now();
+            operation(image);
+            afficherMesure(nom, taille, millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief operations de couleur d'une image de type M, en megapixels par seconde
+     */
+    template<class M>
+    void mesurerCouleurs(const std::string& prefixe, size_t taille)
+    {
+        using Operation = std::function<void(Image<M>&)>;
+        const std::pair<std::string, Operation> operations[] = {
+            {"lum.", [](Image<M>& image) { image.ajusterLuminositeContraste(20); }},
+            {"lum. contr.", [](Image<M>& image) { image.ajusterLuminositeContraste(20, 1.2f); }},
+            {"gamma", [](Image<M>& image) { image.appliquerGamma(2.2f); }},
+            {"gris", [](Image<M>& image) { image.convertirEnGris(); }},
+            {"bgr",
+             [](Image<M>& image) { image.permuterCanaux(Canal::Bleu, Canal::Vert, Canal::Rouge); }},
+            {"somme", [](Image<M>& image) { image.additionner(image); }},
+        };
+
+        Image<M> image(std::make_unique<M>(*genererPixels(taille, taille)));
+        for (const auto& [nom, operation] : operations)
+        {
+            Horloge::time_point debut = Horloge::now();
+            operation(image);
+            afficherDebit(prefixe + nom, taille, millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief operations de couleur en pixels entrelaces, apres une boucle de setters
+     * comme reference, puis en plans
+     */
+    void mesurerCouleursPixels(size_t taille)
+    {
+        // Reference : ce qu'ecrirait un appelant sans operations de couleur
+        std::unique_ptr<Matrice<Pixel>> matrice = genererPixels(taille, taille);
+        Horloge::time_point debut = Horloge::now();
+        for (size_t y = 0; y < taille; y++)
+        {
+            Pixel* ligne = matrice->getLigne(y);
+            for (size_t x = 0; x < taille; x++)
+            {
+                ligne[x].setRouge(ligne[x].getRouge() + 20);
+                ligne[x].setVert(ligne[x].getVert() + 20);
+                ligne[x].setBleu(ligne[x].getBleu() + 20);
+            }
+        }
+        afficherDebit("px lum. setters", taille, millisecondesDepuis(debut));
+
+        mesurerCouleurs<Matrice<Pixel>>("px ", taille);
+        mesurerCouleurs<MatricePlanaire>("pl. ", taille);
+    }
+
+    /**
+     * @brief reference : l'affichage par element d'avant, un operator<< et un std::endl
+     * par ligne
+     */
+    template<class M>
+    void afficherParElement(const M& matrice, std::ostream& os)
+    {
+        for (size_t y = 0; y < matrice.getHeight(); y++)
+        {
+            for (size_t x = 0; x < matrice.getWidth(); x++)
+                os << matrice(y, x) << (x + 1 < matrice.getWidth() ? " | " : " |");
+            os << std::endl;
+        }
+        os << std::dec;
+    }
+
+    /**
+     * @brief affichage d'une image (operateur <<, compare a la boucle par element), puis
+     * sauvegarde et relecture au format texte
+     */
+    template<class M>
+    void mesurerEcriture(const std::string& prefixe, std::unique_ptr<M> matrice, size_t taille)
+    {
+        const std::string nomFichier = "bench_ecriture_" + std::to_string(taille) + ".txt";
+        Image<M> image(std::move(matrice));
+
+        std::ostringstream reference;
+        Horloge::time_point debut = Horloge::now();
+        afficherParElement(*image.getMatrice(), reference);
+        afficherMesure(prefixe + "aff. elem.", taille, millisecondesDepuis(debut));
+
+        std::ostringstream affichage;
+        debut = Horloge::now();
+        affichage << &image;
+        afficherMesure(prefixe + "affichage", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        image.getMatrice()->sauvegarderFichierTexte(nomFichier);
+        afficherMesure(prefixe + "sauv. texte", taille, millisecondesDepuis(debut));
+
+        M relue;
+        debut = Horloge::now();
+        relue.chargerDepuisFichier(nomFichier);
+        afficherMesure(prefixe + "relecture", taille, millisecondesDepuis(debut));
+        std::remove(nomFichier.c_str());
+    }
+
+    /**
+     * @brief affichage et format texte en entiers et en pixels
+     */
+    void mesurerEcritures(size_t taille)
+    {
+        auto nombres = std::make_unique<Matrice<int>>(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                nombres->ajouterElement(int(y * 31 + x * 17) % 1000 - 500, y, x);
+
+        mesurerEcriture("", std::move(nombres), taille);
+        mesurerEcriture("px ", genererPixels(taille, taille), taille);
+    }
+
+    /**
+     * @brief image de pixels rangee par tuiles, avec un budget du quart de sa taille :
+     * remplissage, pivotement, agrandissement x2 et ecriture binaire
+     */
+    void mesurerTuilee(size_t taille)
+    {
+        std::unique_ptr<Matrice<Pixel>> pixels = genererPixels(taille, taille);
+        size_t budget = taille * taille * sizeof(Pixel) / 4;
+        auto matrice = std::make_unique<MatriceTuilee<Pixel>>(taille, taille, budget);
+
+        Horloge::time_point debut = Horloge::now();
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                matrice->ajouterElement(pixels->getLigne(y)[x], y, x);
+        afficherMesure("tu. remplir", taille, millisecondesDepuis(debut));
+
+        Image<MatriceTuilee<Pixel>> image(std::move(matrice));
+        debut = Horloge::now();
+        image.pivoterMatrice(Direction::Right);
+        afficherMesure("tu. droite", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        image.redimensionnerImage(2u);
+        afficherMesure("tu. x2", taille, millisecondesDepuis(debut));
+
+        const std::string nomFichier = "bench_tuiles_" + std::to_string(taille) + ".bin";
+        debut = Horloge::now();
+        image.getMatrice()->sauvegarderFichierBinaire(nomFichier);
+        afficherMesure("tu. sauv. bin.", taille, millisecondesDepuis(debut));
+        std::remove(nomFichier.c_str());
+    }
+
+    /**
+     * @brief blocs 8 x 8 pivotes puis agrandis x2, en Matrice<int> avec PivoterMatrice et
+     * AgrandirMatrice, puis en Matrice<int, 8, 8> avec pivotee<D>() et agrandie<2>()
+     */
+    void mesurerFixes(size_t taille)
+    {
+        const size_t blocs = (taille / 8) * (taille / 8);
+        long long somme = 0;
+
+        Horloge::time_point debut = Horloge::now();
+        for (size_t b = 0; b < blocs; b++)
+        {
+            Matrice<int> bloc(8, 8);
+            for (size_t i = 0; i < 64; i++)
+                bloc.ajouterElement(int(b + i), i / 8, i % 8);
+            PivoterMatrice<Matrice<int>>(&bloc).pivoterMatrice(Direction::Right);
+            AgrandirMatrice<Matrice<int>>(&bloc).redimensionnerImage(2u);
+            for (size_t y = 0; y < 16; y++)
+                somme += std::accumulate(bloc.getLigne(y), bloc.getLigne(y) + 16, 0LL);
+        }
+        afficherMesure("blocs 8x8 dyn.", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        for (size_t b = 0; b < blocs; b++)
+        {
+            Matrice<int, 8, 8> bloc;
+            for (size_t i = 0; i < 64; i++)
+                bloc.ajouterElement(int(b + i), i / 8, i % 8);
+            Matrice<int, 16, 16> resultat = bloc.pivotee<Direction::Right>().agrandie<2>();
+            for (size_t y = 0; y < 16; y++)
+                somme -= std::accumulate(resultat.getLigne(y), resultat.getLigne(y) + 16, 0LL);
+        }
+        afficherMesure("blocs 8x8 fixes", taille, millisecondesDepuis(debut));
+
+        if (somme != 0)
+            std::cout << "blocs 8x8 : resultats differents" << std::endl;
+    }
+
+    /**
+     * @brief chargement, clone, comparaison au clone et pivotement d'une matrice
+     * d'elements T
+     */
+    template<class T>
+    void mesurerCouleur(const std::string& prefixe, const std::string& nomFichier,
+                        size_t taille)
+    {
+        auto matrice = std::make_unique<Matrice<T>>();
+        Horloge::time_point debut = Horloge::now();
+        matrice->chargerDepuisFichier(nomFichier);
+        afficherMesure(prefixe + "chargement", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        std::unique_ptr<Matrice<T>> copie = matrice->clone();
+        afficherMesure(prefixe + "clone", taille, millisecondesDepuis(debut));
+
+        debut = Horloge::now();
+        size_t egaux = 0;
+        for (size_t y = 0; y < taille; y++)
+        {
+            T* ligne = copie->getLigne(y);
+            const T* ligneSource = matrice->getLigne(y);
+            for (size_t x = 0; x < taille; x++)
+                egaux += ligne[x] == ligneSource[x];
+        }
+        afficherMesure(prefixe + "comparaison", taille, millisecondesDepuis(debut));
+        if (egaux != taille * taille)
+            std::cout << prefixe << "comparaison : clone different" << std::endl;
+
+        Image<Matrice<T>> image(std::move(matrice));
+        debut = Horloge::now();
+        image.pivoterMatrice(Direction::Right);
+        afficherMesure(prefixe + "droite", taille, millisecondesDepuis(debut));
+    }
+
+    /**
+     * @brief noms de couleurs en Couleur (une std::string par element) et en
+     * CouleurInternee (un identifiant), puis des entiers comme reference
+     */
+    void mesurerCouleurs(size_t taille)
+    {
+        const std::string nomCouleurs = "bench_couleurs_" + std::to_string(taille) + ".txt";
+        const std::string nomNombres = "bench_nombres_" + std::to_string(taille) + ".txt";
+        ecrireMatriceCouleurs(nomCouleurs, taille);
+        ecrireMatriceNombres(nomNombres, taille);
+
+        mesurerCouleur<Couleur>("co. ", nomCouleurs, taille);
+        mesurerCouleur<CouleurInternee>("ci. ", nomCouleurs, taille);
+        mesurerCouleur<int>("en. ", nomNombres, taille);
+
+        std::remove(nomCouleurs.c_str());
+        std::remove(nomNombres.c_str());
+    }
+
+    /**
+     * @brief comparaison d'une image a sa copie, identique puis avec une cellule
+     * differente au milieu, par une boucle sur operator() puis par ComparerMatrices
+     */
+    template<class M>
+    void mesurerComparaison(const std::string& prefixe, const M& matrice, size_t taille)
+    {
+        using Element = ElementDe<M>;
+        std::unique_ptr<M> copie = matrice.clone();
+        ComparerMatrices<M> comparaison(&matrice);
+        // Pixel n'a pas d'operateur == : la boucle compare les octets
+        auto boucle = [&]() {
+            size_t differents = 0;
+            for (size_t y = 0; y < taille; y++)
+                for (size_t x = 0; x < taille; x++)
+                {
+                    Element premier = matrice(y, x);
+                    Element second = (*copie)(y, x);
+                    differents += std::memcmp(&premier, &second, sizeof(Element)) != 0;
+                }
+            return differents;
+        };
+
+        for (const char* cas : {"eg ", "1d "})
+        {
+            Horloge::time_point debut = Horloge::now();
+            size_t differents = boucle();
+            afficherMesure(prefixe + cas + "boucle", taille, millisecondesDepuis(debut));
+
+            debut = Horloge::now();
+            bool egale = comparaison.estEgale(*copie);
+            afficherMesure(prefixe + cas + "estEgale", taille, millisecondesDepuis(debut));
+
+            debut = Horloge::now();
+            Difference difference = comparaison.comparer(*copie);
+            afficherMesure(prefixe + cas + "comparer", taille, millisecondesDepuis(debut));
+
+            if (egale != (differents == 0) || difference.nombre != differents)
+                std::cout << prefixe << "comparaison : resultats differents" << std::endl;
+
+            // Le second passage compare a une copie differente en son milieu ;
+            // les elements generes different de leur voisin de gauche
+            copie->ajouterElement(matrice(taille / 2, taille / 2 - 1), taille / 2, taille / 2);
+        }
+    }
+
+    /**
+     * @brief comparaisons en entiers et en pixels
+     */
+    void mesurerComparaisons(size_t taille)
+    {
+        Matrice<int> nombres(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                nombres.ajouterElement(int((y * 31 + x * 17) % 100), y, x);
+        mesurerComparaison("", nombres, taille);
+        mesurerComparaison("px ", *genererPixels(taille, taille), taille);
+    }
+
+    /**
+     * @brief convolution de reference : chaque element relit ses voisins par operator(),
+     * bords etendus
+     */
+    void convoluerDirectement(const Matrice<Pixel>& source, const Noyau& noyau,
+                              Matrice<Pixel>& destination)
+    {
+        long height = long(source.getHeight());
+        long width = long(source.getWidth());
+        long rayonY = long(noyau.height / 2);
+        long rayonX = long(noyau.width / 2);
+        for (long y = 0; y < height; y++)
+            for (long x = 0; x < width; x++)
+            {
+                float somme[3] = {};
+                for (long ky = 0; ky < long(noyau.height); ky++)
+                    for (long kx = 0; kx < long(noyau.width); kx++)
+                    {
+                        float canaux[3];
+                        CanauxElement<Pixel>::lire(
+                            source(size_t(std::clamp(y + ky - rayonY, 0L, height - 1)),
+                                   size_t(std::clamp(x + kx - rayonX, 0L, width - 1))),
+                            canaux);
+                        float coefficient = noyau.coefficients[size_t(ky) * noyau.width +
+                                                               size_t(kx)];
+                        for (size_t c = 0; c < 3; c++)
+                            somme[c] += coefficient * canaux[c];
+                    }
+                destination.ajouterElement(CanauxElement<Pixel>::ecrire(somme), size_t(y),
+                                           size_t(x));
+            }
+    }
+
+    int ecartMaximal(const Matrice<Pixel>& premiere, const Matrice<Pixel>& seconde)
+    {
+        const uint8_t* gauche = reinterpret_cast<const uint8_t*>(premiere.getLigne(0));
+        const uint8_t* droite = reinterpret_cast<const uint8_t*>(seconde.getLigne(0));
+        int ecart = 0;
+        for (size_t i = 0; i < premiere.getHeight() * premiere.getWidth() * sizeof(Pixel); i++)
+            ecart = std::max(ecart, std::abs(int(gauche[i]) - int(droite[i])));
+        return ecart;
+    }
+
+    /**
+     * @brief flou gaussien (sigma 1) d'une image de pixels par une boucle directe, puis
+     * en deux passes separables et en une passe pleine, et des entiers ; puis flou de
+     * sigma 4, Sobel et accentuation
+     */
+    void mesurerConvolutions(size_t taille)
+    {
+        std::unique_ptr<Matrice<Pixel>> pixels = genererPixels(taille, taille);
+        Noyau gaussien = noyauGaussien(1.0f);
+        Noyau gaussienPlein = gaussien;
+        gaussienPlein.vertical.clear();
+        gaussienPlein.horizontal.clear();
+
+        Matrice<Pixel> destination(taille, taille);
+        Horloge::time_point debut = Horloge::now();
+        convoluerDirectement(*pixels, gaussien, destination);
+        afficherMesure("conv. directe", taille, millisecondesDepuis(debut));
+
+        const std::pair<const char*, const Noyau*> noyaux[] = {{"conv. gauss 1", &gaussien},
+                                                               {"conv. pleine", &gaussienPlein}};
+        for (const auto& [nom, noyau] : noyaux)
+        {
+            Image<Matrice<Pixel>> image(pixels->clone());
+            debut = Horloge::now();
+            image.convoluer(*noyau);
+            afficherMesure(nom, taille, millisecondesDepuis(debut));
+            // L'ordre des sommes differe : un canal peut etre arrondi autrement
+            if (ecartMaximal(*image.getMatrice(), destination) > 1)
+                std::cout << nom << " : resultat different de la boucle directe" << std::endl;
+        }
+
+        Matrice<int> nombres(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                nombres.ajouterElement(int((y * 31 + x * 17) % 100), y, x);
+        ConvoluerMatrice<Matrice<int>> convolution(&nombres);
+        debut = Horloge::now();
+        convolution.convoluer(gaussien);
+        afficherMesure("conv. en. gauss", taille, millisecondesDepuis(debut));
+
+        Image<Matrice<Pixel>> image(std::move(pixels));
+        const std::pair<const char*, Noyau> autres[] = {{"conv. gauss 4", noyauGaussien(4.0f)},
+                                                        {"conv. sobel x", noyauSobelX()},
+                                                        {"conv. nettete", noyauNettete()}};
+        for (const auto& [nom, noyau] : autres)
+        {
+            debut = Horloge::now();
+            image.convoluer(noyau);
+            afficherMesure(nom, taille, millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief statistiques de reference : deux boucles sur operator(), la seconde pour
+     * l'ecart type ; histogrammes pour les pixels seulement
+     */
+    template<typename T>
+    StatistiquesImage calculerStatistiquesDirectement(const Matrice<T>& matrice)
+    {
+        constexpr size_t canaux = CanauxElement<T>::nombre;
+        constexpr bool avecHistogramme = std::is_same_v<T, Pixel>;
+        StatistiquesImage statistiques = {matrice.getHeight() * matrice.getWidth(), {}};
+        statistiques.canaux.assign(canaux, {HUGE_VAL, -HUGE_VAL, 0.0, 0.0, {}});
+        for (StatistiquesCanal& canal : statistiques.canaux)
+            canal.histogramme.assign(avecHistogramme ? 256 : 0, 0);
+
+        for (size_t y = 0; y < matrice.getHeight(); y++)
+            for (size_t x = 0; x < matrice.getWidth(); x++)
+            {
+                float valeurs[canaux];
+                CanauxElement<T>::lire(matrice(y, x), valeurs);
+                for (size_t c = 0; c < canaux; c++)
+                {
+                    StatistiquesCanal& canal = statistiques.canaux[c];
+                    if (avecHistogramme)
+                        canal.histogramme[size_t(valeurs[c])]++;
+                    canal.minimum = std::min(canal.minimum, double(valeurs[c]));
+                    canal.maximum = std::max(canal.maximum, double(valeurs[c]));
+                    canal.moyenne += valeurs[c];
+                }
+            }
+        double nombre = double(statistiques.nombre);
+        for (StatistiquesCanal& canal : statistiques.canaux)
+            canal.moyenne /= nombre;
+
+        for (size_t y = 0; y < matrice.getHeight(); y++)
+            for (size_t x = 0; x < matrice.getWidth(); x++)
+            {
+                float valeurs[canaux];
+                CanauxElement<T>::lire(matrice(y, x), valeurs);
+                for (size_t c = 0; c < canaux; c++)
+                {
+                    double ecart = valeurs[c] - statistiques.canaux[c].moyenne;
+                    statistiques.canaux[c].ecartType += ecart * ecart;
+                }
+            }
+        for (StatistiquesCanal& canal : statistiques.canaux)
+            canal.ecartType = std::sqrt(canal.ecartType / nombre);
+        return statistiques;
+    }
+
+    /**
+     * @brief histogrammes, extremes, moyennes et ecarts types par une boucle sur
+     * operator(), puis par StatistiquesMatrice
+     */
+    template<typename T>
+    void mesurerStatistiques(const std::string& prefixe, const Matrice<T>& matrice, size_t taille)
+    {
+        Horloge::time_point debut = Horloge::now();
+        StatistiquesImage reference = calculerStatistiquesDirectement(matrice);
+        afficherMesure(prefixe + "boucle", taille, millisecondesDepuis(debut));
+
+        StatistiquesMatrice<Matrice<T>> statistiques(&matrice);
+        debut = Horloge::now();
+        StatistiquesImage resultat = statistiques.calculer();
+        afficherMesure(prefixe + "calculer", taille, millisecondesDepuis(debut));
+
+        for (size_t c = 0; c < resultat.canaux.size(); c++)
+        {
+            const StatistiquesCanal& canal = resultat.canaux[c];
+            const StatistiquesCanal& attendu = reference.canaux[c];
+            if (canal.histogramme != attendu.histogramme || canal.minimum != attendu.minimum ||
+                canal.maximum != attendu.maximum ||
+                std::abs(canal.moyenne - attendu.moyenne) > 1e-6 * (1.0 + attendu.moyenne) ||
+                std::abs(canal.ecartType - attendu.ecartType) > 1e-6 * (1.0 + attendu.ecartType))
+                std::cout << prefixe << ": resultats differents" << std::endl;
+        }
+    }
+
+    /**
+     * @brief statistiques d'une image d'entiers et d'une image de pixels
+     */
+    void mesurerStatistiques(size_t taille)
+    {
+        Matrice<int> nombres(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                nombres.ajouterElement(int((y * 31 + x * 17) % 100), y, x);
+        mesurerStatistiques("st. ", nombres, taille);
+        mesurerStatistiques("st. px ", *genererPixels(taille, taille), taille);
+    }
+
+    /**
+     * @brief table des sommes d'une image de pixels : construction, sommes de rectangles
+     * 64 x 64 (boucle sur les elements, puis table), mise a jour apres une ecriture au
+     * dernier quart des lignes, reduction Box au quart
+     */
+    void mesurerTableSommes(size_t taille)
+    {
+        std::unique_ptr<Matrice<Pixel>> pixels = genererPixels(taille, taille);
+        TableSommes<Matrice<Pixel>> table(pixels.get());
+        Horloge::time_point debut = Horloge::now();
+        table.mettreAJour();
+        afficherMesure("sommes constr.", taille, millisecondesDepuis(debut));
+
+        const size_t cote = std::min<size_t>(64, taille);
+        const size_t requetes = 10000;
+        std::vector<std::pair<size_t, size_t>> coins(requetes);
+        for (size_t i = 0; i < requetes; i++)
+            coins[i] = {(i * 7919) % (taille - cote + 1), (i * 104729) % (taille - cote + 1)};
+
+        int64_t attendu = 0;
+        debut = Horloge::now();
+        for (const auto& [y, x] : coins)
+            for (size_t dy = 0; dy < cote; dy++)
+                for (size_t dx = 0; dx < cote; dx++)
+                    attendu += pixels->getLigne(y + dy)[x + dx].getVert();
+        afficherMesure("sommes boucle", taille, millisecondesDepuis(debut));
+
+        int64_t obtenu = 0;
+        debut = Horloge::now();
+        for (const auto& [y, x] : coins)
+            obtenu += table.somme(y, x, cote, cote, 1);
+        afficherMesure("sommes table", taille, millisecondesDepuis(debut));
+        if (obtenu != attendu)
+            std::cout << "sommes : resultats differents" << std::endl;
+
+        table.ajouterElement(Pixel(1, 2, 3), taille * 3 / 4, 0);
+        debut = Horloge::now();
+        table.mettreAJour();
+        afficherMesure("sommes maj 1/4", taille, millisecondesDepuis(debut));
+
+        Matrice<Pixel> reduite;
+        debut = Horloge::now();
+        table.redimensionner(reduite, taille / 4, taille / 4);
+        afficherMesure("sommes /4 boite", taille, millisecondesDepuis(debut));
+    }
+
+    /**
+     * @brief miniatures bilineaires d'une image de pixels, sans puis avec la pyramide
+     * d'Image ; la seconde mesure compte le calcul des niveaux
+     */
+    void mesurerPyramide(size_t taille)
+    {
+        const size_t diviseurs[] = {2, 3, 5, 8, 16, 2, 3, 5, 8, 16};
+        for (bool pyramide : {false, true})
+        {
+            Image<Matrice<Pixel>> image(genererPixels(taille, taille));
+            image.setPyramide(pyramide);
+            Horloge::time_point debut = Horloge::now();
+            for (size_t diviseur : diviseurs)
+                image.copieRedimensionnee(taille / diviseur, taille / diviseur, Filtre::Bilinear);
+            afficherMesure(pyramide ? "mini. pyramide" : "mini. directes", taille,
+                           millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief rotation de 3,5 degres d'une image de pixels, aux memes dimensions : boucle
+     * bilineaire qui calcule en double la position source de chaque element, puis
+     * pivoterAngle, qui avance en virgule fixe
+     */
+    void mesurerRotation(size_t taille)
+    {
+        const double degres = 3.5;
+        const double cosinus = std::cos(degres * 3.14159265358979323846 / 180.0);
+        const double sinus = std::sin(degres * 3.14159265358979323846 / 180.0);
+        std::unique_ptr<Matrice<Pixel>> source = genererPixels(taille, taille);
+        const double centre = double(taille) / 2.0;
+        const double dernier = double(taille - 1);
+
+        Horloge::time_point debut = Horloge::now();
+        Matrice<Pixel> boucle(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+            {
+                double dx = double(x) + 0.5 - centre;
+                double dy = double(y) + 0.5 - centre;
+                double sourceX = centre + cosinus * dx + sinus * dy - 0.5;
+                double sourceY = centre - sinus * dx + cosinus * dy - 0.5;
+                if (sourceX < -0.5 || sourceY < -0.5 || sourceX >= dernier + 0.5 ||
+                    sourceY >= dernier + 0.5)
+                    continue;
+                double gauche = std::floor(sourceX);
+                double haut = std::floor(sourceY);
+                float fractionX = float(sourceX - gauche);
+                float fractionY = float(sourceY - haut);
+                float coins[4][3];
+                for (size_t coin = 0; coin < 4; coin++)
+                {
+                    double cx = std::clamp(gauche + double(coin % 2), 0.0, dernier);
+                    double cy = std::clamp(haut + double(coin / 2), 0.0, dernier);
+                    CanauxElement<Pixel>::lire((*source)(size_t(cy), size_t(cx)), coins[coin]);
+                }
+                float canaux[3];
+                for (size_t c = 0; c < 3; c++)
+                {
+                    float dessus = coins[0][c] + (coins[1][c] - coins[0][c]) * fractionX;
+                    float dessous = coins[2][c] + (coins[3][c] - coins[2][c]) * fractionX;
+                    canaux[c] = dessus + (dessous - dessus) * fractionY;
+                }
+                boucle.ajouterElement(CanauxElement<Pixel>::ecrire(canaux), y, x);
+            }
+        afficherMesure("rotation boucle", taille, millisecondesDepuis(debut));
+
+        for (Filtre filtre : {Filtre::NearestNeighbour, Filtre::Bilinear})
+        {
+            Image<Matrice<Pixel>> image(source->clone());
+            debut = Horloge::now();
+            image.pivoterAngle(degres, filtre, Cadre::Conserver);
+            afficherMesure(filtre == Filtre::Bilinear ? "rotation bilin." : "rotation proche",
+                           taille, millisecondesDepuis(debut));
+        }
+    }
+
+    /**
+     * @brief operation sur la region centrale (N/2 x N/2) d'une image : recadrage par
+     * copie des lignes, operation, puis recopie dans l'image, compare a la meme operation
+     * sur une MatriceVue de la region
+     */
+    void mesurerVues(size_t taille)
+    {
+        const std::pair<std::string, std::function<void(Image<Matrice<Pixel>>&)>> copies[] = {
+            {"gris", [](Image<Matrice<Pixel>>& image) { image.convertirEnGris(); }},
+            {"gauss", [](Image<Matrice<Pixel>>& image) { image.convoluer(noyauGaussien(1.0f)); }}};
+        const std::function<void(Image<MatriceVue<Pixel>>&)> vues[] = {
+            [](Image<MatriceVue<Pixel>>& image) { image.convertirEnGris(); },
+            [](Image<MatriceVue<Pixel>>& image) { image.convoluer(noyauGaussien(1.0f)); }};
+        size_t debutRegion = taille / 4;
+        size_t cote = taille / 2;
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            std::unique_ptr<Matrice<Pixel>> parCopie = genererPixels(taille, taille);
+            std::unique_ptr<Matrice<Pixel>> parVue = parCopie->clone();
+
+            Horloge::time_point debut = Horloge::now();
+            auto region = std::make_unique<Matrice<Pixel>>(cote, cote);
+            for (size_t y = 0; y < cote; y++)
+            {
+                const Pixel* ligne = parCopie->getLigne(debutRegion + y) + debutRegion;
+                std::copy(ligne, ligne + cote, region->getLigne(y));
+            }
+            Image<Matrice<Pixel>> image(std::move(region));
+            copies[i].second(image);
+            for (size_t y = 0; y < cote; y++)
+                std::copy(image.getMatrice()->getLigne(y), image.getMatrice()->getLigne(y) + cote,
+                          parCopie->getLigne(debutRegion + y) + debutRegion);
+            afficherMesure("vue copie " + copies[i].first, taille, millisecondesDepuis(debut));
+
+            debut = Horloge::now();
+            Image<MatriceVue<Pixel>> imageVue(
+                std::make_unique<MatriceVue<Pixel>>(*parVue, debutRegion, debutRegion, cote, cote));
+            vues[i](imageVue);
+            afficherMesure("vue " + copies[i].first, taille, millisecondesDepuis(debut));
+
+            for (size_t y = 0; y < taille; y++)
+                if (!std::equal(parCopie->getLigne(y), parCopie->getLigne(y) + taille,
+                                parVue->getLigne(y), [](const Pixel& a, const Pixel& b) {
+                                    return a.getRouge() == b.getRouge() &&
+                                           a.getVert() == b.getVert() &&
+                                           a.getBleu() == b.getBleu();
+                                }))
+                {
+                    std::cout << "vue " << copies[i].first << " : resultat different" << std::endl;
+                    break;
+                }
+        }
+    }
+
+    void afficherAllocations(const std::string& operation, size_t taille, size_t nombre)
+    {
+        std::cout << std::left << std::setw(16) << operation << std::right << std::setw(6)
+                  << taille << " x " << std::setw(6) << taille / 2 << " : " << std::setw(12)
+                  << nombre << " allocations" << std::endl;
+    }
+
+    /**
+     * @brief allocations d'un clone d'une matrice de couleurs aux noms plus longs que le
+     * tampon interne de std::string, puis d'une suite de transformations une fois leurs
+     * tampons en place
+     */
+    void mesurerAllocations(size_t taille)
+    {
+        const std::string noms[] = {"Bleu outremer profond", "Rouge vermillon eclatant",
+                                    "Vert emeraude tres fonce"};
+        auto couleurs = std::make_unique<Matrice<Couleur>>(taille, taille / 2);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille / 2; x++)
+                couleurs->ajouterElement(Couleur(noms[(x + y) % 3]), y, x);
+
+        size_t avant = nombreAllocations.load();
+        couleurs->clone();
+        afficherAllocations("alloc. clone", taille, nombreAllocations.load() - avant);
+
+        Image<Matrice<Couleur>> image(std::move(couleurs));
+        auto suite = [&]() {
+            image.pivoterMatrice(Direction::Right);
+            image.redimensionnerImage(2u);
+            image.redimensionnerImage(taille / 2, taille, Filtre::NearestNeighbour);
+            image.pivoterMatrice(Direction::Left);
+        };
+        // Le premier passage donne a chaque transformation son tampon
+        suite();
+        avant = nombreAllocations.load();
+        suite();
+        afficherAllocations("alloc. suite", taille, nombreAllocations.load() - avant);
+    }
+
+    /**
+     * @brief acceleration de chaque transformation avec 1, 2, 4 et 8 travailleurs
+     */
+    void mesurerAcceleration(size_t taille)
+    {
+        std::cout << "Acceleration multithread, matrice de pixels " << taille << " x " << taille
+                  << " (materiel : " << std::thread::hardware_concurrency() << " coeurs)"
+                  << std::endl;
+
+        const std::pair<std::string, std::function<void(Image<Matrice<Pixel>>&)>> operations[] = {
+            {"px droite", [](Image<Matrice<Pixel>>& image) { image.pivoterMatrice(Direction::Right); }},
+            {"px agrandir x2", [](Image<Matrice<Pixel>>& image) { image.redimensionnerImage(2u); }},
+            {"px /2 bilin.",
+             [](Image<Matrice<Pixel>>& image) { image.redimensionnerImage(0.5f, Filtre::Bilinear); }},
+            {"px rotation 3.5", [](Image<Matrice<Pixel>>& image) { image.pivoterAngle(3.5); }},
+        };
+
+        for (const auto& [nom, operation] : operations)
+        {
+            double reference = 0.0;
+            for (size_t travailleurs : {1, 2, 4, 8})
+            {
+                Image<Matrice<Pixel>> image(genererPixels(taille, taille),
+                                            PolitiqueExecution(travailleurs));
+                Horloge::time_point debut = Horloge::now();
+                operation(image);
+                double ms = millisecondesDepuis(debut);
+                if (travailleurs == 1)
+                    reference = ms;
+
+                std::cout << std::left << std::setw(16) << nom << std::right << std::setw(2)
+                          << travailleurs << " threads : " << std::fixed << std::setprecision(3)
+                          << std::setw(12) << ms << " ms  x" << std::setprecision(2)
+                          << reference / ms << std::endl;
+            }
+        }
+    }
+
+    struct Statistiques
+    {
+        double mediane;
+        double p99;
+        double minimum;
+    };
+
+    /**
+     * @brief appelle preparer() puis operation() echauffement + repetitions fois ; seuls
+     * les appels a operation() des repetitions sont chronometres
+     */
+    template<class Preparer, class Operation>
+    Statistiques repeter(size_t echauffement, size_t repetitions, Preparer preparer,
+                         Operation operation)
+    {
+        std::vector<double> durees;
+        for (size_t i = 0; i < echauffement + repetitions; i++)
+        {
+            preparer();
+            Horloge::time_point debut = Horloge::now();
+            operation();
+            if (i >= echauffement)
+                durees.push_back(millisecondesDepuis(debut));
+        }
+        std::sort(durees.begin(), durees.end());
+        size_t rang99 = std::min(durees.size() - 1, durees.size() * 99 / 100);
+        return {durees[durees.size() / 2], durees[rang99], durees.front()};
+    }
+
+    template<typename T>
+    T elementSynthetique(size_t posY, size_t posX);
+
+    template<>
+    int elementSynthetique<int>(size_t posY, size_t posX)
+    {
+        return int((posY * 31 + posX * 17) % 100);
+    }
+
+    template<>
+    Pixel elementSynthetique<Pixel>(size_t posY, size_t posX)
+    {
+        return Pixel(uint8_t(posY), uint8_t(posX), uint8_t(posX + posY));
+    }
+
+    template<>
+    Couleur elementSynthetique<Couleur>(size_t posY, size_t posX)
+    {
+        const char* noms[] = {"Rouge", "Vert", "Bleu", "Jaune", "Cyan", "Magenta"};
+        return Couleur(noms[(posY * 7 + posX * 5) % 6]);
+    }
+
+    /**
+     * @brief chargement texte, clone, pivotement, agrandissement x2, reduction de moitie
+     * et affichage d'une matrice d'elements T, une ligne CSV par operation : mediane, p99
+     * et minimum en ms, et debit en octets par seconde de la matrice source
+     */
+    template<typename T>
+    void mesurerCsv(const std::string& type, size_t taille, size_t echauffement,
+                    size_t repetitions)
+    {
+        Matrice<T> source(taille, taille);
+        for (size_t y = 0; y < taille; y++)
+            for (size_t x = 0; x < taille; x++)
+                source.ajouterElement(elementSynthetique<T>(y, x), y, x);
+        const std::string nomFichier = "bench_csv_" + type + ".txt";
+        source.sauvegarderFichierTexte(nomFichier);
+
+        auto ecrire = [&](const std::string& operation, const Statistiques& statistiques) {
+            double octets = double(taille * taille * sizeof(T));
+            std::cout << operation << ',' << type << ',' << taille << ',' << taille << ','
+                      << repetitions << ',' << std::fixed << std::setprecision(4)
+                      << statistiques.mediane << ',' << statistiques.p99 << ','
+                      << statistiques.minimum << ',' << std::setprecision(0)
+                      << octets / statistiques.mediane * 1000.0 << std::endl;
+        };
+        auto rien = []() {};
+
+        Matrice<T> chargee;
+        ecrire("chargement", repeter(echauffement, repetitions, rien, [&]() {
+                   chargee.chargerDepuisFichier(nomFichier);
+               }));
+        std::remove(nomFichier.c_str());
+
+        std::unique_ptr<Matrice<T>> copie;
+        ecrire("clone", repeter(echauffement, repetitions, [&]() { copie.reset(); },
+                                [&]() { copie = source.clone(); }));
+
+        // Chaque repetition part d'une image neuve, preparee hors chronometre
+        std::unique_ptr<Image<Matrice<T>>> image;
+        auto nouvelleImage = [&]() {
+            image = std::make_unique<Image<Matrice<T>>>(source.clone());
+        };
+        ecrire("pivotement", repeter(echauffement, repetitions, nouvelleImage, [&]() {
+                   image->pivoterMatrice(Direction::Right);
+               }));
+        ecrire("agrandir x2", repeter(echauffement, repetitions, nouvelleImage, [&]() {
+                   image->redimensionnerImage(2u);
+               }));
+        // Les couleurs n'ont pas de canaux : le filtre devient le plus proche voisin
+        ecrire("reduire /2", repeter(echauffement, repetitions, nouvelleImage, [&]() {
+                   image->redimensionnerImage(0.5f, Filtre::Bilinear);
+               }));
+
+        std::ostringstream flux;
+        nouvelleImage();
+        ecrire("affichage", repeter(echauffement, repetitions, [&]() { flux.str(""); },
+                                    [&]() { flux << image.get(); }));
+    }
+
+    /**
+     * @brief mode csv : entete, puis chaque operation en entiers, en pixels et en
+     * couleurs
+     */
+    void mesurerCsv(const std::vector<size_t>& tailles, size_t echauffement, size_t repetitions)
+    {
+        std::cout << "operation,type,height,width,repetitions,mediane_ms,p99_ms,minimum_ms,"
+                     "octets_par_s"
+                  << std::endl;
+        for (size_t taille : tailles)
+        {
+            mesurerCsv<int>("int", taille, echauffement, repetitions);
+            mesurerCsv<Pixel>("Pixel", taille, echauffement, repetitions);
+            mesurerCsv<Couleur>("Couleur", taille, echauffement, repetitions);
+        }
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "threads")
+    {
+        mesurerAcceleration(argc > 2 ? std::stoul(argv[2]) : 8192);
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "csv")
+    {
+        size_t repetitions = 10;
+        size_t echauffement = 2;
+        std::vector<size_t> tailles;
+        for (int i = 2; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            if ((argument == "-r" || argument == "-w") && i + 1 < argc)
+                (argument == "-r" ? repetitions : echauffement) = std::stoul(argv[++i]);
+            else
+                tailles.push_back(std::stoul(argument));
+        }
+        if (tailles.empty())
+            tailles = {256, 1024};
+        mesurerCsv(tailles, echauffement, std::max<size_t>(1, repetitions));
+        return 0;
+    }
+
+    std::vector<size_t> tailles;
+    for (int i = 1; i < argc; i++)
+        tailles.push_back(std::stoul(argv[i]));
+    if (tailles.empty())
+        tailles = {100, 1000};
+
+    for (size_t taille : tailles)
+    {
+        mesurerNombres(taille);
+        mesurerChargementPixels(taille);
+        mesurerPivotementsPixels(taille);
+        mesurerAgrandissementsPixels(taille);
+        mesurerPipelinePixels(taille);
+        mesurerPlanaire(taille);
+        mesurerCouleursPixels(taille);
+        mesurerEcritures(taille);
+        mesurerTuilee(taille);
+        mesurerFixes(taille);
+        mesurerAllocations(taille);
+        mesurerCouleurs(taille);
+        mesurerComparaisons(taille);
+        mesurerConvolutions(taille);
+        mesurerStatistiques(taille);
+        mesurerVues(taille);
+        mesurerTableSommes(taille);
+        mesurerPyramide(taille);
+        mesurerRotation(taille);
+    }
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Titre : AgrandirLigne.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef AGRANDIR_LIGNE_H
+#define AGRANDIR_LIGNE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "Pixel.h"
+
+/**
+ * @brief ecrit dans destination chaque element de source repete rapport fois
+ * @param source, les width elements d'une ligne
+ * @param destination, une ligne d'au moins width * rapport elements
+ *
+ * Les versions int, uint8_t (plans de MatricePlanaire) et Pixel sont
+ * vectorisees (SSE2, SSSE3 ou AVX2 selon les options de compilation, voir
+ * l'option native=1 du Makefile).
+ */
+template<typename T>
+void agrandirLigne(const T* source, size_t width, unsigned int rapport, T* destination)
+{
+    for (size_t x = 0; x < width; ++x)
+        destination = std::fill_n(destination, rapport, source[x]);
+}
+
+void agrandirLigne(const int* source, size_t width, unsigned int rapport, int* destination);
+void agrandirLigne(const uint8_t* source, size_t width, unsigned int rapport,
+                   uint8_t* destination);
+void agrandirLigne(const Pixel* source, size_t width, unsigned int rapport, Pixel* destination);
+
+#endif
@@ -7,6 +7,11 @@
 #ifndef AGRANDIR_MATRICE_H
 #define AGRANDIR_MATRICE_H
 
+#include <algorithm>
+#include <memory>
+#include "AgrandirLigne.h"
+#include "DoubleTampon.h"
+#include "PolitiqueExecution.h"
 #include "def.h"
 
 /**
@@ -17,14 +22,20 @@ class AgrandirMatrice
 {
 public:
     AgrandirMatrice();
-    AgrandirMatrice(M* matrice);
+    AgrandirMatrice(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
     ~AgrandirMatrice() = default;
     Coordonnees trouverLePlusProcheVoisin(const unsigned int& rapport, size_t posY,
                                           size_t posX) const;
     void redimensionnerImage(const unsigned int& rapport);
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+    void setDoubleTampon(const DoubleTampon<M>& tampon);
 
 private:
+    void agrandirParLignes(unsigned int rapport);
+    void agrandirElementParElement(unsigned int rapport);
     M* matrice_;
+    PolitiqueExecution politique_;
+    DoubleTampon<M> tampon_;
 };
 
 /**
@@ -32,6 +43,7 @@ private:
  */
 template<class M>
 AgrandirMatrice<M>::AgrandirMatrice()
+    : matrice_(nullptr)
 {
 }
 
@@ -39,11 +51,30 @@ AgrandirMatrice<M>::AgrandirMatrice()
  * @brief constructeur par paramètre de la classe
  */
 template<class M>
-AgrandirMatrice<M>::AgrandirMatrice(M* matrice)
+AgrandirMatrice<M>::AgrandirMatrice(M* matrice, PolitiqueExecution politique)
     : matrice_(matrice)
+    , politique_(std::move(politique))
 {
 }
 
+/**
+ * @brief change la facon dont l'agrandissement repartit son travail
+ */
+template<class M>
+void AgrandirMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief partage le tampon des operations avec d'autres transformations
+ */
+template<class M>
+void AgrandirMatrice<M>::setDoubleTampon(const DoubleTampon<M>& tampon)
+{
+    tampon_ = tampon;
+}
+
 /**
  * @brief trouver le point le plus proche du point (posX, posY) dans la matrice
  * originale
@@ -65,20 +96,70 @@ Coordonnees AgrandirMatrice<M>::trouverLePlusProcheVoisin(const unsigned int& ra
  */
 template<class M>
 void AgrandirMatrice<M>::redimensionnerImage(const unsigned int& rapport)
+{
+    static_assert(!estFixe<M>::value,
+                  "Une matrice de taille fixe ne change pas de dimensions : voir agrandie<R>()");
+    if (rapport == 1)
+        return;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            AgrandirMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .redimensionnerImage(rapport);
+    }
+    else if constexpr (estContigue<M>::value)
+        agrandirParLignes(rapport);
+    else
+        agrandirElementParElement(rapport);
+}
+
+/**
+ * @brief agrandissement d'une matrice contigue : chaque ligne source est
+ * agrandie une fois dans la premiere de ses lignes destination, qui est
+ * ensuite recopiee dans les rapport - 1 suivantes. La source est l'ancienne
+ * matrice, echangee dans le double tampon plutot que clonee.
+ */
+template<class M>
+void AgrandirMatrice<M>::agrandirParLignes(unsigned int rapport)
+{
+    const M& source = tampon_.prendreSource(*matrice_);
+    size_t width = source.getWidth();
+    size_t largeur = width * rapport;
+
+    matrice_->reinitialiser(source.getHeight() * rapport, largeur);
+
+    politique_.executerParBandes(source.getHeight(), [&](size_t debut, size_t fin) {
+        for (size_t y = debut; y < fin; ++y)
+        {
+            auto* premiereLigne = matrice_->getLigne(y * rapport);
+            agrandirLigne(source.getLigne(y), width, rapport, premiereLigne);
+            for (size_t copie = 1; copie < rapport; ++copie)
+                std::copy(premiereLigne, premiereLigne + largeur,
+                          matrice_->getLigne(y * rapport + copie));
+        }
+    });
+}
+
+/**
+ * @brief version pour les matrices sans acces contigu : chaque element est
+ * lu chez son plus proche voisin dans une copie de la matrice, dans l'ordre
+ * de parcourirPositions
+ */
+template<class M>
+void AgrandirMatrice<M>::agrandirElementParElement(unsigned int rapport)
 {
     std::unique_ptr<M> matriceCopie = matrice_->clone();
 
     matrice_->setHeight(matrice_->getHeight() * rapport);
     matrice_->setWidth(matrice_->getWidth() * rapport);
 
-    for (size_t y = 0; y < matrice_->getHeight(); ++y)
-    {
-        for (size_t x = 0; x < matrice_->getWidth(); ++x)
-        {
-            Coordonnees coord = trouverLePlusProcheVoisin(rapport, y, x);
-            matrice_->ajouterElement(matriceCopie->operator()(coord.x, coord.y), y, x);
-        }
-    }
+    parcourirPositions(*matrice_, matrice_->getHeight(), matrice_->getWidth(),
+                       [&](size_t y, size_t x) {
+                           Coordonnees coord = trouverLePlusProcheVoisin(rapport, y, x);
+                           matrice_->ajouterElement(
+                               matriceCopie->operator()(size_t(coord.y), size_t(coord.x)), y, x);
+                       });
 }
 
 #endif
@@ -0,0 +1,286 @@
+/*
+ * Titre : AjusterCouleurs.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef AJUSTER_COULEURS_H
+#define AJUSTER_COULEURS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "CanauxElement.h"
+#include "CouleurLigne.h"
+#include "PolitiqueExecution.h"
+#include "Pixel.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe AjusterCouleurs
+ *
+ * Operations de couleur appliquees a tous les pixels d'une matrice d'un coup,
+ * sans passer par les setters de Pixel : chaque ligne est traitee comme une
+ * suite d'octets par les noyaux vectorises de CouleurLigne.h. Les matrices
+ * acceptees sont les matrices contigues de Pixel (3 octets entrelaces par
+ * pixel) et les matrices planaires (un plan d'octets par canal). Le travail
+ * est reparti par bandes de lignes selon la politique d'execution.
+ */
+template<class M>
+class AjusterCouleurs
+{
+public:
+    AjusterCouleurs();
+    AjusterCouleurs(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~AjusterCouleurs() = default;
+    void ajusterLuminositeContraste(int luminosite, float contraste);
+    void appliquerGamma(float gamma);
+    void convertirEnGris();
+    void permuterCanaux(Canal rouge, Canal vert, Canal bleu);
+    bool additionner(const M& autre);
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    // Nombre de pixels separes a la fois dans les tampons de pile
+    static constexpr size_t TAILLE_BLOC = 256;
+    using Table = std::array<uint8_t, 256>;
+
+    template<class Operation>
+    void parcourirOctets(Operation operation);
+    template<class Operation>
+    void parcourirCanaux(Operation operation);
+    static const uint8_t* octetsLigne(const M& matrice, size_t plan, size_t posY);
+    void transformerOctets(const Table& table);
+    M* matrice_;
+    PolitiqueExecution politique_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline AjusterCouleurs<M>::AjusterCouleurs()
+    : matrice_(nullptr)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ */
+template<class M>
+inline AjusterCouleurs<M>::AjusterCouleurs(M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+{
+}
+
+/**
+ * @brief change la facon dont les operations repartissent leur travail
+ */
+template<class M>
+inline void AjusterCouleurs<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief appelle operation(octets, taille, plan, posY) sur chaque ligne
+ * d'octets de la matrice : les 3 * width octets d'une ligne de pixels, ou une
+ * ligne de chaque plan d'une matrice planaire
+ */
+template<class M>
+template<class Operation>
+void AjusterCouleurs<M>::parcourirOctets(Operation operation)
+{
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t plan = 0; plan < matrice_->getNombrePlans(); ++plan)
+        {
+            auto& matricePlan = matrice_->getPlan(plan);
+            politique_.executerParBandes(matricePlan.getHeight(), [&](size_t debut, size_t fin) {
+                for (size_t y = debut; y < fin; ++y)
+                    operation(matricePlan.getLigne(y), matricePlan.getWidth(), plan, y);
+            });
+        }
+    }
+    else
+    {
+        static_assert(estContigue<M>::value && std::is_same_v<ElementDe<M>, Pixel>,
+                      "Les operations de couleur demandent une matrice contigue de Pixel");
+        size_t taille = matrice_->getWidth() * sizeof(Pixel);
+        politique_.executerParBandes(matrice_->getHeight(), [&](size_t debut, size_t fin) {
+            for (size_t y = debut; y < fin; ++y)
+                operation(reinterpret_cast<uint8_t*>(matrice_->getLigne(y)), taille, size_t(0), y);
+        });
+    }
+}
+
+/**
+ * @brief appelle operation(canaux, nombre) sur des blocs d'au plus TAILLE_BLOC
+ * pixels, canaux donnant une ligne d'octets par canal (rouge, vert, bleu) que
+ * l'operation peut modifier ; les pixels entrelaces sont separes avant et
+ * reconstruits apres chaque bloc
+ */
+template<class M>
+template<class Operation>
+void AjusterCouleurs<M>::parcourirCanaux(Operation operation)
+{
+    size_t width = matrice_->getWidth();
+
+    politique_.executerParBandes(matrice_->getHeight(), [&](size_t debut, size_t fin) {
+        alignas(16) uint8_t tampons[3][TAILLE_BLOC];
+        for (size_t y = debut; y < fin; ++y)
+        {
+            for (size_t x = 0; x < width; x += TAILLE_BLOC)
+            {
+                size_t nombre = std::min(TAILLE_BLOC, width - x);
+                if constexpr (estPlanaire<M>::value)
+                {
+                    uint8_t* canaux[3] = {matrice_->getPlan(0).getLigne(y) + x,
+                                          matrice_->getPlan(1).getLigne(y) + x,
+                                          matrice_->getPlan(2).getLigne(y) + x};
+                    operation(canaux, nombre);
+                }
+                else
+                {
+                    static_assert(estContigue<M>::value && std::is_same_v<ElementDe<M>, Pixel>,
+                                  "Les operations de couleur demandent une matrice contigue de "
+                                  "Pixel");
+                    uint8_t* octets = reinterpret_cast<uint8_t*>(matrice_->getLigne(y) + x);
+                    uint8_t* canaux[3] = {tampons[0], tampons[1], tampons[2]};
+                    separerCanaux(octets, nombre, canaux);
+                    operation(canaux, nombre);
+                    entrelacerCanaux(canaux, nombre, octets);
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief debut d'une ligne d'octets de matrice, comme dans parcourirOctets
+ */
+template<class M>
+inline const uint8_t* AjusterCouleurs<M>::octetsLigne(const M& matrice, size_t plan, size_t posY)
+{
+    if constexpr (estPlanaire<M>::value)
+        return matrice.getPlan(plan).getLigne(posY);
+    else
+        return reinterpret_cast<const uint8_t*>(matrice.getLigne(posY));
+}
+
+/**
+ * @brief remplace chaque canal v par table[v]
+ */
+template<class M>
+void AjusterCouleurs<M>::transformerOctets(const Table& table)
+{
+    parcourirOctets([&](uint8_t* octets, size_t taille, size_t, size_t) {
+        appliquerTable(octets, taille, table.data());
+    });
+}
+
+/**
+ * @brief change la luminosite et le contraste de chaque canal :
+ * v' = (v - 128) * contraste + 128 + luminosite, sature entre 0 et 255
+ * @param luminosite, decalage ajoute a chaque canal
+ * @param contraste, 1 le laisse inchange ; la luminosite seule est une
+ * addition saturee vectorisee, sinon chaque valeur passe par une table
+ */
+template<class M>
+void AjusterCouleurs<M>::ajusterLuminositeContraste(int luminosite, float contraste)
+{
+    if (contraste == 1.0f)
+    {
+        if (luminosite != 0)
+            parcourirOctets([&](uint8_t* octets, size_t taille, size_t, size_t) {
+                decalerOctets(octets, taille, luminosite);
+            });
+        return;
+    }
+
+    Table table;
+    for (size_t v = 0; v < table.size(); ++v)
+    {
+        float valeur = (float(v) - 128.0f) * contraste + 128.0f + float(luminosite);
+        table[v] = CanauxElement<uint8_t>::ecrire(&valeur);
+    }
+    transformerOctets(table);
+}
+
+/**
+ * @brief correction gamma de chaque canal : v' = 255 * (v / 255) ^ gamma
+ * @param gamma, strictement positif ; moins de 1 eclaircit l'image
+ */
+template<class M>
+void AjusterCouleurs<M>::appliquerGamma(float gamma)
+{
+    Table table;
+    for (size_t v = 0; v < table.size(); ++v)
+    {
+        float valeur = 255.0f * std::pow(float(v) / 255.0f, gamma);
+        table[v] = CanauxElement<uint8_t>::ecrire(&valeur);
+    }
+    transformerOctets(table);
+}
+
+/**
+ * @brief remplace les trois canaux de chaque pixel par sa luminance
+ */
+template<class M>
+void AjusterCouleurs<M>::convertirEnGris()
+{
+    parcourirCanaux([](uint8_t* const* canaux, size_t nombre) {
+        calculerGris(canaux[0], canaux[1], canaux[2], nombre, canaux[0]);
+        std::copy(canaux[0], canaux[0] + nombre, canaux[1]);
+        std::copy(canaux[0], canaux[0] + nombre, canaux[2]);
+    });
+}
+
+/**
+ * @brief recompose chaque pixel a partir de ses canaux : le nouveau rouge est
+ * l'ancien canal rouge, etc. ; un canal peut etre repete
+ */
+template<class M>
+void AjusterCouleurs<M>::permuterCanaux(Canal rouge, Canal vert, Canal bleu)
+{
+    const size_t ordre[3] = {size_t(rouge), size_t(vert), size_t(bleu)};
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        parcourirCanaux([&](uint8_t* const* canaux, size_t nombre) {
+            uint8_t anciens[3][TAILLE_BLOC];
+            for (size_t canal = 0; canal < 3; ++canal)
+                std::copy(canaux[canal], canaux[canal] + nombre, anciens[canal]);
+            for (size_t canal = 0; canal < 3; ++canal)
+                std::copy(anciens[ordre[canal]], anciens[ordre[canal]] + nombre, canaux[canal]);
+        });
+    }
+    else
+    {
+        parcourirOctets([&](uint8_t* octets, size_t taille, size_t, size_t) {
+            ::permuterCanaux(octets, taille / sizeof(Pixel), ordre);
+        });
+    }
+}
+
+/**
+ * @brief additionne une autre matrice canal par canal, en saturant a 255
+ * @param autre, une matrice de memes dimensions
+ * @return false, sans rien modifier, si les dimensions different
+ */
+template<class M>
+bool AjusterCouleurs<M>::additionner(const M& autre)
+{
+    if (autre.getHeight() != matrice_->getHeight() || autre.getWidth() != matrice_->getWidth())
+        return false;
+
+    parcourirOctets([&](uint8_t* octets, size_t taille, size_t plan, size_t posY) {
+        additionnerOctets(octets, octetsLigne(autre, plan, posY), taille);
+    });
+    return true;
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Titre : CanauxElement.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef CANAUX_ELEMENT_H
+#define CANAUX_ELEMENT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief trait des elements qui se decomposent en canaux numeriques, ce qui
+ * permet de les filtrer (moyenne, interpolation, ...)
+ *
+ * Une specialisation fournit le nombre de canaux, lire() qui ecrit les canaux
+ * d'un element dans un tableau de float et ecrire() qui reconstruit un element
+ * en arrondissant et en saturant. Le trait n'est pas defini pour les autres
+ * types (Couleur, Entier, ...), qui ne peuvent qu'etre copies.
+ */
+template<typename T>
+struct CanauxElement;
+
+template<>
+struct CanauxElement<int>
+{
+    static constexpr size_t nombre = 1;
+
+    static void lire(const int& element, float* canaux) { canaux[0] = float(element); }
+
+    static int ecrire(const float* canaux) { return int(std::lround(canaux[0])); }
+};
+
+/**
+ * @brief un octet est un canal sature entre 0 et 255, par exemple un plan de
+ * MatricePlanaire
+ */
+template<>
+struct CanauxElement<uint8_t>
+{
+    static constexpr size_t nombre = 1;
+
+    static void lire(const uint8_t& element, float* canaux) { canaux[0] = element; }
+
+    static uint8_t ecrire(const float* canaux)
+    {
+        return canaux[0] <= 0.0f ? 0 : canaux[0] >= 255.0f ? 255 : uint8_t(canaux[0] + 0.5f);
+    }
+};
+
+/**
+ * @brief vrai si CanauxElement<T> est defini
+ */
+template<typename T, typename = void>
+struct aDesCanaux : std::false_type
+{
+};
+
+template<typename T>
+struct aDesCanaux<T, std::void_t<decltype(CanauxElement<T>::nombre)>> : std::true_type
+{
+};
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Titre : ComparerLigne.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef COMPARER_LIGNE_H
+#define COMPARER_LIGNE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Noyaux de comparaison de deux lignes d'octets, utilises par
+ * ComparerMatrices pour les elements qui se comparent octet par octet (int,
+ * Pixel, plans d'octets, ...). Ils comparent 64 octets a la fois avec SSE2
+ * et ont une version scalaire lorsque SSE2 n'est pas disponible.
+ */
+
+/**
+ * @brief position du premier octet different, ou taille si les deux lignes
+ * sont identiques ; la recherche s'arrete au premier bloc qui differe
+ */
+size_t trouverPremiereDifference(const uint8_t* premiere, const uint8_t* seconde, size_t taille);
+
+/**
+ * @brief position qui suit le dernier octet different, ou 0 si les deux
+ * lignes sont identiques ; la recherche part de la fin
+ */
+size_t trouverFinDifferences(const uint8_t* premiere, const uint8_t* seconde, size_t taille);
+
+/**
+ * @brief nombre d'elements differents entre deux lignes de nombre elements
+ * de tailleElement octets ; un element differe si l'un de ses octets differe
+ */
+size_t compterDifferences(const uint8_t* premiere, const uint8_t* seconde, size_t nombre,
+                          size_t tailleElement);
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * Titre : ComparerMatrices.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef COMPARER_MATRICES_H
+#define COMPARER_MATRICES_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+#include "ComparerLigne.h"
+#include "PolitiqueExecution.h"
+#include "def.h"
+
+/**
+ * @brief resultat de ComparerMatrices::comparer. Les matrices sont egales si
+ * nombre vaut 0 ; une cellule presente dans une seule des deux matrices
+ * (dimensions differentes) compte comme differente.
+ */
+struct Difference
+{
+    // Nombre de cellules differentes
+    size_t nombre;
+    // Boite englobante des cellules differentes, lignes [debutY, finY) et
+    // colonnes [debutX, finX) ; vide si nombre vaut 0
+    size_t debutY;
+    size_t debutX;
+    size_t finY;
+    size_t finX;
+};
+
+/**
+ * @brief definition de la classe ComparerMatrices
+ *
+ * Compare une matrice a une autre de meme type en bloc, plutot que cellule
+ * par cellule avec operator(). Les elements dont deux valeurs egales ont
+ * toujours les memes octets (int, Pixel, CouleurInternee, ...) sont compares
+ * ligne par ligne par les noyaux de ComparerLigne.h ; les autres (Couleur,
+ * ...) avec leur operateur ==. estEgale() s'arrete a la premiere difference ;
+ * comparer() parcourt tout et compte. Une matrice planaire est comparee plan
+ * par plan pour l'egalite, element par element pour comparer(). Le travail
+ * est reparti par bandes de lignes selon la politique d'execution.
+ */
+template<class M>
+class ComparerMatrices
+{
+public:
+    ComparerMatrices();
+    ComparerMatrices(const M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~ComparerMatrices() = default;
+    bool estEgale(const M& autre) const;
+    Difference comparer(const M& autre) const;
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    using Element = ElementDe<M>;
+    static constexpr bool parOctets =
+        estContigue<M>::value && std::has_unique_object_representations_v<Element>;
+
+    static bool sontEgaux(const Element& premier, const Element& second);
+    static void ajouterCellules(Difference& difference, size_t debutY, size_t debutX,
+                                size_t finY, size_t finX, size_t nombre);
+    static void ajouterHorsCommun(Difference& difference, const M& matrice, size_t height,
+                                  size_t width);
+    bool lignesEgales(const M& autre, size_t posY) const;
+    void comparerLigne(const M& autre, size_t posY, Difference& difference) const;
+    const M* matrice_;
+    PolitiqueExecution politique_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline ComparerMatrices<M>::ComparerMatrices()
+    : matrice_(nullptr)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ * @param matrice, la matrice de reference des comparaisons
+ */
+template<class M>
+inline ComparerMatrices<M>::ComparerMatrices(const M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+{
+}
+
+/**
+ * @brief change la facon dont les comparaisons repartissent leur travail
+ */
+template<class M>
+inline void ComparerMatrices<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief vrai si les deux elements sont egaux ; les operateurs == des classes
+ * de test (Couleur, Entier) ne sont pas const, d'ou la copie
+ */
+template<class M>
+bool ComparerMatrices<M>::sontEgaux(const Element& premier, const Element& second)
+{
+    if constexpr (std::has_unique_object_representations_v<Element>)
+        return std::memcmp(&premier, &second, sizeof(Element)) == 0;
+    else
+    {
+        Element copie = premier;
+        return copie == second;
+    }
+}
+
+/**
+ * @brief ajoute nombre cellules differentes, toutes dans le rectangle
+ * [debutY, finY) x [debutX, finX), a difference
+ */
+template<class M>
+void ComparerMatrices<M>::ajouterCellules(Difference& difference, size_t debutY, size_t debutX,
+                                          size_t finY, size_t finX, size_t nombre)
+{
+    if (nombre == 0)
+        return;
+
+    if (difference.nombre == 0)
+        difference = {0, debutY, debutX, finY, finX};
+    else
+    {
+        difference.debutY = std::min(difference.debutY, debutY);
+        difference.debutX = std::min(difference.debutX, debutX);
+        difference.finY = std::max(difference.finY, finY);
+        difference.finX = std::max(difference.finX, finX);
+    }
+    difference.nombre += nombre;
+}
+
+/**
+ * @brief ajoute les cellules de matrice hors de la zone commune height x width
+ */
+template<class M>
+void ComparerMatrices<M>::ajouterHorsCommun(Difference& difference, const M& matrice,
+                                            size_t height, size_t width)
+{
+    size_t hauteur = matrice.getHeight();
+    size_t largeur = matrice.getWidth();
+    ajouterCellules(difference, height, 0, hauteur, largeur, (hauteur - height) * largeur);
+    ajouterCellules(difference, 0, width, height, largeur, height * (largeur - width));
+}
+
+/**
+ * @brief vrai si la ligne posY est identique dans les deux matrices contigues
+ */
+template<class M>
+bool ComparerMatrices<M>::lignesEgales(const M& autre, size_t posY) const
+{
+    const Element* premiere = matrice_->getLigne(posY);
+    const Element* seconde = autre.getLigne(posY);
+    size_t width = matrice_->getWidth();
+
+    if constexpr (parOctets)
+    {
+        size_t taille = width * sizeof(Element);
+        return trouverPremiereDifference(reinterpret_cast<const uint8_t*>(premiere),
+                                         reinterpret_cast<const uint8_t*>(seconde),
+                                         taille) == taille;
+    }
+    else
+    {
+        for (size_t x = 0; x < width; ++x)
+            if (!sontEgaux(premiere[x], seconde[x]))
+                return false;
+        return true;
+    }
+}
+
+/**
+ * @brief ajoute a difference les cellules differentes de la ligne posY, dans
+ * la zone commune aux deux matrices contigues. Par octets, la ligne est
+ * bornee par sa premiere et sa derniere difference avant d'etre comptee.
+ */
+template<class M>
+void ComparerMatrices<M>::comparerLigne(const M& autre, size_t posY,
+                                        Difference& difference) const
+{
+    const Element* premiere = matrice_->getLigne(posY);
+    const Element* seconde = autre.getLigne(posY);
+    size_t width = std::min(matrice_->getWidth(), autre.getWidth());
+
+    if constexpr (parOctets)
+    {
+        const uint8_t* gauche = reinterpret_cast<const uint8_t*>(premiere);
+        const uint8_t* droite = reinterpret_cast<const uint8_t*>(seconde);
+        size_t taille = width * sizeof(Element);
+
+        size_t premier = trouverPremiereDifference(gauche, droite, taille);
+        if (premier == taille)
+            return;
+        size_t fin = premier + trouverFinDifferences(gauche + premier, droite + premier,
+                                                     taille - premier);
+
+        size_t debutX = premier / sizeof(Element);
+        size_t finX = (fin - 1) / sizeof(Element) + 1;
+        size_t nombre = compterDifferences(gauche + debutX * sizeof(Element),
+                                           droite + debutX * sizeof(Element), finX - debutX,
+                                           sizeof(Element));
+        ajouterCellules(difference, posY, debutX, posY + 1, finX, nombre);
+    }
+    else
+    {
+        for (size_t x = 0; x < width; ++x)
+            if (!sontEgaux(premiere[x], seconde[x]))
+                ajouterCellules(difference, posY, x, posY + 1, x + 1, 1);
+    }
+}
+
+/**
+ * @brief vrai si autre a les memes dimensions et les memes elements ; la
+ * comparaison s'arrete a la premiere ligne (ou au premier plan) qui differe
+ */
+template<class M>
+bool ComparerMatrices<M>::estEgale(const M& autre) const
+{
+    size_t height = matrice_->getHeight();
+    size_t width = matrice_->getWidth();
+    if (height != autre.getHeight() || width != autre.getWidth())
+        return false;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            if (!ComparerMatrices<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                     .estEgale(autre.getPlan(canal)))
+                return false;
+        return true;
+    }
+    else if constexpr (estContigue<M>::value)
+    {
+        // Chaque bande abandonne des qu'une bande voisine a trouve une difference
+        std::atomic<bool> difference(false);
+        politique_.executerParBandes(height, [&](size_t debut, size_t fin) {
+            for (size_t y = debut; y < fin && !difference.load(std::memory_order_relaxed); ++y)
+                if (!lignesEgales(autre, y))
+                    difference.store(true, std::memory_order_relaxed);
+        });
+        return !difference.load();
+    }
+    else
+    {
+        bool egales = true;
+        parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+            egales = egales && sontEgaux((*matrice_)(y, x), autre(y, x));
+        });
+        return egales;
+    }
+}
+
+/**
+ * @brief compte les cellules qui different entre la matrice et autre, et
+ * calcule leur boite englobante
+ */
+template<class M>
+Difference ComparerMatrices<M>::comparer(const M& autre) const
+{
+    Difference difference = {0, 0, 0, 0, 0};
+    size_t height = std::min(matrice_->getHeight(), autre.getHeight());
+    size_t width = std::min(matrice_->getWidth(), autre.getWidth());
+
+    if constexpr (estContigue<M>::value)
+    {
+        // Chaque bande compte de son cote, puis ajoute son resultat au total
+        std::mutex verrou;
+        politique_.executerParBandes(height, [&](size_t debut, size_t fin) {
+            Difference bande = {0, 0, 0, 0, 0};
+            for (size_t y = debut; y < fin; ++y)
+                comparerLigne(autre, y, bande);
+
+            std::lock_guard<std::mutex> garde(verrou);
+            ajouterCellules(difference, bande.debutY, bande.debutX, bande.finY, bande.finX,
+                            bande.nombre);
+        });
+    }
+    else
+        parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+            if (!sontEgaux((*matrice_)(y, x), autre(y, x)))
+                ajouterCellules(difference, y, x, y + 1, x + 1, 1);
+        });
+
+    ajouterHorsCommun(difference, *matrice_, height, width);
+    ajouterHorsCommun(difference, autre, height, width);
+    return difference;
+}
+
+#endif
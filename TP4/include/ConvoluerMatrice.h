@@ -0,0 +1,289 @@
+/*
+ * Titre : ConvoluerMatrice.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef CONVOLUER_MATRICE_H
+#define CONVOLUER_MATRICE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "CanauxElement.h"
+#include "ConvolutionLigne.h"
+#include "Noyau.h"
+#include "Pixel.h"
+#include "PolitiqueExecution.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe ConvoluerMatrice
+ *
+ * Applique un noyau de convolution (flou, gradient, accentuation, ... voir
+ * Noyau.h) a une matrice dont les elements ont des canaux (CanauxElement).
+ * Les lignes sont d'abord converties en canaux float, prolongees de part et
+ * d'autre selon le traitement des bords ; chaque ligne destination est
+ * ensuite une somme de lignes converties, decalees et ponderees
+ * (accumulerLigne, vectorise). Un noyau separable passe par une ligne
+ * intermediaire horizontale, puis verticale : height + width accumulations
+ * par ligne au lieu de height * width. Comme toutes les lignes sources sont
+ * converties avant la premiere ecriture, le resultat est ecrit directement
+ * dans la matrice. Chaque passe est repartie par bandes de lignes selon la
+ * politique d'execution ; les matrices non contigues (MatriceTuilee) sont
+ * parcourues par un seul thread. Les plans d'une matrice planaire sont
+ * convolues un a un.
+ */
+template<class M>
+class ConvoluerMatrice
+{
+public:
+    ConvoluerMatrice();
+    ConvoluerMatrice(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~ConvoluerMatrice() = default;
+    bool convoluer(const Noyau& noyau, Bord bord = Bord::Etendre);
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    using Element = ElementDe<M>;
+    // Lignes de pixels ou d'octets converties d'un bloc par ConvolutionLigne.h
+    static constexpr bool parOctets =
+        estContigue<M>::value &&
+        (std::is_same_v<Element, Pixel> || std::is_same_v<Element, uint8_t>);
+
+    template<class Tache>
+    void executer(size_t taille, const Tache& tache) const;
+    void lireLigne(size_t posY, size_t marge, Bord bord, float* ligne) const;
+    void ecrireLigne(size_t posY, const float* ligne);
+    void convoluerSeparable(const Noyau& noyau, Bord bord);
+    void convoluerPlein(const Noyau& noyau, Bord bord);
+    M* matrice_;
+    PolitiqueExecution politique_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline ConvoluerMatrice<M>::ConvoluerMatrice()
+    : matrice_(nullptr)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ */
+template<class M>
+inline ConvoluerMatrice<M>::ConvoluerMatrice(M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+{
+}
+
+/**
+ * @brief change la facon dont les passes repartissent leur travail
+ */
+template<class M>
+inline void ConvoluerMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief applique le noyau a toute la matrice
+ * @param noyau, de dimensions impaires
+ * @param bord, la facon de lire les elements hors de la matrice
+ * @return false, sans rien modifier, si le noyau n'est pas valide
+ */
+template<class M>
+bool ConvoluerMatrice<M>::convoluer(const Noyau& noyau, Bord bord)
+{
+    static_assert(aDesCanaux<Element>::value,
+                  "La convolution demande des elements a canaux (voir CanauxElement.h)");
+    if (!noyau.estValide())
+        return false;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            ConvoluerMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .convoluer(noyau, bord);
+        return true;
+    }
+
+    if (matrice_->getHeight() == 0 || matrice_->getWidth() == 0)
+        return true;
+
+    if (noyau.estSeparable())
+        convoluerSeparable(noyau, bord);
+    else
+        convoluerPlein(noyau, bord);
+    return true;
+}
+
+/**
+ * @brief appelle tache(debut, fin) par bandes de lignes dans [0, taille),
+ * en parallele seulement si les lignes sont independantes en memoire
+ */
+template<class M>
+template<class Tache>
+void ConvoluerMatrice<M>::executer(size_t taille, const Tache& tache) const
+{
+    if constexpr (estContigue<M>::value)
+        politique_.executerParBandes(taille, tache);
+    else
+        tache(size_t(0), taille);
+}
+
+/**
+ * @brief convertit la ligne posY en canaux float
+ * @param marge, nombre d'elements ajoutes de chaque cote selon bord
+ * @param ligne, recoit (width + 2 * marge) * nombre de canaux float
+ */
+template<class M>
+void ConvoluerMatrice<M>::lireLigne(size_t posY, size_t marge, Bord bord, float* ligne) const
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t width = matrice_->getWidth();
+    float* centre = ligne + marge * canaux;
+
+    if constexpr (parOctets)
+        octetsVersFloat(reinterpret_cast<const uint8_t*>(matrice_->getLigne(posY)),
+                        width * canaux, centre);
+    else
+        for (size_t x = 0; x < width; ++x)
+        {
+            if constexpr (estContigue<M>::value)
+                CanauxElement<Element>::lire(matrice_->getLigne(posY)[x], centre + x * canaux);
+            else
+                CanauxElement<Element>::lire((*matrice_)(posY, x), centre + x * canaux);
+        }
+
+    auto prolonger = [&](std::ptrdiff_t position, float* destination) {
+        size_t source = appliquerBord(position, width, bord);
+        if (source == width)
+            std::fill(destination, destination + canaux, 0.0f);
+        else
+            std::copy(centre + source * canaux, centre + (source + 1) * canaux, destination);
+    };
+    for (size_t i = 1; i <= marge; ++i)
+    {
+        prolonger(-std::ptrdiff_t(i), centre - i * canaux);
+        prolonger(std::ptrdiff_t(width - 1 + i), centre + (width - 1 + i) * canaux);
+    }
+}
+
+/**
+ * @brief reconvertit les canaux float de ligne en elements de la ligne posY
+ */
+template<class M>
+void ConvoluerMatrice<M>::ecrireLigne(size_t posY, const float* ligne)
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t width = matrice_->getWidth();
+
+    if constexpr (parOctets)
+        floatVersOctets(ligne, width * canaux,
+                        reinterpret_cast<uint8_t*>(matrice_->getLigne(posY)));
+    else
+        for (size_t x = 0; x < width; ++x)
+        {
+            if constexpr (estContigue<M>::value)
+                matrice_->getLigne(posY)[x] = CanauxElement<Element>::ecrire(ligne + x * canaux);
+            else
+                matrice_->ajouterElement(CanauxElement<Element>::ecrire(ligne + x * canaux), posY,
+                                         x);
+        }
+}
+
+/**
+ * @brief convolution en deux passes : chaque ligne est filtree
+ * horizontalement dans une matrice intermediaire de float, puis chaque ligne
+ * destination combine des lignes intermediaires entieres
+ */
+template<class M>
+void ConvoluerMatrice<M>::convoluerSeparable(const Noyau& noyau, Bord bord)
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t height = matrice_->getHeight();
+    size_t largeur = matrice_->getWidth() * canaux;
+    size_t rayonX = noyau.width / 2;
+    size_t rayonY = noyau.height / 2;
+
+    std::vector<float> intermediaire(height * largeur);
+    executer(height, [&](size_t debut, size_t fin) {
+        std::vector<float> ligne(largeur + 2 * rayonX * canaux);
+        for (size_t y = debut; y < fin; ++y)
+        {
+            lireLigne(y, rayonX, bord, ligne.data());
+            float* sortie = &intermediaire[y * largeur];
+            std::fill(sortie, sortie + largeur, 0.0f);
+            for (size_t kx = 0; kx < noyau.width; ++kx)
+                accumulerLigne(sortie, &ligne[kx * canaux], noyau.horizontal[kx], largeur);
+        }
+    });
+
+    executer(height, [&](size_t debut, size_t fin) {
+        std::vector<float> somme(largeur);
+        for (size_t y = debut; y < fin; ++y)
+        {
+            std::fill(somme.begin(), somme.end(), noyau.decalage);
+            for (size_t ky = 0; ky < noyau.height; ++ky)
+            {
+                size_t source = appliquerBord(std::ptrdiff_t(y + ky) - std::ptrdiff_t(rayonY),
+                                              height, bord);
+                if (source != height)
+                    accumulerLigne(somme.data(), &intermediaire[source * largeur],
+                                   noyau.vertical[ky], largeur);
+            }
+            ecrireLigne(y, somme.data());
+        }
+    });
+}
+
+/**
+ * @brief convolution directe : chaque ligne destination accumule, pour
+ * chaque coefficient non nul, la ligne source convertie qui lui correspond
+ */
+template<class M>
+void ConvoluerMatrice<M>::convoluerPlein(const Noyau& noyau, Bord bord)
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t height = matrice_->getHeight();
+    size_t largeur = matrice_->getWidth() * canaux;
+    size_t rayonX = noyau.width / 2;
+    size_t rayonY = noyau.height / 2;
+    size_t largeurProlongee = largeur + 2 * rayonX * canaux;
+
+    std::vector<float> lignes(height * largeurProlongee);
+    executer(height, [&](size_t debut, size_t fin) {
+        for (size_t y = debut; y < fin; ++y)
+            lireLigne(y, rayonX, bord, &lignes[y * largeurProlongee]);
+    });
+
+    executer(height, [&](size_t debut, size_t fin) {
+        std::vector<float> somme(largeur);
+        for (size_t y = debut; y < fin; ++y)
+        {
+            std::fill(somme.begin(), somme.end(), noyau.decalage);
+            for (size_t ky = 0; ky < noyau.height; ++ky)
+            {
+                size_t source = appliquerBord(std::ptrdiff_t(y + ky) - std::ptrdiff_t(rayonY),
+                                              height, bord);
+                if (source == height)
+                    continue;
+                const float* ligne = &lignes[source * largeurProlongee];
+                for (size_t kx = 0; kx < noyau.width; ++kx)
+                {
+                    float coefficient = noyau.coefficients[ky * noyau.width + kx];
+                    if (coefficient != 0.0f)
+                        accumulerLigne(somme.data(), ligne + kx * canaux, coefficient, largeur);
+                }
+            }
+            ecrireLigne(y, somme.data());
+        }
+    });
+}
+
+#endif
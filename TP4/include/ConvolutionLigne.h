@@ -0,0 +1,38 @@
+/*
+ * Titre : ConvolutionLigne.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef CONVOLUTION_LIGNE_H
+#define CONVOLUTION_LIGNE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Noyaux de ConvoluerMatrice, sur des lignes de canaux en float. Une
+ * convolution n'est qu'une suite d'accumulations de lignes decalees et
+ * ponderees ; les octets (pixels, plans de MatricePlanaire) sont convertis
+ * en float a la lecture et reconvertis, satures, a l'ecriture. Les noyaux
+ * sont vectorises avec SSE2 ou AVX2 selon les options de compilation (voir
+ * l'option native=1 du Makefile) et ont une version scalaire.
+ */
+
+/**
+ * @brief somme[i] += poids * entree[i] pour i dans [0, taille)
+ */
+void accumulerLigne(float* somme, const float* entree, float poids, size_t taille);
+
+/**
+ * @brief convertit taille octets en float
+ */
+void octetsVersFloat(const uint8_t* octets, size_t taille, float* valeurs);
+
+/**
+ * @brief arrondit taille valeurs en octets, saturees entre 0 et 255, comme
+ * CanauxElement<uint8_t>::ecrire
+ */
+void floatVersOctets(const float* valeurs, size_t taille, uint8_t* octets);
+
+#endif
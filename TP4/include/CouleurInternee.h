@@ -0,0 +1,97 @@
+/*
+ * Titre : CouleurInternee.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef COULEUR_INTERNEE_H
+#define COULEUR_INTERNEE_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "EcritureElement.h"
+#include "LectureElement.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe CouleurInternee
+ *
+ * Couleur representee par l'identifiant de son nom dans une table commune a
+ * tout le programme : chaque nom distinct n'est range qu'une fois, et une
+ * matrice de couleurs ne contient que des entiers de 32 bits. Le chargement
+ * interne chaque nom lu ; la copie, les transformations et la comparaison
+ * (operator==) ne manipulent que les identifiants. Le nom n'est retrouve qu'a
+ * l'affichage et a l'ecriture. L'identifiant 0 est "Noir", la couleur par
+ * defaut de Couleur.
+ *
+ * La table ne fait que grandir et est protegee par un verrou partage :
+ * plusieurs threads peuvent charger, interner et afficher des couleurs en
+ * meme temps, les recherches ne s'attendant pas entre elles.
+ */
+class CouleurInternee
+{
+public:
+    // Constructeurs
+    CouleurInternee();
+    explicit CouleurInternee(const std::string& nom);
+    explicit CouleurInternee(const Couleur& couleur);
+    // Conversion vers la classe Couleur
+    Couleur versCouleur() const;
+    // Operateurs
+    bool operator==(const CouleurInternee& couleur) const;
+    bool operator!=(const CouleurInternee& couleur) const;
+    // Getters
+    const std::string& getNom() const;
+    uint32_t getIdentifiant() const;
+    // Table des noms
+    static uint32_t interner(const char* debut, const char* fin);
+    static size_t getNombreNoms();
+
+private:
+    friend struct LectureElement<CouleurInternee>;
+    explicit CouleurInternee(uint32_t identifiant);
+
+    uint32_t identifiant_;
+};
+
+std::ostream& operator<<(std::ostream& os, CouleurInternee couleur);
+std::istream& operator>>(std::istream& is, CouleurInternee& couleur);
+
+inline uint32_t CouleurInternee::getIdentifiant() const
+{
+    return identifiant_;
+}
+
+inline bool CouleurInternee::operator==(const CouleurInternee& couleur) const
+{
+    return identifiant_ == couleur.identifiant_;
+}
+
+inline bool CouleurInternee::operator!=(const CouleurInternee& couleur) const
+{
+    return identifiant_ != couleur.identifiant_;
+}
+
+/**
+ * @brief lecture du premier mot de la ligne, comme pour Couleur, interne
+ * directement depuis le tampon du fichier
+ */
+template<>
+struct LectureElement<CouleurInternee>
+{
+    static void lire(const char* debut, const char* fin, CouleurInternee& couleur);
+};
+
+/**
+ * @brief ecriture du nom, aligne a droite sur 10 caracteres pour l'affichage
+ * comme Couleur, et seul sur sa ligne dans un fichier
+ */
+template<>
+struct EcritureElement<CouleurInternee>
+{
+    static void afficher(const CouleurInternee& couleur, std::string& tampon);
+    static void ecrire(const CouleurInternee& couleur, std::string& tampon);
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Titre : CouleurLigne.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef COULEUR_LIGNE_H
+#define COULEUR_LIGNE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Noyaux des operations de couleur, sur une ligne de pixels entrelaces
+ * (3 octets R, G, B par pixel) ou sur une ligne d'un plan de MatricePlanaire.
+ * Ils sont vectorises avec l'arithmetique saturee sur octets de SSE2 (ou
+ * pshufb de SSSE3 pour separer les canaux), et ont une version scalaire
+ * lorsque ces jeux d'instructions ne sont pas disponibles.
+ */
+
+/**
+ * @brief separe les canaux d'une ligne de pixels entrelaces
+ * @param source, les 3 * width octets de la ligne
+ * @param plans, une ligne de destination par canal (rouge, vert, bleu)
+ */
+void separerCanaux(const uint8_t* source, size_t width, uint8_t* const* plans);
+
+/**
+ * @brief reconstruit une ligne de pixels entrelaces a partir des plans
+ * @param plans, une ligne source par canal (rouge, vert, bleu)
+ * @param destination, les 3 * width octets de la ligne
+ */
+void entrelacerCanaux(const uint8_t* const* plans, size_t width, uint8_t* destination);
+
+/**
+ * @brief recompose chaque pixel d'une ligne entrelacee : son canal c devient
+ * son ancien canal ordre[c]
+ * @param ordre, trois indices de canal entre 0 et 2, eventuellement repetes
+ */
+void permuterCanaux(uint8_t* octets, size_t width, const size_t* ordre);
+
+/**
+ * @brief ajoute decalage a chaque octet, en saturant entre 0 et 255
+ */
+void decalerOctets(uint8_t* octets, size_t taille, int decalage);
+
+/**
+ * @brief additionne autres a octets, octet par octet, en saturant a 255
+ */
+void additionnerOctets(uint8_t* octets, const uint8_t* autres, size_t taille);
+
+/**
+ * @brief remplace chaque octet v par table[v]
+ * @param table, 256 octets
+ */
+void appliquerTable(uint8_t* octets, size_t taille, const uint8_t* table);
+
+/**
+ * @brief luminance de chaque pixel, (77 R + 150 G + 29 B + 128) / 256
+ * (poids de la recommandation BT.601 en virgule fixe)
+ */
+void calculerGris(const uint8_t* rouge, const uint8_t* vert, const uint8_t* bleu, size_t width,
+                  uint8_t* gris);
+
+#endif
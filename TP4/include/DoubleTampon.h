@@ -0,0 +1,64 @@
+/*
+ * Titre : DoubleTampon.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef DOUBLE_TAMPON_H
+#define DOUBLE_TAMPON_H
+
+#include <memory>
+
+/**
+ * @brief definition de la classe DoubleTampon
+ *
+ * Seconde matrice d'une transformation qui lit une matrice contigue et en
+ * ecrit une nouvelle. Plutot que de cloner la matrice a chaque operation,
+ * la transformation echange la matrice avec le tampon : le tampon devient la
+ * source, et la matrice recoit l'ancien tampon, que reinitialiser() remet aux
+ * nouvelles dimensions en reutilisant sa capacite. D'une operation a l'autre,
+ * les deux tampons alternent et aucun element n'est alloue ni copie en dehors
+ * de l'ecriture du resultat. En contrepartie, la transformation garde en vie
+ * la matrice d'avant sa derniere operation.
+ *
+ * Les copies d'un DoubleTampon partagent le meme tampon : Image en donne une
+ * a chacune de ses transformations, de sorte qu'un seul tampon circule entre
+ * la matrice et toutes les operations, quelle que soit leur suite. Apres sa
+ * premiere transformation, une Image occupe donc deux fois la memoire de sa
+ * matrice, et ce jusqu'a sa destruction : le tampon n'est jamais libere, et
+ * garde la capacite de la plus grande matrice qu'il a contenue.
+ */
+template<class M>
+class DoubleTampon
+{
+public:
+    DoubleTampon();
+    M& prendreSource(M& matrice);
+
+private:
+    std::shared_ptr<M> tampon_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe, le tampon est une matrice vide
+ */
+template<class M>
+DoubleTampon<M>::DoubleTampon()
+    : tampon_(std::make_shared<M>())
+{
+}
+
+/**
+ * @brief echange matrice avec le tampon
+ * @param matrice, la matrice a transformer ; elle recoit l'ancien tampon, dont
+ * le contenu est indefini jusqu'a son prochain reinitialiser()
+ * @return le tampon, qui contient desormais les elements de matrice
+ */
+template<class M>
+M& DoubleTampon<M>::prendreSource(M& matrice)
+{
+    matrice.echanger(*tampon_);
+    return *tampon_;
+}
+
+#endif
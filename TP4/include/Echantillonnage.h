@@ -0,0 +1,32 @@
+/*
+ * Titre : Echantillonnage.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef ECHANTILLONNAGE_H
+#define ECHANTILLONNAGE_H
+
+#include <cstddef>
+#include <vector>
+#include "def.h"
+
+/**
+ * @brief poids d'un redimensionnement le long d'un axe
+ *
+ * L'element destination i est la somme des nombre[i] elements sources a
+ * partir de premier[i], ponderes par poids[i * nombreMax + k]. Les poids
+ * d'un element destination sont normalises (leur somme vaut 1).
+ */
+struct Echantillonnage
+{
+    std::vector<size_t> premier;
+    std::vector<size_t> nombre;
+    std::vector<float> poids;
+    size_t nombreMax;
+};
+
+Echantillonnage calculerEchantillonnage(size_t tailleSource, size_t tailleDestination,
+                                        Filtre filtre);
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Titre : EcritureElement.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef ECRITURE_ELEMENT_H
+#define ECRITURE_ELEMENT_H
+
+#include <charconv>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief trait qui ajoute le texte d'un element de type T a un tampon
+ *
+ * afficher() produit le texte de l'operateur << du type, utilise par
+ * l'affichage des images ; ecrire() produit une ligne du format texte des
+ * matrices, que LectureElement<T> relit. La version generique passe par
+ * l'operateur << du type, avec un flux reutilise. Les types frequents (int,
+ * Pixel, Couleur) sont specialises pour convertir sans flux ; leur texte ne
+ * depend pas de l'etat (std::hex, largeur, ...) du flux de destination.
+ */
+template<typename T>
+struct EcritureElement
+{
+    static void afficher(const T& element, std::string& tampon)
+    {
+        // Un flux reutilise par type et par thread, plutot qu'un par element
+        thread_local std::ostringstream flux;
+        flux.str(std::string());
+        flux << element;
+        tampon += flux.str();
+    }
+
+    static void ecrire(const T& element, std::string& tampon) { afficher(element, tampon); }
+};
+
+namespace ecriture
+{
+    // Taille a partir de laquelle un tampon est ecrit dans son flux
+    static constexpr size_t TAILLE_BLOC = 1 << 16;
+
+    /**
+     * @brief ajoute l'ecriture decimale de valeur au tampon
+     */
+    inline void ecrireEntier(int valeur, std::string& tampon)
+    {
+        char chiffres[16];
+        std::to_chars_result resultat =
+            std::to_chars(chiffres, chiffres + sizeof(chiffres), valeur);
+        tampon.append(chiffres, resultat.ptr);
+    }
+
+    /**
+     * @brief vrai si LectureElement relit ce texte d'element a sa place : une
+     * ligne vide ou faite d'espaces serait sautee, "L" commencerait une ligne
+     * de matrice et une fin de ligne couperait l'element en deux
+     */
+    inline bool estRelisible(const char* debut, const char* fin)
+    {
+        bool blanc = true;
+        for (const char* caractere = debut; caractere != fin; ++caractere)
+        {
+            if (*caractere == '\n' || *caractere == '\r')
+                return false;
+            blanc &= *caractere == ' ' || *caractere == '\t';
+        }
+        return !blanc && !(fin - debut == 1 && *debut == 'L');
+    }
+
+    /**
+     * @brief ajoute au tampon le texte de l'element et sa fin de ligne
+     * @return false, sans rien ajouter, si ce texte ne se relirait pas
+     */
+    template<typename T>
+    bool ecrireLigne(const T& element, std::string& tampon)
+    {
+        size_t debut = tampon.size();
+        EcritureElement<T>::ecrire(element, tampon);
+        if (!estRelisible(tampon.data() + debut, tampon.data() + tampon.size()))
+        {
+            tampon.resize(debut);
+            return false;
+        }
+        tampon += '\n';
+        return true;
+    }
+
+    /**
+     * @brief ecrit le tampon dans le flux et le vide, s'il depasse TAILLE_BLOC
+     * ou si tout est vrai
+     */
+    inline void vider(std::string& tampon, std::ostream& os, bool tout = false)
+    {
+        if (tout || tampon.size() >= TAILLE_BLOC)
+        {
+            os.write(tampon.data(), static_cast<std::streamsize>(tampon.size()));
+            tampon.clear();
+        }
+    }
+} // namespace ecriture
+
+/**
+ * @brief specialisation pour les entiers, en decimal
+ */
+template<>
+struct EcritureElement<int>
+{
+    static void afficher(const int& element, std::string& tampon)
+    {
+        ecriture::ecrireEntier(element, tampon);
+    }
+
+    static void ecrire(const int& element, std::string& tampon)
+    {
+        ecriture::ecrireEntier(element, tampon);
+    }
+};
+
+#endif
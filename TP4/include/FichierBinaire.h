@@ -0,0 +1,91 @@
+/*
+ * Titre : FichierBinaire.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef FICHIER_BINAIRE_H
+#define FICHIER_BINAIRE_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+/**
+ * @brief entete des fichiers binaires de matrice
+ *
+ * L'entete de 32 octets est suivi des height x width elements, ligne par
+ * ligne, sans espacement, dans l'ordre des octets de la machine. Sa taille
+ * garde les elements alignes lorsque le fichier est projete en memoire.
+ */
+struct EnteteFichierBinaire
+{
+    char signature[4];
+    uint32_t version;
+    uint32_t typeElement;
+    uint32_t tailleElement;
+    uint64_t height;
+    uint64_t width;
+};
+
+static_assert(sizeof(EnteteFichierBinaire) == 32, "L'entete binaire doit faire 32 octets");
+
+namespace binaire
+{
+    static constexpr char SIGNATURE[4] = {'T', 'P', '4', 'M'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t TYPE_PIXEL = 1;
+    static constexpr uint32_t TYPE_ENTIER = 2;
+} // namespace binaire
+
+/**
+ * @brief comportement commun des formats binaires : T est copie octet par
+ * octet et identifie dans l'entete par code
+ */
+template<typename T, uint32_t code>
+struct FormatBinaireBase
+{
+    static EnteteFichierBinaire creerEntete(size_t height, size_t width)
+    {
+        EnteteFichierBinaire entete;
+        std::memcpy(entete.signature, binaire::SIGNATURE, sizeof(entete.signature));
+        entete.version = binaire::VERSION;
+        entete.typeElement = code;
+        entete.tailleElement = sizeof(T);
+        entete.height = height;
+        entete.width = width;
+        return entete;
+    }
+
+    static bool accepte(const EnteteFichierBinaire& entete)
+    {
+        return std::memcmp(entete.signature, binaire::SIGNATURE, sizeof(entete.signature)) == 0 &&
+               entete.version == binaire::VERSION && entete.typeElement == code &&
+               entete.tailleElement == sizeof(T);
+    }
+};
+
+/**
+ * @brief trait des types qui ont un format binaire ; il n'est pas defini pour
+ * les autres types (Couleur, Entier, ...)
+ */
+template<typename T>
+struct FormatBinaire;
+
+template<>
+struct FormatBinaire<int> : FormatBinaireBase<int, binaire::TYPE_ENTIER>
+{
+};
+
+/**
+ * @brief projette un fichier complet en memoire, en copie privee : les
+ * ecritures ne modifient pas le fichier
+ * @param nomFichier, le chemin du fichier
+ * @param taille, recoit la taille du fichier en octets
+ * @return le debut de la projection, nul en cas d'echec ; la projection est
+ * liberee avec le dernier shared_ptr
+ */
+std::shared_ptr<void> projeterFichier(const std::string& nomFichier, size_t& taille);
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Titre : FichierPPM.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef FICHIER_PPM_H
+#define FICHIER_PPM_H
+
+#include <iostream>
+#include <string>
+#include "Matrice.h"
+#include "Pixel.h"
+
+/**
+ * @brief les deux variantes du format PPM de netpbm : P3, les composantes en
+ * decimal, et P6, les composantes en octets
+ */
+enum class FormatPPM
+{
+    Texte,
+    Binaire
+};
+
+/**
+ * @brief lit une image PPM (P3 ou P6) a la position courante du flux
+ *
+ * L'entete (signature, largeur, hauteur, valeur maximale) peut contenir des
+ * commentaires "#". Les composantes d'une image dont la valeur maximale n'est
+ * pas 255 (jusqu'a 65535, sur deux octets en P6) sont ramenees entre 0 et 255.
+ * Les octets d'une image P6 sont lus par grands blocs directement dans le
+ * tampon de la matrice, qui n'est pas initialise au prealable. Le flux est
+ * laisse juste apres l'image, au debut de la suivante s'il y en a une.
+ * @param is, le flux, ouvert en binaire pour une image P6
+ * @param matrice, remplacee par l'image ; inchangee en cas d'echec
+ * @return false si l'entete est invalide, si une composante depasse la valeur
+ * maximale ou si le flux se termine avant la fin de l'image
+ */
+bool lirePPM(std::istream& is, Matrice<Pixel>& matrice);
+
+/**
+ * @brief ecrit la matrice en PPM, avec 255 comme valeur maximale ; les lignes
+ * d'une image P3 ne depassent pas 70 caracteres
+ * @return false si l'ecriture a echoue
+ */
+bool ecrirePPM(std::ostream& os, const Matrice<Pixel>& matrice,
+               FormatPPM format = FormatPPM::Binaire);
+
+/**
+ * @brief remplace la matrice par l'image PPM d'un fichier (voir lirePPM)
+ */
+bool chargerFichierPPM(Matrice<Pixel>& matrice, const std::string& nomFichier);
+
+/**
+ * @brief ecrit la matrice dans un fichier PPM (voir ecrirePPM)
+ */
+bool sauvegarderFichierPPM(const Matrice<Pixel>& matrice, const std::string& nomFichier,
+                           FormatPPM format = FormatPPM::Binaire);
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Titre : FichierTuiles.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef FICHIER_TUILES_H
+#define FICHIER_TUILES_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief definition de la classe FichierTuiles
+ *
+ * Fichier temporaire decoupe en emplacements de taille fixe, ou une matrice
+ * rangee par tuiles (voir MatriceTuilee.h) depose les tuiles qui ne tiennent
+ * plus dans son cache. Le fichier est cree dans le dossier de TMPDIR (ou
+ * /tmp) et disparait avec l'objet ; un emplacement libere est reutilise par
+ * la prochaine allocation. Les lectures et ecritures retournent false en cas
+ * d'erreur d'entree-sortie.
+ */
+class FichierTuiles
+{
+public:
+    explicit FichierTuiles(size_t tailleTuile);
+    FichierTuiles(const FichierTuiles&) = delete;
+    FichierTuiles& operator=(const FichierTuiles&) = delete;
+    ~FichierTuiles();
+    bool estOuvert() const;
+    // Gestion des emplacements
+    size_t allouer();
+    void liberer(size_t emplacement);
+    // Entrees-sorties d'une tuile complete
+    bool lire(size_t emplacement, void* tuile) const;
+    bool ecrire(size_t emplacement, const void* tuile);
+    bool copier(const FichierTuiles& source);
+    // Getters
+    size_t getTailleTuile() const;
+    size_t getNombreEmplacements() const;
+
+private:
+    bool lireOctets(size_t position, void* octets, size_t taille) const;
+    bool ecrireOctets(size_t position, const void* octets, size_t taille);
+
+    size_t tailleTuile_;
+    size_t nombreEmplacements_;
+    std::vector<size_t> libres_;
+#ifdef _WIN32
+    std::FILE* fichier_;
+#else
+    int descripteur_;
+#endif
+};
+
+inline size_t FichierTuiles::getTailleTuile() const
+{
+    return tailleTuile_;
+}
+
+inline size_t FichierTuiles::getNombreEmplacements() const
+{
+    return nombreEmplacements_;
+}
+
+#endif
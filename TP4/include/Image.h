@@ -7,43 +7,146 @@
 #ifndef IMAGE_H
 #define IMAGE_H
 
+#include <cmath>
 #include <iostream>
 #include "AgrandirMatrice.h"
+#include "AjusterCouleurs.h"
+#include "ComparerMatrices.h"
+#include "ConvoluerMatrice.h"
+#include "PipelineTransformations.h"
 #include "PivoterMatrice.h"
+#include "PyramideMatrice.h"
+#include "RedimensionnerMatrice.h"
+#include "StatistiquesMatrice.h"
 
 template<typename M>
 class Image
 {
 public:
-    Image(std::unique_ptr<M> matrice);
+    Image(std::unique_ptr<M> matrice, PolitiqueExecution politique = PolitiqueExecution());
     M* getMatrice();
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
     void redimensionnerImage(const unsigned int& rapport);
-    void pivoterMatrice(Direction direction);
+    void redimensionnerImage(size_t height, size_t width, Filtre filtre = Filtre::Bilinear);
+    void redimensionnerImage(float facteur, Filtre filtre);
+    bool pivoterMatrice(Direction direction);
+    bool pivoterAngle(double degres, Filtre filtre = Filtre::Bilinear,
+                      Cadre cadre = Cadre::Englober, ElementDe<M> fond = ElementDe<M>());
+    // Mode differe : pivotements et agrandissements entiers appliques en une passe
+    void setModeDiffere(bool differe);
+    void materialiser();
+    // Operations de couleur, pour les matrices de Pixel (voir AjusterCouleurs.h)
+    void ajusterLuminositeContraste(int luminosite, float contraste = 1.0f);
+    void appliquerGamma(float gamma);
+    void convertirEnGris();
+    void permuterCanaux(Canal rouge, Canal vert, Canal bleu);
+    bool additionner(Image<M>& autre);
+    // Comparaison avec une autre image (voir ComparerMatrices.h)
+    bool estEgale(Image<M>& autre);
+    Difference comparer(Image<M>& autre);
+    // Filtres de convolution (voir ConvoluerMatrice.h et Noyau.h)
+    bool convoluer(const Noyau& noyau, Bord bord = Bord::Etendre);
+    // Histogrammes et statistiques par canal (voir StatistiquesMatrice.h)
+    StatistiquesImage calculerStatistiques();
+    // Copies reduites servies par une pyramide de niveaux (voir PyramideMatrice.h)
+    void setPyramide(bool active);
+    std::unique_ptr<M> copieRedimensionnee(size_t height, size_t width,
+                                           Filtre filtre = Filtre::Box);
+    void invaliderPyramide();
 
 private:
     AgrandirMatrice<M> agrandissement_;
+    AjusterCouleurs<M> couleurs_;
+    ComparerMatrices<M> comparaison_;
+    ConvoluerMatrice<M> convolution_;
     PivoterMatrice<M> pivotement_;
+    RedimensionnerMatrice<M> redimensionnement_;
+    PipelineTransformations<M> pipeline_;
+    PyramideMatrice<M> pyramide_;
+    StatistiquesMatrice<M> statistiques_;
+    bool differe_;
     std::unique_ptr<M> matrice_;
 };
 
 /**
  * @brief constructeur par paramètres de la classe
+ * @param matrice, la matrice dont l'image devient proprietaire
+ * @param politique, sequentielle par defaut, ou un pool de travailleurs qui
+ * se partagent les lignes de chaque transformation
  */
 template<typename M>
-Image<M>::Image(std::unique_ptr<M> matrice)
-    : agrandissement_(matrice.get())
-    , pivotement_(matrice.get())
+Image<M>::Image(std::unique_ptr<M> matrice, PolitiqueExecution politique)
+    : agrandissement_(matrice.get(), politique)
+    , couleurs_(matrice.get(), politique)
+    , comparaison_(matrice.get(), politique)
+    , convolution_(matrice.get(), politique)
+    , pivotement_(matrice.get(), politique)
+    , redimensionnement_(matrice.get(), politique)
+    , pipeline_(matrice.get(), politique)
+    , pyramide_(matrice.get(), politique)
+    , statistiques_(matrice.get(), politique)
+    , differe_(false)
     , matrice_(std::move(matrice))
 {
+    // Un seul tampon alterne avec la matrice, quelle que soit l'operation ; il
+    // reste alloue, a la taille d'une matrice entiere, tant que l'image existe
+    DoubleTampon<M> tampon;
+    agrandissement_.setDoubleTampon(tampon);
+    pivotement_.setDoubleTampon(tampon);
+    redimensionnement_.setDoubleTampon(tampon);
+    pipeline_.setDoubleTampon(tampon);
+    pyramide_.setActive(false);
 }
 
 /**
- * @brief retourne la matrice de l'image
+ * @brief change la politique d'execution de toutes les transformations de l'image
+ */
+template<typename M>
+void Image<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    agrandissement_.setPolitiqueExecution(politique);
+    couleurs_.setPolitiqueExecution(politique);
+    comparaison_.setPolitiqueExecution(politique);
+    convolution_.setPolitiqueExecution(politique);
+    pivotement_.setPolitiqueExecution(politique);
+    redimensionnement_.setPolitiqueExecution(politique);
+    pipeline_.setPolitiqueExecution(politique);
+    pyramide_.setPolitiqueExecution(politique);
+    statistiques_.setPolitiqueExecution(politique);
+}
+
+/**
+ * @brief active ou desactive le mode differe. En mode differe, pivoterMatrice
+ * et redimensionnerImage(rapport) ne font que s'accumuler ; elles sont
+ * appliquees ensemble, en une seule passe, au prochain acces a la matrice
+ * (getMatrice, affichage) ou au prochain redimensionnement filtre.
+ * @param differe, false applique d'abord les transformations en attente
+ */
+template<typename M>
+void Image<M>::setModeDiffere(bool differe)
+{
+    if (!differe)
+        materialiser();
+    differe_ = differe;
+}
+
+/**
+ * @brief applique les transformations en attente du mode differe
+ */
+template<typename M>
+void Image<M>::materialiser()
+{
+    pipeline_.materialiser();
+}
+
+/**
+ * @brief retourne la matrice de l'image, apres les transformations en attente
  * @return pointeur de type shared_ptr qui pointe vers un element de type M
  */
 template<typename M>
 M* Image<M>::getMatrice()
 {
+    materialiser();
     return matrice_.get();
 }
 /**
@@ -53,34 +156,244 @@ M* Image<M>::getMatrice()
 template<typename M>
 void Image<M>::redimensionnerImage(const unsigned int& rapport)
 {
-    agrandissement_.redimensionnerImage(rapport);
+    pyramide_.invalider();
+    if (differe_)
+        pipeline_.ajouterAgrandissement(rapport);
+    else
+        agrandissement_.redimensionnerImage(rapport);
+}
+/**
+ * @brief redimensionne l'image a des dimensions quelconques
+ * @param height, le nouveau nombre de lignes
+ * @param width, le nouveau nombre de colonnes
+ * @param filtre, NearestNeighbour, Box ou Bilinear
+ */
+template<typename M>
+void Image<M>::redimensionnerImage(size_t height, size_t width, Filtre filtre)
+{
+    pyramide_.invalider();
+    materialiser();
+    redimensionnement_.redimensionner(height, width, filtre);
+}
+/**
+ * @brief redimensionne l'image d'un facteur quelconque (0.25 divise chaque
+ * dimension par 4), chaque dimension gardant au moins un element
+ * @param facteur, le facteur de redimensionnement, strictement positif et
+ * fini ; l'image est laissee intacte sinon
+ * @param filtre, NearestNeighbour, Box ou Bilinear
+ */
+template<typename M>
+void Image<M>::redimensionnerImage(float facteur, Filtre filtre)
+{
+    // Un facteur negatif, nul, infini ou NaN donnerait une taille absurde
+    if (!(facteur > 0.0f) || std::isinf(facteur))
+        return;
+    pyramide_.invalider();
+    auto appliquer = [facteur](size_t taille) {
+        return std::max<size_t>(1, size_t(std::lround(double(taille) * facteur)));
+    };
+    materialiser();
+    redimensionnement_.redimensionner(appliquer(matrice_->getHeight()),
+                                      appliquer(matrice_->getWidth()), filtre);
 }
 /**
  * @brief pivote l'image dans une direction passé en params
  * @param direction, de type Direction
+ * @return false si la matrice ne peut pas prendre les dimensions pivotees
+ * (quart de tour d'une matrice de taille fixe rectangulaire) ; une matrice de
+ * taille fixe est toujours pivotee sans attendre, meme en mode differe
+ */
+template<typename M>
+inline bool Image<M>::pivoterMatrice(Direction direction)
+{
+    pyramide_.invalider();
+    if (differe_ && !estFixe<M>::value)
+    {
+        pipeline_.ajouterPivotement(direction);
+        return true;
+    }
+    return pivotement_.pivoterMatrice(direction);
+}
+
+/**
+ * @brief tourne l'image d'un angle quelconque, dans le sens horaire pour un
+ * angle positif (voir PivoterMatrice::pivoterAngle) ; les transformations en
+ * attente du mode differe sont d'abord appliquees
+ */
+template<typename M>
+bool Image<M>::pivoterAngle(double degres, Filtre filtre, Cadre cadre, ElementDe<M> fond)
+{
+    pyramide_.invalider();
+    materialiser();
+    return pivotement_.pivoterAngle(degres, filtre, cadre, fond);
+}
+/**
+ * @brief change la luminosite et le contraste de chaque canal. Comme les
+ * autres operations de couleur, elle traite chaque pixel independamment et
+ * commute avec les pivotements et agrandissements du mode differe : elle
+ * s'applique sans attendre, sur la matrice avant leur application.
+ * @param luminosite, decalage ajoute a chaque canal
+ * @param contraste, facteur applique a l'ecart de chaque canal a 128
+ */
+template<typename M>
+void Image<M>::ajusterLuminositeContraste(int luminosite, float contraste)
+{
+    pyramide_.invalider();
+    couleurs_.ajusterLuminositeContraste(luminosite, contraste);
+}
+/**
+ * @brief correction gamma de chaque canal, v' = 255 * (v / 255) ^ gamma
+ */
+template<typename M>
+void Image<M>::appliquerGamma(float gamma)
+{
+    pyramide_.invalider();
+    couleurs_.appliquerGamma(gamma);
+}
+/**
+ * @brief remplace chaque pixel par sa luminance
+ */
+template<typename M>
+void Image<M>::convertirEnGris()
+{
+    pyramide_.invalider();
+    couleurs_.convertirEnGris();
+}
+/**
+ * @brief recompose chaque pixel a partir de ses canaux, par exemple
+ * (Bleu, Vert, Rouge) pour passer de RGB a BGR
+ */
+template<typename M>
+void Image<M>::permuterCanaux(Canal rouge, Canal vert, Canal bleu)
+{
+    pyramide_.invalider();
+    couleurs_.permuterCanaux(rouge, vert, bleu);
+}
+/**
+ * @brief additionne une autre image de memes dimensions, canal par canal,
+ * en saturant a 255 ; les transformations en attente des deux images sont
+ * d'abord appliquees
+ * @return false si les dimensions different
+ */
+template<typename M>
+bool Image<M>::additionner(Image<M>& autre)
+{
+    pyramide_.invalider();
+    materialiser();
+    return couleurs_.additionner(*autre.getMatrice());
+}
+
+/**
+ * @brief vrai si les deux images ont les memes dimensions et les memes
+ * elements, apres leurs transformations en attente ; s'arrete a la premiere
+ * difference
+ */
+template<typename M>
+bool Image<M>::estEgale(Image<M>& autre)
+{
+    materialiser();
+    return comparaison_.estEgale(*autre.getMatrice());
+}
+
+/**
+ * @brief compte les elements qui different entre les deux images et retourne
+ * leur boite englobante
+ */
+template<typename M>
+Difference Image<M>::comparer(Image<M>& autre)
+{
+    materialiser();
+    return comparaison_.comparer(*autre.getMatrice());
+}
+
+/**
+ * @brief applique un noyau de convolution (noyauGaussien, noyauSobelX, ...)
+ * a l'image, apres ses transformations en attente
+ * @param bord, la facon de lire les elements hors de l'image
+ * @return false si le noyau n'a pas des dimensions impaires
+ */
+template<typename M>
+bool Image<M>::convoluer(const Noyau& noyau, Bord bord)
+{
+    pyramide_.invalider();
+    materialiser();
+    return convolution_.convoluer(noyau, bord);
+}
+
+/**
+ * @brief minimum, maximum, moyenne, ecart type et, pour les pixels,
+ * histogramme de chaque canal de l'image, apres ses transformations en attente
+ */
+template<typename M>
+StatistiquesImage Image<M>::calculerStatistiques()
+{
+    materialiser();
+    return statistiques_.calculer();
+}
+/**
+ * @brief active ou desactive la pyramide de l'image (inactive par defaut) :
+ * active, copieRedimensionnee garde les niveaux qu'elle calcule, environ un
+ * tiers de la taille de la matrice (voir PyramideMatrice), jusqu'a la
+ * prochaine transformation
+ */
+template<typename M>
+void Image<M>::setPyramide(bool active)
+{
+    pyramide_.setActive(active);
+}
+
+/**
+ * @brief copie de l'image aux dimensions height x width, apres ses
+ * transformations en attente ; l'image ne change pas. Avec la pyramide,
+ * une reduction part du plus petit niveau qui couvre ces dimensions.
+ * @param filtre, NearestNeighbour, Box ou Bilinear
  */
 template<typename M>
-inline void Image<M>::pivoterMatrice(Direction direction)
+std::unique_ptr<M> Image<M>::copieRedimensionnee(size_t height, size_t width, Filtre filtre)
 {
-    pivotement_.pivoterMatrice(direction);
+    materialiser();
+    return pyramide_.copieRedimensionnee(height, width, filtre);
 }
+
 /**
- * @brief operateur << pour afficher une image
+ * @brief oublie les niveaux de la pyramide ; les transformations de l'image
+ * le font d'elles-memes, pas les ecritures faites dans getMatrice()
+ */
+template<typename M>
+void Image<M>::invaliderPyramide()
+{
+    pyramide_.invalider();
+}
+
+/**
+ * @brief operateur << pour afficher une image : chaque element suivi de " | "
+ * (" |" en fin de ligne). Les lignes sont converties dans un tampon
+ * (EcritureElement) et ecrites dans os par blocs, sans vider os a chaque ligne.
  * @param os, de type ostream
  * @param image, un pointeur vers l'image à afficher
  */
 template<typename M>
 std::ostream& operator<<(std::ostream& os, Image<M>* image)
 {
-    for (unsigned int i = 0; i < image->getMatrice()->getHeight(); i++)
+    using Element = ElementDe<M>;
+    const M& matrice = *image->getMatrice();
+    std::string tampon;
+    tampon.reserve(ecriture::TAILLE_BLOC);
+
+    for (size_t i = 0; i < matrice.getHeight(); i++)
     {
-        for (unsigned int j = 0; j < image->getMatrice()->getWidth(); j++)
-            if (j < image->getMatrice()->getWidth() - 1)
-                os << image->getMatrice()->operator()(i, j) << " | ";
+        for (size_t j = 0; j < matrice.getWidth(); j++)
+        {
+            if constexpr (estContigue<M>::value)
+                EcritureElement<Element>::afficher(matrice.getLigne(i)[j], tampon);
             else
-                os << image->getMatrice()->operator()(i, j) << " |";
-        os << std::endl;
+                EcritureElement<Element>::afficher(matrice(i, j), tampon);
+            tampon += j + 1 < matrice.getWidth() ? " | " : " |";
+        }
+        tampon += '\n';
+        ecriture::vider(tampon, os);
     }
+    ecriture::vider(tampon, os, true);
     return os;
 }
 
@@ -0,0 +1,143 @@
+/*
+ * Titre : LectureElement.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef LECTURE_ELEMENT_H
+#define LECTURE_ELEMENT_H
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief trait qui convertit le texte d'une ligne de fichier en element de type T
+ *
+ * La version generique passe par l'operateur >> du type. Les types frequents
+ * (int, Pixel, Couleur) sont specialises pour analyser le texte sur place,
+ * sans construire de flux. Comme avec l'operateur >>, un texte invalide ne
+ * fait pas echouer la lecture : l'element garde la valeur que la conversion
+ * lui a laissee.
+ */
+template<typename T>
+struct LectureElement
+{
+    static void lire(const char* debut, const char* fin, T& element)
+    {
+        std::stringstream(std::string(debut, fin)) >> element;
+    }
+};
+
+namespace lecture
+{
+    /**
+     * @brief avance debut jusqu'au premier caractere qui n'est pas un espace
+     */
+    inline const char* ignorerEspaces(const char* debut, const char* fin)
+    {
+        while (debut != fin && (*debut == ' ' || *debut == '\t' || *debut == '\r'))
+            ++debut;
+        return debut;
+    }
+
+    /**
+     * @brief lit un entier signe a partir de debut
+     * @return la position apres l'entier, ou debut si aucun entier n'a ete lu
+     */
+    inline const char* lireEntier(const char* debut, const char* fin, int& valeur)
+    {
+        debut = ignorerEspaces(debut, fin);
+        // std::from_chars refuse le '+' que l'operateur >> accepte
+        if (debut != fin && *debut == '+')
+            ++debut;
+        std::from_chars_result resultat = std::from_chars(debut, fin, valeur);
+        if (resultat.ec == std::errc::result_out_of_range)
+            valeur = *debut == '-' ? std::numeric_limits<int>::min()
+                                   : std::numeric_limits<int>::max();
+        return resultat.ptr;
+    }
+
+    /**
+     * @brief appelle traiterLigne(debutLigne, finLigne) pour chaque ligne non vide
+     * du texte, sans les espaces ni le '\r' de fin de ligne
+     */
+    template<typename F>
+    void parcourirLignes(const char* debut, const char* fin, F traiterLigne)
+    {
+        while (debut != fin)
+        {
+            const char* finLigne = static_cast<const char*>(
+                std::memchr(debut, '\n', static_cast<size_t>(fin - debut)));
+            if (finLigne == nullptr)
+                finLigne = fin;
+
+            const char* finTexte = finLigne;
+            while (finTexte != debut &&
+                   (finTexte[-1] == ' ' || finTexte[-1] == '\t' || finTexte[-1] == '\r'))
+                --finTexte;
+            if (finTexte != debut)
+                traiterLigne(debut, finTexte);
+
+            debut = finLigne == fin ? fin : finLigne + 1;
+        }
+    }
+
+    /**
+     * @brief comme parcourirLignes, mais sur un fichier lu par blocs d'environ
+     * tailleBloc octets plutot que d'un seul coup ; une ligne a cheval sur deux
+     * blocs est reportee au bloc suivant
+     * @return false si le fichier est illisible
+     */
+    template<typename F>
+    bool parcourirLignesFichier(const std::string& nomFichier, size_t tailleBloc,
+                                F traiterLigne)
+    {
+        std::ifstream file(nomFichier, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::vector<char> bloc;
+        size_t reste = 0;
+        while (file)
+        {
+            bloc.resize(reste + tailleBloc);
+            file.read(bloc.data() + reste, static_cast<std::streamsize>(tailleBloc));
+            size_t taille = reste + static_cast<size_t>(file.gcount());
+            const char* debut = bloc.data();
+            const char* fin = debut + taille;
+
+            // Hors du dernier bloc, seules les lignes completes sont traitees
+            const char* finComplete = fin;
+            if (file)
+            {
+                while (finComplete != debut && finComplete[-1] != '\n')
+                    --finComplete;
+            }
+            parcourirLignes(debut, finComplete, traiterLigne);
+
+            reste = size_t(fin - finComplete);
+            std::copy(finComplete, fin, bloc.begin());
+        }
+        return file.eof();
+    }
+} // namespace lecture
+
+/**
+ * @brief specialisation pour les entiers, un texte invalide donne 0 comme avec >>
+ */
+template<>
+struct LectureElement<int>
+{
+    static void lire(const char* debut, const char* fin, int& element)
+    {
+        element = 0;
+        lecture::lireEntier(debut, fin, element);
+    }
+};
+
+#endif
@@ -7,26 +7,60 @@
 #ifndef MATRICE_H
 #define MATRICE_H
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
-#include <sstream>
+#include <string>
 #include <vector>
+#include "EcritureElement.h"
+#include "FichierBinaire.h"
+#include "LectureElement.h"
+
+/**
+ * @brief matrice de H x W elements fixes a la compilation, definie dans
+ * MatriceFixe.h ; sans dimensions, Matrice<T> est la matrice de taille
+ * variable ci-dessous
+ */
+template<typename T, size_t H = 0, size_t W = 0>
+class Matrice;
 
 /**
  * @brief definition de la classe Matrice
+ *
+ * Les elements sont conserves dans un tampon contigu, ligne par ligne. La
+ * ligne posY commence a l'indice posY * stride_ ; stride_ >= width_ laisse de
+ * la place pour agrandir la largeur sans tout redisposer a chaque colonne.
+ * Toutes les cases du tampon hors de la zone height_ x width_ valent T().
+ *
+ * Le tampon appartient normalement a la matrice (elements_), mais peut aussi
+ * etre externe, par exemple un fichier binaire projete en memoire : la matrice
+ * garde alors stockageExterne_ en vie et n'en fait une copie que lorsqu'elle
+ * doit grandir au-dela de la zone projetee.
  */
 template<typename T>
-class Matrice
+class Matrice<T>
 {
 public:
     Matrice();
+    Matrice(size_t height, size_t width);
+    Matrice(std::shared_ptr<void> stockage, T* donnees, size_t height, size_t width,
+            size_t stride);
+    Matrice(const Matrice<T>& matrice);
+    Matrice(Matrice<T>&& matrice) noexcept;
     // Destructeur
     ~Matrice() = default;
+    Matrice<T>& operator=(const Matrice<T>& matrice);
+    Matrice<T>& operator=(Matrice<T>&& matrice) noexcept;
     T operator()(const size_t& posY, const size_t& posX) const;
     // Lecture du fichier
     bool chargerDepuisFichier(const std::string& nomFichier);
     bool lireElement(const std::string& elementFichier, const size_t& posY, const size_t& posX);
+    bool sauvegarderFichierTexte(const std::string& nomFichier) const;
+    // Format binaire (voir FichierBinaire.h)
+    bool chargerFichierBinaire(const std::string& nomFichier);
+    bool sauvegarderFichierBinaire(const std::string& nomFichier) const;
     // Remplir un matrice
     bool ajouterElement(T element, const size_t& posY, const size_t& posX);
     // Faire une copie
@@ -34,31 +68,142 @@ public:
     // Setters
     void setHeight(size_t height);
     void setWidth(size_t width);
+    void reinitialiser(size_t height, size_t width);
     // Getters
     size_t getHeight() const;
     size_t getWidth() const;
+    size_t getStride() const;
+    // Acces direct aux lignes du tampon
+    T* getLigne(size_t posY);
+    const T* getLigne(size_t posY) const;
+    void echanger(Matrice<T>& matrice);
 
 private:
-    std::vector<std::vector<T>> elements_;
+    void reorganiser(size_t stride);
+
+    std::vector<T> elements_;
+    std::shared_ptr<void> stockageExterne_;
+    T* donnees_;
+    size_t capacite_;
     size_t height_;
     size_t width_;
+    size_t stride_;
 };
 
-namespace
+/**
+ * @brief constructeur par défaut de la classe, la matrice est vide
+ */
+template<typename T>
+inline Matrice<T>::Matrice()
+    : donnees_(nullptr)
+    , capacite_(0)
+    , height_(0)
+    , width_(0)
+    , stride_(0)
+{
+}
+
+/**
+ * @brief constructeur par paramètres de la classe
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ */
+template<typename T>
+inline Matrice<T>::Matrice(size_t height, size_t width)
+    : elements_(height * width)
+    , donnees_(elements_.data())
+    , capacite_(height * width)
+    , height_(height)
+    , width_(width)
+    , stride_(width)
 {
-    static constexpr int CAPACITE_MATRICE = 100;
 }
 
 /**
- * @brief constructeur par défaut de la classe
+ * @brief constructeur sur un tampon externe, sans copie
+ * @param stockage, objet qui possede le tampon et que la matrice garde en vie
+ * @param donnees, le premier element de la premiere ligne
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ * @param stride, le nombre d'elements entre le debut de deux lignes
  */
 template<typename T>
-inline Matrice<T>::Matrice()
-    : height_(0)
-    , width_(0)
+inline Matrice<T>::Matrice(std::shared_ptr<void> stockage, T* donnees, size_t height,
+                           size_t width, size_t stride)
+    : stockageExterne_(std::move(stockage))
+    , donnees_(donnees)
+    , capacite_(height * stride)
+    , height_(height)
+    , width_(width)
+    , stride_(stride)
 {
-    elements_.resize(CAPACITE_MATRICE, std::vector<T>(CAPACITE_MATRICE));
 }
+
+/**
+ * @brief constructeur par copie, la copie possede toujours son propre tampon
+ */
+template<typename T>
+inline Matrice<T>::Matrice(const Matrice<T>& matrice)
+    : Matrice(matrice.height_, matrice.width_)
+{
+    for (size_t h = 0; h < height_; h++)
+        std::copy(matrice.getLigne(h), matrice.getLigne(h) + width_, getLigne(h));
+}
+
+/**
+ * @brief operateur d'affectation par copie
+ */
+template<typename T>
+inline Matrice<T>& Matrice<T>::operator=(const Matrice<T>& matrice)
+{
+    if (this != &matrice)
+    {
+        Matrice<T> copie(matrice);
+        echanger(copie);
+    }
+    return *this;
+}
+
+/**
+ * @brief constructeur par deplacement : le tampon change de proprietaire,
+ * matrice devient vide
+ */
+template<typename T>
+inline Matrice<T>::Matrice(Matrice<T>&& matrice) noexcept
+    : Matrice()
+{
+    echanger(matrice);
+}
+
+/**
+ * @brief operateur d'affectation par deplacement, matrice devient vide
+ */
+template<typename T>
+inline Matrice<T>& Matrice<T>::operator=(Matrice<T>&& matrice) noexcept
+{
+    if (this != &matrice)
+    {
+        Matrice<T> deplacee(std::move(matrice));
+        echanger(deplacee);
+    }
+    return *this;
+}
+
+/**
+ * @brief echange le contenu de deux matrices sans copier leurs elements
+ */
+template<typename T>
+inline void Matrice<T>::echanger(Matrice<T>& matrice)
+{
+    elements_.swap(matrice.elements_);
+    stockageExterne_.swap(matrice.stockageExterne_);
+    std::swap(donnees_, matrice.donnees_);
+    std::swap(capacite_, matrice.capacite_);
+    std::swap(height_, matrice.height_);
+    std::swap(width_, matrice.width_);
+    std::swap(stride_, matrice.stride_);
+}
+
 /**
  * @brief retourne le nombre de lignes de la matrice
  * @return l'attribut height_ de l'objet
@@ -77,23 +222,47 @@ inline size_t Matrice<T>::getWidth() const
 {
     return width_;
 }
+/**
+ * @brief retourne le nombre d'elements entre le debut de deux lignes consecutives
+ * @return l'attribut stride_ de l'objet
+ */
+template<typename T>
+inline size_t Matrice<T>::getStride() const
+{
+    return stride_;
+}
+/**
+ * @brief retourne un pointeur vers le premier element d'une ligne
+ * @param posY, la ligne voulue, doit etre inferieure a getHeight()
+ */
+template<typename T>
+inline T* Matrice<T>::getLigne(size_t posY)
+{
+    return donnees_ + posY * stride_;
+}
+
+template<typename T>
+inline const T* Matrice<T>::getLigne(size_t posY) const
+{
+    return donnees_ + posY * stride_;
+}
 
 template<typename T>
-T Matrice<T>::operator()(const size_t& posY, const size_t& posX) const
+inline T Matrice<T>::operator()(const size_t& posY, const size_t& posX) const
 {
-    if (posY > height_ || posX > width_)
+    if (posY >= height_ || posX >= width_)
         return T();
 
-    return elements_[posX][posY];
+    return donnees_[posY * stride_ + posX];
 }
 
 template<typename T>
-bool Matrice<T>::ajouterElement(T element, const size_t& posY, const size_t& posX)
+inline bool Matrice<T>::ajouterElement(T element, const size_t& posY, const size_t& posX)
 {
-    if (posY > height_ || posX > width_)
+    if (posY >= height_ || posX >= width_)
         return false;
 
-    elements_[posX][posY] = element;
+    donnees_[posY * stride_ + posX] = element;
     return true;
 }
 
@@ -101,72 +270,250 @@ template<typename T>
 bool Matrice<T>::lireElement(const std::string& elementFichier, const size_t& posY,
                              const size_t& posX)
 {
-    T element;
-    std::stringstream(elementFichier) >> element;
+    T element{};
+    LectureElement<T>::lire(elementFichier.data(), elementFichier.data() + elementFichier.size(),
+                            element);
 
     return ajouterElement(element, posY, posX);
 }
 
+/**
+ * @brief ajoute a la matrice les lignes d'un fichier texte ou chaque ligne
+ * contient un element et ou "L" commence une nouvelle ligne de la matrice
+ * @param nomFichier, le chemin du fichier
+ * @return false si le fichier est illisible ou si un element precede le premier "L"
+ */
 template<typename T>
 bool Matrice<T>::chargerDepuisFichier(const std::string& nomFichier)
 {
-    std::ifstream file(nomFichier);
-    std::string element;
-    size_t posX = 0;
-    size_t posY = 0;
+    std::ifstream file(nomFichier, std::ios::binary | std::ios::ate);
 
     if (!file)
         return false;
 
-    while (!file.eof())
-    {
-        std::getline(file, element);
+    // Tout le fichier est lu d'un bloc puis analyse sur place
+    std::string contenu(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(contenu.data(), static_cast<std::streamsize>(contenu.size())))
+        return false;
 
-        if (element == "L")
+    const char* debut = contenu.data();
+    const char* fin = debut + contenu.size();
+
+    // Premier passage : les dimensions, pour n'allouer le tampon qu'une fois
+    size_t nouvellesLignes = 0;
+    size_t largeur = width_;
+    size_t posX = 0;
+    bool elementOrphelin = false;
+    lecture::parcourirLignes(debut, fin, [&](const char* ligne, const char* finLigne) {
+        if (finLigne - ligne == 1 && *ligne == 'L')
         {
-            posY = height_;
+            nouvellesLignes++;
             posX = 0;
-            height_++;
         }
-        else 
+        else
         {
-            if (posX + 1 > width_)
-                width_ = posX + 1;
+            elementOrphelin |= nouvellesLignes == 0;
+            largeur = std::max(largeur, ++posX);
+        }
+    });
+
+    if (elementOrphelin)
+        return false;
+
+    size_t posY = height_;
+    setWidth(largeur);
+    setHeight(height_ + nouvellesLignes);
+
+    // Second passage : les elements sont convertis directement dans le tampon
+    T* ligneCourante = nullptr;
+    lecture::parcourirLignes(debut, fin, [&](const char* ligne, const char* finLigne) {
+        if (finLigne - ligne == 1 && *ligne == 'L')
+        {
+            ligneCourante = getLigne(posY++);
+            posX = 0;
+        }
+        else
+            LectureElement<T>::lire(ligne, finLigne, ligneCourante[posX++]);
+    });
+
+    return true;
+}
+
+/**
+ * @brief ecrit la matrice dans le format texte que chargerDepuisFichier relit :
+ * "L" avant chaque ligne, puis un element par ligne. Le texte est converti
+ * dans un tampon (EcritureElement) et ecrit par blocs.
+ * @param nomFichier, le chemin du fichier
+ * @return false si l'ecriture a echoue, ou si le texte d'un element ne se
+ * relirait pas a sa place (voir ecriture::estRelisible), comme une Couleur
+ * sans nom ; le fichier s'arrete alors avant cet element
+ */
+template<typename T>
+bool Matrice<T>::sauvegarderFichierTexte(const std::string& nomFichier) const
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    std::string tampon;
+    tampon.reserve(ecriture::TAILLE_BLOC + 64);
 
-            if (!lireElement(element, posY, posX))
+    for (size_t h = 0; h < height_; h++)
+    {
+        tampon += "L\n";
+        for (const T* element = getLigne(h); element != getLigne(h) + width_; ++element)
+        {
+            if (!ecriture::ecrireLigne(*element, tampon))
+            {
+                ecriture::vider(tampon, file, true);
                 return false;
-            
-            posX++;
+            }
+            ecriture::vider(tampon, file);
         }
     }
+    ecriture::vider(tampon, file, true);
+
+    return bool(file);
+}
+
+/**
+ * @brief remplace la matrice par le contenu d'un fichier binaire projete en
+ * memoire ; les elements ne sont pas copies tant que la matrice ne grandit pas
+ * @param nomFichier, le chemin du fichier
+ * @return false si le fichier est illisible ou ne contient pas des elements de type T
+ */
+template<typename T>
+bool Matrice<T>::chargerFichierBinaire(const std::string& nomFichier)
+{
+    size_t taille = 0;
+    std::shared_ptr<void> projection = projeterFichier(nomFichier, taille);
+    if (!projection || taille < sizeof(EnteteFichierBinaire))
+        return false;
+
+    EnteteFichierBinaire entete;
+    std::memcpy(&entete, projection.get(), sizeof(entete));
+    // Comparaison par divisions : height * width * sizeof(T) peut depasser 64 bits
+    if (!FormatBinaire<T>::accepte(entete) ||
+        (entete.width != 0 &&
+         entete.height > (taille - sizeof(entete)) / sizeof(T) / entete.width))
+        return false;
 
+    T* donnees = reinterpret_cast<T*>(static_cast<char*>(projection.get()) + sizeof(entete));
+    Matrice<T> matrice(std::move(projection), donnees, size_t(entete.height),
+                       size_t(entete.width), size_t(entete.width));
+    echanger(matrice);
     return true;
 }
 
+/**
+ * @brief ecrit la matrice dans le format binaire de FichierBinaire.h
+ * @param nomFichier, le chemin du fichier
+ * @return false si l'ecriture a echoue
+ */
+template<typename T>
+bool Matrice<T>::sauvegarderFichierBinaire(const std::string& nomFichier) const
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    EnteteFichierBinaire entete = FormatBinaire<T>::creerEntete(height_, width_);
+
+    file.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    for (size_t h = 0; h < height_; h++)
+        file.write(reinterpret_cast<const char*>(getLigne(h)),
+                   static_cast<std::streamsize>(width_ * sizeof(T)));
+
+    return bool(file);
+}
+
 template<typename T>
 std::unique_ptr<Matrice<T>> Matrice<T>::clone() const
 {
-    std::unique_ptr<Matrice<T>> matrice = std::make_unique<Matrice<T>>();
+    std::unique_ptr<Matrice<T>> matrice = std::make_unique<Matrice<T>>(height_, width_);
 
-    matrice->height_ = height_;
-    matrice->width_ = width_;
+    for (size_t h = 0; h < height_; h++)
+        std::copy(getLigne(h), getLigne(h) + width_, matrice->getLigne(h));
+
+    return matrice;
+}
+
+/**
+ * @brief copie les elements dans un nouveau tampon, possede par la matrice, ou
+ * les lignes sont espacees de stride
+ * @param stride, le nouvel espacement des lignes, au moins width_
+ */
+template<typename T>
+void Matrice<T>::reorganiser(size_t stride)
+{
+    std::vector<T> elements(height_ * stride);
 
     for (size_t h = 0; h < height_; h++)
-        for (size_t w = 0; w < width_; w++)
-            matrice->ajouterElement(elements_[w][h], h, w);
+        std::copy(getLigne(h), getLigne(h) + width_, elements.begin() + h * stride);
 
-    return std::move(matrice);
+    elements_.swap(elements);
+    stockageExterne_.reset();
+    donnees_ = elements_.data();
+    capacite_ = elements_.size();
+    stride_ = stride;
 }
 
 template<typename T>
 void Matrice<T>::setHeight(size_t height)
 {
-    height > CAPACITE_MATRICE ? height_ = CAPACITE_MATRICE : height_ = height;
+    if (height < height_)
+        std::fill(getLigne(height), getLigne(height_), T());
+    else if (height * stride_ > capacite_)
+    {
+        if (stockageExterne_)
+            reorganiser(stride_);
+        elements_.resize(height * stride_);
+        donnees_ = elements_.data();
+        capacite_ = elements_.size();
+    }
+
+    height_ = height;
+}
+
+/**
+ * @brief donne de nouvelles dimensions a la matrice sans conserver ses elements,
+ * qui valent tous T() ensuite. Un tampon possede assez grand est reutilise
+ * sans allocation (voir DoubleTampon.h).
+ * @param height, le nouveau nombre de lignes
+ * @param width, le nouveau nombre de colonnes
+ */
+template<typename T>
+void Matrice<T>::reinitialiser(size_t height, size_t width)
+{
+    if (stockageExterne_)
+    {
+        Matrice<T> matrice(height, width);
+        echanger(matrice);
+        return;
+    }
+
+    // Plus petit, le tampon garde toute sa taille : les elements ne sont pas
+    // detruits et gardent leurs propres allocations (std::string par exemple)
+    if (height * width > elements_.size())
+        elements_.assign(height * width, T());
+    else
+        std::fill(elements_.begin(), elements_.end(), T());
+    donnees_ = elements_.data();
+    capacite_ = elements_.size();
+    height_ = height;
+    width_ = width;
+    stride_ = width;
 }
 
 template<typename T>
 void Matrice<T>::setWidth(size_t width)
 {
-    width > CAPACITE_MATRICE ? width_ = CAPACITE_MATRICE : width_ = width;
+    if (width < width_)
+    {
+        for (size_t h = 0; h < height_; h++)
+            std::fill(getLigne(h) + width, getLigne(h) + width_, T());
+    }
+    else if (width > stride_)
+    {
+        // Croissance geometrique pour que le chargement colonne par colonne reste lineaire
+        reorganiser(std::max(width, 2 * stride_));
+    }
+
+    width_ = width;
 }
 #endif
@@ -0,0 +1,319 @@
+/*
+ * Titre : MatriceFixe.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef MATRICE_FIXE_H
+#define MATRICE_FIXE_H
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include "EcritureElement.h"
+#include "Matrice.h"
+#include "PivoterMatrice.h"
+#include "def.h"
+
+namespace fixe
+{
+    // Au-dela de ce nombre d'elements, les copies des transformations sont
+    // faites par une boucle plutot que deroulees a la compilation
+    static constexpr size_t DEROULEMENT_MAX = 64;
+
+    constexpr bool estQuartDeTour(Direction direction)
+    {
+        return direction == Direction::Right || direction == Direction::Left;
+    }
+} // namespace fixe
+
+/**
+ * @brief definition de la classe Matrice de taille fixe
+ *
+ * Matrice de H x W elements rangee dans un std::array, sans allocation, pour
+ * les petits noyaux et blocs (3 x 3, 5 x 5, 8 x 8, ...). Les dimensions sont
+ * des constantes (HEIGHT, WIDTH, voir estFixe dans def.h) et les lignes sont
+ * contigues, comme celles de Matrice<T>.
+ *
+ * pivotee<D>() et agrandie<R>() retournent une nouvelle matrice fixe dont
+ * chaque element est copie de sa source a un indice calcule a la compilation ;
+ * jusqu'a fixe::DEROULEMENT_MAX elements, la copie est entierement deroulee.
+ * La classe s'utilise aussi avec Image et PivoterMatrice, qui s'en servent
+ * pour pivoter sur place quand les dimensions le permettent (matrice carree,
+ * ou demi-tour et miroirs). Les transformations qui changent les dimensions
+ * (AgrandirMatrice, RedimensionnerMatrice) sont refusees a la compilation.
+ */
+template<typename T, size_t H, size_t W>
+class Matrice
+{
+    static_assert(H > 0 && W > 0, "Une matrice de taille fixe a au moins un element");
+
+public:
+    static constexpr size_t HEIGHT = H;
+    static constexpr size_t WIDTH = W;
+    // Type de la matrice pivotee dans la direction D
+    template<Direction D>
+    using Pivotee = Matrice<T, fixe::estQuartDeTour(D) ? W : H, fixe::estQuartDeTour(D) ? H : W>;
+
+    constexpr Matrice();
+    constexpr explicit Matrice(const std::array<T, H * W>& elements);
+    constexpr T operator()(const size_t& posY, const size_t& posX) const;
+    // Lecture du fichier
+    bool chargerDepuisFichier(const std::string& nomFichier);
+    bool sauvegarderFichierTexte(const std::string& nomFichier) const;
+    // Remplir une matrice
+    constexpr bool ajouterElement(T element, const size_t& posY, const size_t& posX);
+    // Faire une copie
+    std::unique_ptr<Matrice<T, H, W>> clone() const;
+    // Transformations calculees a la compilation
+    template<Direction D>
+    constexpr Pivotee<D> pivotee() const;
+    template<unsigned R>
+    constexpr Matrice<T, H * R, W * R> agrandie() const;
+    // Getters
+    static constexpr size_t getHeight();
+    static constexpr size_t getWidth();
+    static constexpr size_t getStride();
+    // Acces direct aux lignes
+    constexpr T* getLigne(size_t posY);
+    constexpr const T* getLigne(size_t posY) const;
+
+private:
+    template<typename, size_t, size_t>
+    friend class Matrice;
+
+    template<Direction D>
+    static constexpr size_t trouverSourcePivotee(size_t indice);
+    template<unsigned R>
+    static constexpr size_t trouverSourceAgrandie(size_t indice);
+    template<size_t (*source)(size_t), class Destination>
+    constexpr void copierVers(Destination& destination) const;
+    template<size_t (*source)(size_t), class Destination, size_t... I>
+    constexpr void copierDeroule(Destination& destination, std::index_sequence<I...>) const;
+
+    std::array<T, H * W> elements_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe, tous les elements valent T()
+ */
+template<typename T, size_t H, size_t W>
+constexpr Matrice<T, H, W>::Matrice()
+    : elements_()
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ * @param elements, les H x W elements, ligne par ligne
+ */
+template<typename T, size_t H, size_t W>
+constexpr Matrice<T, H, W>::Matrice(const std::array<T, H * W>& elements)
+    : elements_(elements)
+{
+}
+
+template<typename T, size_t H, size_t W>
+constexpr size_t Matrice<T, H, W>::getHeight()
+{
+    return H;
+}
+
+template<typename T, size_t H, size_t W>
+constexpr size_t Matrice<T, H, W>::getWidth()
+{
+    return W;
+}
+
+template<typename T, size_t H, size_t W>
+constexpr size_t Matrice<T, H, W>::getStride()
+{
+    return W;
+}
+
+template<typename T, size_t H, size_t W>
+constexpr T* Matrice<T, H, W>::getLigne(size_t posY)
+{
+    return elements_.data() + posY * W;
+}
+
+template<typename T, size_t H, size_t W>
+constexpr const T* Matrice<T, H, W>::getLigne(size_t posY) const
+{
+    return elements_.data() + posY * W;
+}
+
+template<typename T, size_t H, size_t W>
+constexpr T Matrice<T, H, W>::operator()(const size_t& posY, const size_t& posX) const
+{
+    if (posY >= H || posX >= W)
+        return T();
+
+    return elements_[posY * W + posX];
+}
+
+template<typename T, size_t H, size_t W>
+constexpr bool Matrice<T, H, W>::ajouterElement(T element, const size_t& posY,
+                                                const size_t& posX)
+{
+    if (posY >= H || posX >= W)
+        return false;
+
+    elements_[posY * W + posX] = element;
+    return true;
+}
+
+template<typename T, size_t H, size_t W>
+std::unique_ptr<Matrice<T, H, W>> Matrice<T, H, W>::clone() const
+{
+    return std::make_unique<Matrice<T, H, W>>(*this);
+}
+
+/**
+ * @brief remplace les elements par ceux d'un fichier texte au format de
+ * Matrice<T> ; les elements absents du fichier valent T()
+ * @return false, sans rien modifier, si le fichier est illisible ou contient
+ * plus de H lignes ou de W colonnes
+ */
+template<typename T, size_t H, size_t W>
+bool Matrice<T, H, W>::chargerDepuisFichier(const std::string& nomFichier)
+{
+    Matrice<T> matrice;
+    if (!matrice.chargerDepuisFichier(nomFichier) || matrice.getHeight() > H ||
+        matrice.getWidth() > W)
+        return false;
+
+    elements_.fill(T());
+    for (size_t h = 0; h < matrice.getHeight(); h++)
+        std::copy(matrice.getLigne(h), matrice.getLigne(h) + matrice.getWidth(), getLigne(h));
+    return true;
+}
+
+/**
+ * @brief ecrit la matrice dans le format texte de Matrice<T>
+ * @return false si l'ecriture a echoue ou si un element ne se relirait pas
+ */
+template<typename T, size_t H, size_t W>
+bool Matrice<T, H, W>::sauvegarderFichierTexte(const std::string& nomFichier) const
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    std::string tampon;
+
+    for (size_t h = 0; h < H; h++)
+    {
+        tampon += "L\n";
+        for (const T* element = getLigne(h); element != getLigne(h) + W; ++element)
+        {
+            if (!ecriture::ecrireLigne(*element, tampon))
+            {
+                ecriture::vider(tampon, file, true);
+                return false;
+            }
+        }
+    }
+    ecriture::vider(tampon, file, true);
+
+    return bool(file);
+}
+
+/**
+ * @brief indice dans elements_ de la source de l'element indice de la matrice
+ * pivotee dans la direction D : le pivotement inverse y ramene
+ */
+template<typename T, size_t H, size_t W>
+template<Direction D>
+constexpr size_t Matrice<T, H, W>::trouverSourcePivotee(size_t indice)
+{
+    using Destination = Pivotee<D>;
+    Coordonnees source = PivoterMatrice<Destination>::trouverDestination(
+        PivoterMatrice<Destination>::trouverInverse(D), indice / Destination::WIDTH,
+        indice % Destination::WIDTH, Destination::HEIGHT, Destination::WIDTH);
+    return size_t(source.y) * W + size_t(source.x);
+}
+
+/**
+ * @brief indice dans elements_ du plus proche voisin de l'element indice de la
+ * matrice agrandie R fois
+ */
+template<typename T, size_t H, size_t W>
+template<unsigned R>
+constexpr size_t Matrice<T, H, W>::trouverSourceAgrandie(size_t indice)
+{
+    return indice / (W * R) / R * W + indice % (W * R) / R;
+}
+
+/**
+ * @brief copie dans chaque element i de destination l'element source(i) ;
+ * la copie est deroulee si destination est assez petite
+ */
+template<typename T, size_t H, size_t W>
+template<size_t (*source)(size_t), class Destination>
+constexpr void Matrice<T, H, W>::copierVers(Destination& destination) const
+{
+    constexpr size_t nombre = Destination::HEIGHT * Destination::WIDTH;
+    if constexpr (nombre <= fixe::DEROULEMENT_MAX)
+        copierDeroule<source>(destination, std::make_index_sequence<nombre>());
+    else
+    {
+        for (size_t i = 0; i < nombre; ++i)
+            destination.elements_[i] = elements_[source(i)];
+    }
+}
+
+/**
+ * @brief une affectation par element, dont les deux indices sont des
+ * constantes de compilation
+ */
+template<typename T, size_t H, size_t W>
+template<size_t (*source)(size_t), class Destination, size_t... I>
+constexpr void Matrice<T, H, W>::copierDeroule(Destination& destination,
+                                               std::index_sequence<I...>) const
+{
+    ((destination.elements_[I] = elements_[std::integral_constant<size_t, source(I)>::value]),
+     ...);
+}
+
+/**
+ * @brief retourne la matrice pivotee ou retournee dans la direction D
+ */
+template<typename T, size_t H, size_t W>
+template<Direction D>
+constexpr auto Matrice<T, H, W>::pivotee() const -> Pivotee<D>
+{
+    Pivotee<D> resultat;
+    copierVers<&Matrice::trouverSourcePivotee<D>>(resultat);
+    return resultat;
+}
+
+/**
+ * @brief retourne la matrice agrandie R fois au plus proche voisin
+ */
+template<typename T, size_t H, size_t W>
+template<unsigned R>
+constexpr Matrice<T, H * R, W * R> Matrice<T, H, W>::agrandie() const
+{
+    static_assert(R > 0, "Le rapport d'agrandissement doit etre positif");
+    Matrice<T, H * R, W * R> resultat;
+    if constexpr (H * R * W * R <= fixe::DEROULEMENT_MAX)
+        copierVers<&Matrice::trouverSourceAgrandie<R>>(resultat);
+    else
+    {
+        // Chaque ligne source est dupliquee element par element une fois, puis
+        // recopiee d'un bloc dans les R - 1 lignes suivantes
+        for (size_t y = 0; y < H; y++)
+        {
+            T* ligne = resultat.getLigne(y * R);
+            for (size_t x = 0; x < W; x++)
+                for (size_t r = 0; r < R; r++)
+                    ligne[x * R + r] = elements_[y * W + x];
+            for (size_t r = 1; r < R; r++)
+                std::copy(ligne, ligne + W * R, resultat.getLigne(y * R + r));
+        }
+    }
+    return resultat;
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Titre : MatricePlanaire.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef MATRICE_PLANAIRE_H
+#define MATRICE_PLANAIRE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Matrice.h"
+#include "Pixel.h"
+
+namespace planaire
+{
+    static constexpr size_t ROUGE = 0;
+    static constexpr size_t VERT = 1;
+    static constexpr size_t BLEU = 2;
+    static constexpr size_t NOMBRE_PLANS = 3;
+    // Alignement du debut de chaque ligne d'un plan, en octets (un registre AVX2)
+    static constexpr size_t ALIGNEMENT = 32;
+} // namespace planaire
+
+/**
+ * @brief definition de la classe MatricePlanaire
+ *
+ * Matrice de pixels rangee en trois plans separes (rouge, vert, bleu) plutot
+ * qu'en pixels entrelaces de trois octets. Chaque plan est une
+ * Matrice<uint8_t> dont les lignes commencent sur une frontiere de
+ * planaire::ALIGNEMENT octets, de sorte qu'une operation sur un canal est une
+ * simple boucle sur des octets contigus.
+ *
+ * L'interface est celle de Matrice<Pixel> : la classe s'utilise directement
+ * avec Image, et les transformations (PivoterMatrice, AgrandirMatrice, ...)
+ * traitent chaque plan avec leur version contigue (voir estPlanaire dans def.h).
+ * Un plan realloue par Matrice<uint8_t> elle-meme (transformation qui change
+ * les dimensions, croissance) n'a plus que l'alignement de l'allocateur.
+ */
+class MatricePlanaire
+{
+public:
+    MatricePlanaire();
+    MatricePlanaire(size_t height, size_t width);
+    explicit MatricePlanaire(const Matrice<Pixel>& matrice);
+    MatricePlanaire(const MatricePlanaire& matrice);
+    MatricePlanaire(MatricePlanaire&& matrice) noexcept = default;
+    ~MatricePlanaire() = default;
+    MatricePlanaire& operator=(const MatricePlanaire& matrice);
+    MatricePlanaire& operator=(MatricePlanaire&& matrice) noexcept = default;
+    Pixel operator()(const size_t& posY, const size_t& posX) const;
+    // Lecture du fichier
+    bool chargerDepuisFichier(const std::string& nomFichier);
+    bool lireElement(const std::string& elementFichier, const size_t& posY, const size_t& posX);
+    bool sauvegarderFichierTexte(const std::string& nomFichier) const;
+    // Format binaire, identique a celui de Matrice<Pixel>
+    bool chargerFichierBinaire(const std::string& nomFichier);
+    bool sauvegarderFichierBinaire(const std::string& nomFichier) const;
+    // Remplir une matrice
+    bool ajouterElement(Pixel element, const size_t& posY, const size_t& posX);
+    // Faire une copie
+    std::unique_ptr<MatricePlanaire> clone() const;
+    // Conversion depuis et vers les pixels entrelaces
+    void depuisEntrelacee(const Matrice<Pixel>& matrice);
+    std::unique_ptr<Matrice<Pixel>> versEntrelacee() const;
+    // Setters
+    void setHeight(size_t height);
+    void setWidth(size_t width);
+    void reinitialiser(size_t height, size_t width);
+    // Getters
+    size_t getHeight() const;
+    size_t getWidth() const;
+    size_t getNombrePlans() const;
+    // Acces direct aux plans
+    Matrice<uint8_t>& getPlan(size_t canal);
+    const Matrice<uint8_t>& getPlan(size_t canal) const;
+
+private:
+    static Matrice<uint8_t> creerPlan(size_t height, size_t width);
+
+    std::array<Matrice<uint8_t>, planaire::NOMBRE_PLANS> plans_;
+};
+
+/**
+ * @brief retourne le nombre de lignes de la matrice
+ */
+inline size_t MatricePlanaire::getHeight() const
+{
+    return plans_[planaire::ROUGE].getHeight();
+}
+
+/**
+ * @brief retourne le nombre de colonnes de la matrice
+ */
+inline size_t MatricePlanaire::getWidth() const
+{
+    return plans_[planaire::ROUGE].getWidth();
+}
+
+/**
+ * @brief retourne le nombre de plans, un par canal
+ */
+inline size_t MatricePlanaire::getNombrePlans() const
+{
+    return planaire::NOMBRE_PLANS;
+}
+
+/**
+ * @brief retourne le plan d'un canal
+ * @param canal, planaire::ROUGE, planaire::VERT ou planaire::BLEU
+ */
+inline Matrice<uint8_t>& MatricePlanaire::getPlan(size_t canal)
+{
+    return plans_[canal];
+}
+
+inline const Matrice<uint8_t>& MatricePlanaire::getPlan(size_t canal) const
+{
+    return plans_[canal];
+}
+
+inline Pixel MatricePlanaire::operator()(const size_t& posY, const size_t& posX) const
+{
+    return Pixel(plans_[planaire::ROUGE](posY, posX), plans_[planaire::VERT](posY, posX),
+                 plans_[planaire::BLEU](posY, posX));
+}
+
+inline bool MatricePlanaire::ajouterElement(Pixel element, const size_t& posY,
+                                            const size_t& posX)
+{
+    if (posY >= getHeight() || posX >= getWidth())
+        return false;
+
+    plans_[planaire::ROUGE].getLigne(posY)[posX] = element.getRouge();
+    plans_[planaire::VERT].getLigne(posY)[posX] = element.getVert();
+    plans_[planaire::BLEU].getLigne(posY)[posX] = element.getBleu();
+    return true;
+}
+
+#endif
@@ -0,0 +1,661 @@
+/*
+ * Titre : MatriceTuilee.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef MATRICE_TUILEE_H
+#define MATRICE_TUILEE_H
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "EcritureElement.h"
+#include "FichierBinaire.h"
+#include "FichierTuiles.h"
+#include "LectureElement.h"
+
+namespace tuilee
+{
+    // Cote des tuiles, en elements : une tuile de Pixel occupe 48 Kio
+    static constexpr size_t COTE = 128;
+    // Memoire accordee par defaut aux tuiles en cache, en octets
+    static constexpr size_t BUDGET_DEFAUT = size_t(64) << 20;
+    // Tuiles gardees en cache quel que soit le budget : un pivotement lit
+    // jusqu'a quatre tuiles source pour remplir une tuile destination
+    static constexpr size_t TUILES_MINIMUM = 8;
+    // Taille des blocs lus par chargerDepuisFichier
+    static constexpr size_t TAILLE_LECTURE = 1 << 20;
+} // namespace tuilee
+
+/**
+ * @brief definition de la classe MatriceTuilee
+ *
+ * Matrice decoupee en tuiles de tuilee::COTE x tuilee::COTE elements, pour les
+ * images plus grandes que la memoire. Seules les tuiles les plus recemment
+ * utilisees restent en memoire, dans la limite d'un budget en octets ; les
+ * autres sont deposees dans un fichier temporaire (FichierTuiles) et relues a
+ * la demande. Une tuile jamais ecrite n'existe nulle part : ses elements
+ * valent T().
+ *
+ * L'interface est celle de Matrice<T> (operator(), ajouterElement, setHeight,
+ * clone, ...) : la classe s'utilise directement avec Image et les
+ * transformations, qui parcourent la destination tuile par tuile (voir
+ * estTuilee dans def.h) pour que les tuiles soient lues et ecrites a peu pres
+ * dans l'ordre. Un parcours ligne par ligne (fichiers, affichage) reste
+ * efficace tant qu'une bande de tuiles de la largeur de la matrice tient dans
+ * le budget. Chaque copie (clone) a son propre budget et son propre fichier.
+ *
+ * Une erreur d'entree-sortie sur le fichier temporaire rend la matrice
+ * invalide (estValide) : les elements concernes valent alors T().
+ */
+template<typename T>
+class MatriceTuilee
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Les tuiles sont ecrites octet par octet dans le fichier temporaire");
+
+public:
+    MatriceTuilee();
+    MatriceTuilee(size_t height, size_t width, size_t budget = tuilee::BUDGET_DEFAUT);
+    MatriceTuilee(const MatriceTuilee<T>& matrice);
+    MatriceTuilee(MatriceTuilee<T>&& matrice) noexcept;
+    ~MatriceTuilee() = default;
+    MatriceTuilee<T>& operator=(const MatriceTuilee<T>& matrice);
+    MatriceTuilee<T>& operator=(MatriceTuilee<T>&& matrice) noexcept;
+    T operator()(const size_t& posY, const size_t& posX) const;
+    // Lecture du fichier
+    bool chargerDepuisFichier(const std::string& nomFichier);
+    bool lireElement(const std::string& elementFichier, const size_t& posY, const size_t& posX);
+    bool sauvegarderFichierTexte(const std::string& nomFichier) const;
+    // Format binaire (voir FichierBinaire.h), lu et ecrit ligne par ligne
+    bool chargerFichierBinaire(const std::string& nomFichier);
+    bool sauvegarderFichierBinaire(const std::string& nomFichier) const;
+    // Remplir une matrice
+    bool ajouterElement(T element, const size_t& posY, const size_t& posX);
+    // Faire une copie
+    std::unique_ptr<MatriceTuilee<T>> clone() const;
+    // Setters
+    void setHeight(size_t height);
+    void setWidth(size_t width);
+    void setBudget(size_t budget);
+    // Getters
+    size_t getHeight() const;
+    size_t getWidth() const;
+    size_t getCoteTuile() const;
+    size_t getBudget() const;
+    bool estValide() const;
+    void echanger(MatriceTuilee<T>& matrice);
+
+private:
+    struct Tuile
+    {
+        size_t cle;
+        bool modifiee;
+        std::vector<T> elements;
+    };
+    using Residentes = std::list<Tuile>;
+
+    static size_t calculerCle(size_t posY, size_t posX);
+    size_t capacite() const;
+    T* trouverTuile(size_t posY, size_t posX, bool ecriture) const;
+    void ecrireTuile(Tuile& tuile) const;
+    void evincer() const;
+    void lireLigne(size_t posY, T* ligne) const;
+    void ecrireLigne(size_t posY, const T* ligne);
+    void effacerHorsLimites(size_t height, size_t width);
+
+    size_t height_;
+    size_t width_;
+    size_t budget_;
+    // Tuiles en memoire, de la plus recemment utilisee a la plus ancienne
+    mutable Residentes residentes_;
+    mutable std::unordered_map<size_t, typename Residentes::iterator> index_;
+    // Emplacement dans le fichier de chaque tuile deja deposee
+    mutable std::unordered_map<size_t, size_t> emplacements_;
+    mutable std::unique_ptr<FichierTuiles> fichier_;
+    // Derniere tuile trouvee, verifiee avant toute recherche
+    mutable Tuile* derniere_;
+    mutable bool valide_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe, la matrice est vide
+ */
+template<typename T>
+inline MatriceTuilee<T>::MatriceTuilee()
+    : MatriceTuilee(0, 0)
+{
+}
+
+/**
+ * @brief constructeur par paramètres de la classe, aucune tuile n'est creee
+ * avant la premiere ecriture
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ * @param budget, la memoire accordee aux tuiles en cache, en octets
+ */
+template<typename T>
+inline MatriceTuilee<T>::MatriceTuilee(size_t height, size_t width, size_t budget)
+    : height_(height)
+    , width_(width)
+    , budget_(budget)
+    , derniere_(nullptr)
+    , valide_(true)
+{
+}
+
+/**
+ * @brief constructeur par copie : le fichier temporaire est copie par blocs
+ * sequentiels et les tuiles en cache le sont en memoire
+ */
+template<typename T>
+MatriceTuilee<T>::MatriceTuilee(const MatriceTuilee<T>& matrice)
+    : MatriceTuilee(matrice.height_, matrice.width_, matrice.budget_)
+{
+    valide_ = matrice.valide_;
+    if (!matrice.emplacements_.empty())
+    {
+        fichier_ = std::make_unique<FichierTuiles>(matrice.fichier_->getTailleTuile());
+        valide_ &= fichier_->copier(*matrice.fichier_);
+        emplacements_ = matrice.emplacements_;
+    }
+
+    for (auto tuile = matrice.residentes_.rbegin(); tuile != matrice.residentes_.rend(); ++tuile)
+    {
+        residentes_.push_front(*tuile);
+        index_[tuile->cle] = residentes_.begin();
+    }
+}
+
+/**
+ * @brief operateur d'affectation par copie
+ */
+template<typename T>
+inline MatriceTuilee<T>& MatriceTuilee<T>::operator=(const MatriceTuilee<T>& matrice)
+{
+    if (this != &matrice)
+    {
+        MatriceTuilee<T> copie(matrice);
+        echanger(copie);
+    }
+    return *this;
+}
+
+/**
+ * @brief constructeur par deplacement : les tuiles et le fichier changent de
+ * proprietaire, matrice devient vide
+ */
+template<typename T>
+inline MatriceTuilee<T>::MatriceTuilee(MatriceTuilee<T>&& matrice) noexcept
+    : MatriceTuilee()
+{
+    echanger(matrice);
+}
+
+/**
+ * @brief operateur d'affectation par deplacement, matrice devient vide
+ */
+template<typename T>
+inline MatriceTuilee<T>& MatriceTuilee<T>::operator=(MatriceTuilee<T>&& matrice) noexcept
+{
+    if (this != &matrice)
+    {
+        MatriceTuilee<T> deplacee(std::move(matrice));
+        echanger(deplacee);
+    }
+    return *this;
+}
+
+/**
+ * @brief echange le contenu de deux matrices sans copier leurs tuiles
+ */
+template<typename T>
+inline void MatriceTuilee<T>::echanger(MatriceTuilee<T>& matrice)
+{
+    std::swap(height_, matrice.height_);
+    std::swap(width_, matrice.width_);
+    std::swap(budget_, matrice.budget_);
+    residentes_.swap(matrice.residentes_);
+    index_.swap(matrice.index_);
+    emplacements_.swap(matrice.emplacements_);
+    fichier_.swap(matrice.fichier_);
+    std::swap(derniere_, matrice.derniere_);
+    std::swap(valide_, matrice.valide_);
+}
+
+template<typename T>
+inline size_t MatriceTuilee<T>::getHeight() const
+{
+    return height_;
+}
+
+template<typename T>
+inline size_t MatriceTuilee<T>::getWidth() const
+{
+    return width_;
+}
+
+/**
+ * @brief retourne le cote des tuiles, en elements
+ */
+template<typename T>
+inline size_t MatriceTuilee<T>::getCoteTuile() const
+{
+    return tuilee::COTE;
+}
+
+template<typename T>
+inline size_t MatriceTuilee<T>::getBudget() const
+{
+    return budget_;
+}
+
+/**
+ * @brief retourne false si une lecture ou une ecriture du fichier temporaire
+ * a echoue depuis la creation de la matrice
+ */
+template<typename T>
+inline bool MatriceTuilee<T>::estValide() const
+{
+    return valide_;
+}
+
+/**
+ * @brief identifiant de la tuile qui contient la position (posY, posX) ; il ne
+ * depend pas des dimensions, qui peuvent changer sans deplacer les tuiles
+ */
+template<typename T>
+inline size_t MatriceTuilee<T>::calculerCle(size_t posY, size_t posX)
+{
+    return (posY / tuilee::COTE) << 32 | posX / tuilee::COTE;
+}
+
+/**
+ * @brief nombre de tuiles que le budget permet de garder en memoire
+ */
+template<typename T>
+inline size_t MatriceTuilee<T>::capacite() const
+{
+    return std::max(tuilee::TUILES_MINIMUM, budget_ / (tuilee::COTE * tuilee::COTE * sizeof(T)));
+}
+
+/**
+ * @brief retourne les elements de la tuile qui contient (posY, posX), apres
+ * l'avoir amenee en memoire au besoin
+ * @param ecriture, vrai si l'appelant va modifier la tuile ; sinon une tuile
+ * jamais ecrite n'est pas creee
+ * @return nul si la tuile n'existe pas et que ecriture est faux
+ */
+template<typename T>
+T* MatriceTuilee<T>::trouverTuile(size_t posY, size_t posX, bool ecriture) const
+{
+    size_t cle = calculerCle(posY, posX);
+    if (derniere_ == nullptr || derniere_->cle != cle)
+    {
+        auto resident = index_.find(cle);
+        if (resident != index_.end())
+            residentes_.splice(residentes_.begin(), residentes_, resident->second);
+        else
+        {
+            auto emplacement = emplacements_.find(cle);
+            if (emplacement == emplacements_.end() && !ecriture)
+                return nullptr;
+
+            // Le tampon de la tuile la moins recente est reutilise s'il faut l'evincer
+            if (residentes_.size() < capacite())
+                residentes_.push_front({cle, false, std::vector<T>(tuilee::COTE * tuilee::COTE)});
+            else
+            {
+                Tuile& ancienne = residentes_.back();
+                ecrireTuile(ancienne);
+                index_.erase(ancienne.cle);
+                residentes_.splice(residentes_.begin(), residentes_, std::prev(residentes_.end()));
+                residentes_.front().cle = cle;
+            }
+
+            Tuile& tuile = residentes_.front();
+            if (emplacement == emplacements_.end())
+                std::fill(tuile.elements.begin(), tuile.elements.end(), T());
+            else if (!fichier_->lire(emplacement->second, tuile.elements.data()))
+            {
+                valide_ = false;
+                std::fill(tuile.elements.begin(), tuile.elements.end(), T());
+            }
+            index_[cle] = residentes_.begin();
+        }
+        derniere_ = &residentes_.front();
+    }
+
+    derniere_->modifiee |= ecriture;
+    return derniere_->elements.data();
+}
+
+/**
+ * @brief depose une tuile modifiee dans le fichier temporaire, a son
+ * emplacement s'il existe deja
+ */
+template<typename T>
+void MatriceTuilee<T>::ecrireTuile(Tuile& tuile) const
+{
+    if (!tuile.modifiee)
+        return;
+
+    if (!fichier_)
+        fichier_ = std::make_unique<FichierTuiles>(tuilee::COTE * tuilee::COTE * sizeof(T));
+
+    auto emplacement = emplacements_.find(tuile.cle);
+    if (emplacement == emplacements_.end())
+        emplacement = emplacements_.emplace(tuile.cle, fichier_->allouer()).first;
+    valide_ &= fichier_->ecrire(emplacement->second, tuile.elements.data());
+    tuile.modifiee = false;
+}
+
+/**
+ * @brief retire du cache la tuile la moins recemment utilisee
+ */
+template<typename T>
+void MatriceTuilee<T>::evincer() const
+{
+    Tuile& ancienne = residentes_.back();
+    ecrireTuile(ancienne);
+    if (derniere_ == &ancienne)
+        derniere_ = nullptr;
+    index_.erase(ancienne.cle);
+    residentes_.pop_back();
+}
+
+template<typename T>
+inline T MatriceTuilee<T>::operator()(const size_t& posY, const size_t& posX) const
+{
+    if (posY >= height_ || posX >= width_)
+        return T();
+
+    const T* tuile = trouverTuile(posY, posX, false);
+    if (tuile == nullptr)
+        return T();
+
+    return tuile[posY % tuilee::COTE * tuilee::COTE + posX % tuilee::COTE];
+}
+
+template<typename T>
+inline bool MatriceTuilee<T>::ajouterElement(T element, const size_t& posY, const size_t& posX)
+{
+    if (posY >= height_ || posX >= width_)
+        return false;
+
+    trouverTuile(posY, posX, true)[posY % tuilee::COTE * tuilee::COTE + posX % tuilee::COTE] =
+        element;
+    return true;
+}
+
+/**
+ * @brief copie la ligne posY dans ligne, tuile par tuile
+ * @param ligne, recoit getWidth() elements
+ */
+template<typename T>
+void MatriceTuilee<T>::lireLigne(size_t posY, T* ligne) const
+{
+    size_t debut = posY % tuilee::COTE * tuilee::COTE;
+    for (size_t x = 0; x < width_; x += tuilee::COTE)
+    {
+        size_t nombre = std::min(tuilee::COTE, width_ - x);
+        const T* tuile = trouverTuile(posY, x, false);
+        if (tuile == nullptr)
+            std::fill(ligne + x, ligne + x + nombre, T());
+        else
+            std::copy(tuile + debut, tuile + debut + nombre, ligne + x);
+    }
+}
+
+/**
+ * @brief remplace la ligne posY par les getWidth() elements de ligne
+ */
+template<typename T>
+void MatriceTuilee<T>::ecrireLigne(size_t posY, const T* ligne)
+{
+    size_t debut = posY % tuilee::COTE * tuilee::COTE;
+    for (size_t x = 0; x < width_; x += tuilee::COTE)
+        std::copy(ligne + x, ligne + std::min(x + tuilee::COTE, width_),
+                  trouverTuile(posY, x, true) + debut);
+}
+
+template<typename T>
+bool MatriceTuilee<T>::lireElement(const std::string& elementFichier, const size_t& posY,
+                                   const size_t& posX)
+{
+    T element{};
+    LectureElement<T>::lire(elementFichier.data(), elementFichier.data() + elementFichier.size(),
+                            element);
+
+    return ajouterElement(element, posY, posX);
+}
+
+/**
+ * @brief ajoute a la matrice les lignes d'un fichier texte, comme
+ * Matrice<T>::chargerDepuisFichier, mais sans garder tout le fichier en
+ * memoire : il est lu deux fois par blocs de tuilee::TAILLE_LECTURE octets
+ * @param nomFichier, le chemin du fichier
+ * @return false si le fichier est illisible ou si un element precede le premier "L"
+ */
+template<typename T>
+bool MatriceTuilee<T>::chargerDepuisFichier(const std::string& nomFichier)
+{
+    // Premier passage : les dimensions
+    size_t nouvellesLignes = 0;
+    size_t largeur = width_;
+    size_t posX = 0;
+    bool elementOrphelin = false;
+    bool lu = lecture::parcourirLignesFichier(
+        nomFichier, tuilee::TAILLE_LECTURE, [&](const char* ligne, const char* finLigne) {
+            if (finLigne - ligne == 1 && *ligne == 'L')
+            {
+                nouvellesLignes++;
+                posX = 0;
+            }
+            else
+            {
+                elementOrphelin |= nouvellesLignes == 0;
+                largeur = std::max(largeur, ++posX);
+            }
+        });
+
+    if (!lu || elementOrphelin)
+        return false;
+
+    size_t posY = height_;
+    setWidth(largeur);
+    setHeight(height_ + nouvellesLignes);
+
+    // Second passage : les elements
+    size_t ligneCourante = 0;
+    return lecture::parcourirLignesFichier(
+        nomFichier, tuilee::TAILLE_LECTURE, [&](const char* ligne, const char* finLigne) {
+            if (finLigne - ligne == 1 && *ligne == 'L')
+            {
+                ligneCourante = posY++;
+                posX = 0;
+            }
+            else
+            {
+                T element{};
+                LectureElement<T>::lire(ligne, finLigne, element);
+                ajouterElement(element, ligneCourante, posX++);
+            }
+        });
+}
+
+/**
+ * @brief ecrit la matrice dans le format texte de Matrice<T>, ligne par ligne
+ * @param nomFichier, le chemin du fichier
+ * @return false si l'ecriture a echoue ou si un element ne se relirait pas
+ * (voir Matrice<T>::sauvegarderFichierTexte)
+ */
+template<typename T>
+bool MatriceTuilee<T>::sauvegarderFichierTexte(const std::string& nomFichier) const
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    std::vector<T> ligne(width_);
+    std::string tampon;
+    tampon.reserve(ecriture::TAILLE_BLOC + 64);
+
+    for (size_t h = 0; h < height_; h++)
+    {
+        lireLigne(h, ligne.data());
+        tampon += "L\n";
+        for (const T& element : ligne)
+        {
+            if (!ecriture::ecrireLigne(element, tampon))
+            {
+                ecriture::vider(tampon, file, true);
+                return false;
+            }
+            ecriture::vider(tampon, file);
+        }
+    }
+    ecriture::vider(tampon, file, true);
+
+    return bool(file);
+}
+
+/**
+ * @brief remplace la matrice par le contenu d'un fichier binaire, lu ligne
+ * par ligne directement dans les tuiles
+ * @param nomFichier, le chemin du fichier
+ * @return false si le fichier est illisible ou ne contient pas des elements de type T
+ */
+template<typename T>
+bool MatriceTuilee<T>::chargerFichierBinaire(const std::string& nomFichier)
+{
+    std::ifstream file(nomFichier, std::ios::binary);
+    EnteteFichierBinaire entete;
+    if (!file.read(reinterpret_cast<char*>(&entete), sizeof(entete)) ||
+        !FormatBinaire<T>::accepte(entete))
+        return false;
+
+    MatriceTuilee<T> matrice(size_t(entete.height), size_t(entete.width), budget_);
+    std::vector<T> ligne(matrice.width_);
+    for (size_t h = 0; h < matrice.height_; h++)
+    {
+        if (!file.read(reinterpret_cast<char*>(ligne.data()),
+                       static_cast<std::streamsize>(ligne.size() * sizeof(T))))
+            return false;
+        matrice.ecrireLigne(h, ligne.data());
+    }
+
+    echanger(matrice);
+    return true;
+}
+
+/**
+ * @brief ecrit la matrice dans le format binaire de FichierBinaire.h
+ * @param nomFichier, le chemin du fichier
+ * @return false si l'ecriture a echoue
+ */
+template<typename T>
+bool MatriceTuilee<T>::sauvegarderFichierBinaire(const std::string& nomFichier) const
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    EnteteFichierBinaire entete = FormatBinaire<T>::creerEntete(height_, width_);
+    std::vector<T> ligne(width_);
+
+    file.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    for (size_t h = 0; h < height_; h++)
+    {
+        lireLigne(h, ligne.data());
+        file.write(reinterpret_cast<const char*>(ligne.data()),
+                   static_cast<std::streamsize>(ligne.size() * sizeof(T)));
+    }
+
+    return bool(file);
+}
+
+template<typename T>
+std::unique_ptr<MatriceTuilee<T>> MatriceTuilee<T>::clone() const
+{
+    return std::make_unique<MatriceTuilee<T>>(*this);
+}
+
+/**
+ * @brief remet a T() les elements hors de la zone height x width : les tuiles
+ * entierement dehors sont oubliees, celles a cheval sont effacees en partie
+ */
+template<typename T>
+void MatriceTuilee<T>::effacerHorsLimites(size_t height, size_t width)
+{
+    // Les cles sont relevees d'abord : effacer une tuile peut en evincer une autre
+    std::vector<size_t> cles;
+    for (const auto& [cle, resident] : index_)
+        cles.push_back(cle);
+    for (const auto& [cle, emplacement] : emplacements_)
+        if (index_.count(cle) == 0)
+            cles.push_back(cle);
+
+    for (size_t cle : cles)
+    {
+        size_t debutY = (cle >> 32) * tuilee::COTE;
+        size_t debutX = (cle & 0xFFFFFFFF) * tuilee::COTE;
+        if (debutY >= height || debutX >= width)
+        {
+            auto resident = index_.find(cle);
+            if (resident != index_.end())
+            {
+                if (derniere_ == &*resident->second)
+                    derniere_ = nullptr;
+                residentes_.erase(resident->second);
+                index_.erase(resident);
+            }
+            auto emplacement = emplacements_.find(cle);
+            if (emplacement != emplacements_.end())
+            {
+                fichier_->liberer(emplacement->second);
+                emplacements_.erase(emplacement);
+            }
+        }
+        else if (debutY + tuilee::COTE > height || debutX + tuilee::COTE > width)
+        {
+            T* tuile = trouverTuile(debutY, debutX, true);
+            for (size_t y = 0; y < tuilee::COTE; ++y)
+            {
+                size_t debut = debutY + y < height ? std::min(tuilee::COTE, width - debutX) : 0;
+                std::fill(tuile + y * tuilee::COTE + debut, tuile + (y + 1) * tuilee::COTE, T());
+            }
+        }
+    }
+}
+
+template<typename T>
+void MatriceTuilee<T>::setHeight(size_t height)
+{
+    if (height < height_)
+        effacerHorsLimites(height, width_);
+    height_ = height;
+}
+
+template<typename T>
+void MatriceTuilee<T>::setWidth(size_t width)
+{
+    if (width < width_)
+        effacerHorsLimites(height_, width);
+    width_ = width;
+}
+
+/**
+ * @brief change la memoire accordee aux tuiles en cache ; les tuiles en trop
+ * sont deposees dans le fichier temporaire
+ * @param budget, en octets ; au moins tuilee::TUILES_MINIMUM tuiles sont gardees
+ */
+template<typename T>
+void MatriceTuilee<T>::setBudget(size_t budget)
+{
+    budget_ = budget;
+    while (residentes_.size() > capacite())
+        evincer();
+}
+
+#endif
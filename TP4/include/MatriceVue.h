@@ -0,0 +1,331 @@
+/*
+ * Titre : MatriceVue.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef MATRICE_VUE_H
+#define MATRICE_VUE_H
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "def.h"
+
+/**
+ * @brief definition de la classe MatriceVue
+ *
+ * Region rectangulaire d'une autre matrice contigue (Matrice<T>, matrice de
+ * taille fixe, plan d'une MatricePlanaire ou autre vue), designee par son
+ * premier element, ses dimensions et l'espacement des lignes de la matrice
+ * d'origine. La vue ne copie ni ne possede aucun element : recadrer, decouper
+ * en tuiles ou traiter plusieurs regions en parallele ne coute aucune
+ * allocation, et tout ce qui est ecrit dans la vue est ecrit dans la matrice
+ * d'origine, qui doit lui survivre.
+ *
+ * La vue offre getLigne et getStride (voir estContigue dans def.h) : elle
+ * s'utilise avec Image et avec les transformations, qui travaillent sur
+ * place dans la region tant que ses dimensions ne changent pas (convolution,
+ * couleurs, statistiques, comparaison, demi-tour, miroirs, quart de tour
+ * d'une region carree). Une transformation qui change les dimensions (quart
+ * de tour d'une region rectangulaire, agrandissement, redimensionnement) ou
+ * qui relit toute la source (rotation d'un angle quelconque) ne peut pas
+ * ecrire son resultat dans la region : comme une Matrice sur un
+ * tampon externe, la vue recoit alors son propre tampon (reinitialiser) et
+ * estVue() devient faux. copierDepuis recopie ensuite un resultat dans une
+ * region de meme taille d'une matrice plus grande.
+ */
+template<typename T>
+class MatriceVue
+{
+public:
+    MatriceVue();
+    MatriceVue(T* origine, size_t height, size_t width, size_t stride);
+    template<class M>
+    MatriceVue(M& matrice, size_t posY, size_t posX, size_t height, size_t width);
+    MatriceVue(const MatriceVue<T>& vue);
+    MatriceVue(MatriceVue<T>&& vue) noexcept;
+    ~MatriceVue() = default;
+    MatriceVue<T>& operator=(const MatriceVue<T>& vue);
+    MatriceVue<T>& operator=(MatriceVue<T>&& vue) noexcept;
+    T operator()(const size_t& posY, const size_t& posX) const;
+    bool ajouterElement(T element, const size_t& posY, const size_t& posX);
+    template<class M>
+    bool copierDepuis(const M& source);
+    std::unique_ptr<MatriceVue<T>> clone() const;
+    void reinitialiser(size_t height, size_t width);
+    // Getters
+    size_t getHeight() const;
+    size_t getWidth() const;
+    size_t getStride() const;
+    bool estVue() const;
+    // Acces direct aux lignes de la region
+    T* getLigne(size_t posY);
+    const T* getLigne(size_t posY) const;
+    void echanger(MatriceVue<T>& vue);
+
+private:
+    // Vide tant que la vue designe une region d'une autre matrice
+    std::vector<T> elements_;
+    T* donnees_;
+    size_t height_;
+    size_t width_;
+    size_t stride_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe, la vue est vide
+ */
+template<typename T>
+inline MatriceVue<T>::MatriceVue()
+    : donnees_(nullptr)
+    , height_(0)
+    , width_(0)
+    , stride_(0)
+{
+}
+
+/**
+ * @brief constructeur sur une region en memoire
+ * @param origine, le premier element de la premiere ligne de la region
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ * @param stride, le nombre d'elements entre le debut de deux lignes, au moins width
+ */
+template<typename T>
+inline MatriceVue<T>::MatriceVue(T* origine, size_t height, size_t width, size_t stride)
+    : donnees_(origine)
+    , height_(height)
+    , width_(width)
+    , stride_(stride)
+{
+}
+
+/**
+ * @brief constructeur sur une region d'une matrice contigue d'elements T,
+ * bornee aux dimensions de la matrice
+ * @param matrice, la matrice d'origine, qui doit survivre a la vue
+ * @param posY, la premiere ligne de la region
+ * @param posX, la premiere colonne de la region
+ * @param height, le nombre de lignes voulu
+ * @param width, le nombre de colonnes voulu
+ */
+template<typename T>
+template<class M>
+MatriceVue<T>::MatriceVue(M& matrice, size_t posY, size_t posX, size_t height, size_t width)
+    : MatriceVue()
+{
+    static_assert(estContigue<M>::value && std::is_same_v<ElementDe<M>, T>,
+                  "Une vue designe une region d'une matrice contigue de memes elements");
+
+    posY = std::min(posY, matrice.getHeight());
+    posX = std::min(posX, matrice.getWidth());
+    height_ = std::min(height, matrice.getHeight() - posY);
+    width_ = std::min(width, matrice.getWidth() - posX);
+    stride_ = matrice.getStride();
+    if (height_ != 0 && width_ != 0)
+        donnees_ = matrice.getLigne(posY) + posX;
+}
+
+/**
+ * @brief constructeur par copie : la copie d'une vue designe la meme region,
+ * celle d'une vue qui possede son tampon a son propre tampon
+ */
+template<typename T>
+MatriceVue<T>::MatriceVue(const MatriceVue<T>& vue)
+    : MatriceVue(vue.donnees_, vue.height_, vue.width_, vue.stride_)
+{
+    if (!vue.estVue() && vue.donnees_ != nullptr)
+    {
+        reinitialiser(vue.height_, vue.width_);
+        for (size_t h = 0; h < height_; h++)
+            std::copy(vue.getLigne(h), vue.getLigne(h) + width_, getLigne(h));
+    }
+}
+
+/**
+ * @brief constructeur par deplacement, vue devient vide
+ */
+template<typename T>
+inline MatriceVue<T>::MatriceVue(MatriceVue<T>&& vue) noexcept
+    : MatriceVue()
+{
+    echanger(vue);
+}
+
+/**
+ * @brief operateur d'affectation par copie
+ */
+template<typename T>
+inline MatriceVue<T>& MatriceVue<T>::operator=(const MatriceVue<T>& vue)
+{
+    if (this != &vue)
+    {
+        MatriceVue<T> copie(vue);
+        echanger(copie);
+    }
+    return *this;
+}
+
+/**
+ * @brief operateur d'affectation par deplacement, vue devient vide
+ */
+template<typename T>
+inline MatriceVue<T>& MatriceVue<T>::operator=(MatriceVue<T>&& vue) noexcept
+{
+    if (this != &vue)
+    {
+        MatriceVue<T> deplacee(std::move(vue));
+        echanger(deplacee);
+    }
+    return *this;
+}
+
+/**
+ * @brief echange le contenu de deux vues sans copier leurs elements ; le
+ * tampon d'une vue qui en possede un ne change pas d'adresse
+ */
+template<typename T>
+inline void MatriceVue<T>::echanger(MatriceVue<T>& vue)
+{
+    elements_.swap(vue.elements_);
+    std::swap(donnees_, vue.donnees_);
+    std::swap(height_, vue.height_);
+    std::swap(width_, vue.width_);
+    std::swap(stride_, vue.stride_);
+}
+
+template<typename T>
+inline T MatriceVue<T>::operator()(const size_t& posY, const size_t& posX) const
+{
+    if (posY >= height_ || posX >= width_)
+        return T();
+
+    return donnees_[posY * stride_ + posX];
+}
+
+template<typename T>
+inline bool MatriceVue<T>::ajouterElement(T element, const size_t& posY, const size_t& posX)
+{
+    if (posY >= height_ || posX >= width_)
+        return false;
+
+    donnees_[posY * stride_ + posX] = element;
+    return true;
+}
+
+/**
+ * @brief recopie une matrice de memes dimensions dans la region, ligne par
+ * ligne si elle est contigue
+ * @param source, la matrice a recopier, d'elements T
+ * @return false, sans rien modifier, si les dimensions different
+ */
+template<typename T>
+template<class M>
+bool MatriceVue<T>::copierDepuis(const M& source)
+{
+    if (source.getHeight() != height_ || source.getWidth() != width_)
+        return false;
+
+    for (size_t h = 0; h < height_; h++)
+    {
+        if constexpr (estContigue<M>::value)
+            std::copy(source.getLigne(h), source.getLigne(h) + width_, getLigne(h));
+        else
+            for (size_t w = 0; w < width_; w++)
+                getLigne(h)[w] = source(h, w);
+    }
+    return true;
+}
+
+/**
+ * @brief copie les elements de la region dans une vue qui possede son tampon
+ */
+template<typename T>
+std::unique_ptr<MatriceVue<T>> MatriceVue<T>::clone() const
+{
+    auto copie = std::make_unique<MatriceVue<T>>();
+    copie->reinitialiser(height_, width_);
+    copie->copierDepuis(*this);
+    return copie;
+}
+
+/**
+ * @brief donne de nouvelles dimensions a la vue sans conserver ses elements,
+ * qui valent tous T() ensuite. La region d'origine n'est jamais modifiee :
+ * la vue passe sur son propre tampon, reutilise s'il est assez grand.
+ * @param height, le nouveau nombre de lignes
+ * @param width, le nouveau nombre de colonnes
+ */
+template<typename T>
+void MatriceVue<T>::reinitialiser(size_t height, size_t width)
+{
+    if (height * width > elements_.size())
+        elements_.assign(height * width, T());
+    else
+        std::fill(elements_.begin(), elements_.end(), T());
+    donnees_ = elements_.data();
+    height_ = height;
+    width_ = width;
+    stride_ = width;
+}
+
+/**
+ * @brief retourne le nombre de lignes de la vue
+ * @return l'attribut height_ de l'objet
+ */
+template<typename T>
+inline size_t MatriceVue<T>::getHeight() const
+{
+    return height_;
+}
+
+/**
+ * @brief retourne le nombre de colonnes de la vue
+ * @return l'attribut width_ de l'objet
+ */
+template<typename T>
+inline size_t MatriceVue<T>::getWidth() const
+{
+    return width_;
+}
+
+/**
+ * @brief retourne le nombre d'elements entre le debut de deux lignes
+ * consecutives, celui de la matrice d'origine tant que estVue()
+ * @return l'attribut stride_ de l'objet
+ */
+template<typename T>
+inline size_t MatriceVue<T>::getStride() const
+{
+    return stride_;
+}
+
+/**
+ * @brief vrai tant que la vue designe une region d'une autre matrice, faux
+ * une fois qu'elle a recu son propre tampon (voir reinitialiser)
+ */
+template<typename T>
+inline bool MatriceVue<T>::estVue() const
+{
+    return donnees_ != nullptr && donnees_ != elements_.data();
+}
+
+/**
+ * @brief retourne un pointeur vers le premier element d'une ligne de la region
+ * @param posY, la ligne voulue, doit etre inferieure a getHeight()
+ */
+template<typename T>
+inline T* MatriceVue<T>::getLigne(size_t posY)
+{
+    return donnees_ + posY * stride_;
+}
+
+template<typename T>
+inline const T* MatriceVue<T>::getLigne(size_t posY) const
+{
+    return donnees_ + posY * stride_;
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Titre : Noyau.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef NOYAU_H
+#define NOYAU_H
+
+#include <cstddef>
+#include <vector>
+#include "def.h"
+
+/**
+ * @brief noyau d'une convolution (voir ConvoluerMatrice.h)
+ *
+ * L'element destination (y, x) est decalage plus la somme des
+ * coefficients[ky * width + kx] * source(y + ky - height / 2, x + kx - width / 2) :
+ * le noyau est applique tel quel, sans etre retourne, et ses dimensions sont
+ * impaires pour qu'il soit centre. Un noyau separable (coefficients egaux a
+ * vertical[ky] * horizontal[kx]) garde aussi ses deux facteurs, ce qui permet
+ * de l'appliquer en deux passes de height + width coefficients plutot qu'en
+ * une passe de height * width.
+ */
+struct Noyau
+{
+    size_t height;
+    size_t width;
+    std::vector<float> coefficients;
+    // Facteurs d'un noyau separable, vides sinon
+    std::vector<float> vertical;
+    std::vector<float> horizontal;
+    float decalage;
+
+    bool estSeparable() const { return !vertical.empty(); }
+    bool estValide() const;
+};
+
+// Noyau quelconque, dont les facteurs sont retrouves s'il est separable
+Noyau creerNoyau(size_t height, size_t width, std::vector<float> coefficients,
+                 float decalage = 0.0f);
+Noyau creerNoyauSeparable(std::vector<float> vertical, std::vector<float> horizontal,
+                          float decalage = 0.0f);
+// Noyaux usuels
+Noyau noyauMoyenne(size_t rayon);
+Noyau noyauGaussien(float sigma);
+Noyau noyauSobelX();
+Noyau noyauSobelY();
+Noyau noyauNettete(float force = 1.0f);
+
+/**
+ * @brief position dans [0, taille) de l'element lu a la place de position,
+ * qui peut etre hors de l'image, selon le traitement des bords ; taille si
+ * l'element est nul (Bord::Zero)
+ */
+size_t appliquerBord(std::ptrdiff_t position, size_t taille, Bord bord);
+
+#endif
@@ -0,0 +1,320 @@
+/*
+ * Titre : PipelineTransformations.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef PIPELINE_TRANSFORMATIONS_H
+#define PIPELINE_TRANSFORMATIONS_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "AgrandirLigne.h"
+#include "DoubleTampon.h"
+#include "PivoterMatrice.h"
+#include "PolitiqueExecution.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe PipelineTransformations
+ *
+ * Accumule des pivotements, des miroirs et des agrandissements entiers sans
+ * toucher a la matrice, puis les applique en une seule passe sur la
+ * destination. Un agrandissement au plus proche voisin commute avec les
+ * pivotements et les miroirs : la suite d'operations se ramene donc a un
+ * transformation affine (une permutation signee des axes) suivie d'un
+ * agrandissement de rapport total. Chaque element source n'est lu qu'une fois
+ * et la destination est ecrite ligne par ligne, sans matrice intermediaire.
+ */
+template<class M>
+class PipelineTransformations
+{
+public:
+    PipelineTransformations();
+    PipelineTransformations(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~PipelineTransformations() = default;
+    void ajouterPivotement(Direction direction);
+    void ajouterAgrandissement(unsigned int rapport);
+    bool estVide() const;
+    void materialiser();
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+    void setDoubleTampon(const DoubleTampon<M>& tampon);
+
+private:
+    // Coordonnees source du point (Y, X) de la matrice transformee :
+    // y = yy * Y + yx * X + y0, x = xy * Y + xx * X + x0
+    struct Correspondance
+    {
+        long yy, yx, y0;
+        long xy, xx, x0;
+    };
+
+    static Correspondance inverser(Direction direction, long height, long width);
+    static Correspondance composer(const Correspondance& premiere, const Correspondance& seconde);
+    using Element = ElementDe<M>;
+
+    void appliquerEnUnePasse();
+    void remplirParLignes(const M& source, const Correspondance& correspondance, size_t height,
+                          size_t width);
+    void remplirElementParElement(const M& source, const Correspondance& correspondance,
+                                  size_t height, size_t width);
+
+    M* matrice_;
+    PolitiqueExecution politique_;
+    std::vector<Direction> pivotements_;
+    size_t rapport_;
+    DoubleTampon<M> tampon_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline PipelineTransformations<M>::PipelineTransformations()
+    : matrice_(nullptr)
+    , rapport_(1)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ */
+template<class M>
+inline PipelineTransformations<M>::PipelineTransformations(M* matrice,
+                                                           PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+    , rapport_(1)
+{
+}
+
+/**
+ * @brief change la facon dont la materialisation repartit son travail
+ */
+template<class M>
+inline void PipelineTransformations<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief partage le tampon des operations avec d'autres transformations
+ */
+template<class M>
+inline void PipelineTransformations<M>::setDoubleTampon(const DoubleTampon<M>& tampon)
+{
+    tampon_ = tampon;
+}
+
+/**
+ * @brief met un pivotement ou un miroir en attente
+ */
+template<class M>
+inline void PipelineTransformations<M>::ajouterPivotement(Direction direction)
+{
+    pivotements_.push_back(direction);
+}
+
+/**
+ * @brief met un agrandissement au plus proche voisin en attente
+ */
+template<class M>
+inline void PipelineTransformations<M>::ajouterAgrandissement(unsigned int rapport)
+{
+    static_assert(!estFixe<M>::value, "Une matrice de taille fixe ne s'agrandit pas sur place");
+    rapport_ *= rapport;
+}
+
+/**
+ * @brief retourne vrai si aucune transformation n'est en attente
+ */
+template<class M>
+inline bool PipelineTransformations<M>::estVide() const
+{
+    return pivotements_.empty() && rapport_ == 1;
+}
+
+/**
+ * @brief correspondance qui ramene un point de la matrice transformee par
+ * direction a sa position dans la matrice height x width d'origine
+ * (inverse de PivoterMatrice::trouverDestination)
+ */
+template<class M>
+typename PipelineTransformations<M>::Correspondance
+PipelineTransformations<M>::inverser(Direction direction, long height, long width)
+{
+    switch (direction)
+    {
+    case Direction::Right:
+        return {0, -1, height - 1, 1, 0, 0};
+    case Direction::Left:
+        return {0, 1, 0, -1, 0, width - 1};
+    case Direction::UpsideDown:
+        return {-1, 0, height - 1, 0, -1, width - 1};
+    case Direction::FlipHorizontal:
+        return {1, 0, 0, 0, -1, width - 1};
+    default:
+        return {-1, 0, height - 1, 0, 1, 0};
+    }
+}
+
+/**
+ * @brief applique seconde puis premiere : le resultat donne premiere(seconde(point))
+ */
+template<class M>
+typename PipelineTransformations<M>::Correspondance
+PipelineTransformations<M>::composer(const Correspondance& premiere, const Correspondance& seconde)
+{
+    return {premiere.yy * seconde.yy + premiere.yx * seconde.xy,
+            premiere.yy * seconde.yx + premiere.yx * seconde.xx,
+            premiere.yy * seconde.y0 + premiere.yx * seconde.x0 + premiere.y0,
+            premiere.xy * seconde.yy + premiere.xx * seconde.xy,
+            premiere.xy * seconde.yx + premiere.xx * seconde.xx,
+            premiere.xy * seconde.y0 + premiere.xx * seconde.x0 + premiere.x0};
+}
+
+/**
+ * @brief applique toutes les transformations en attente en une passe
+ */
+template<class M>
+void PipelineTransformations<M>::materialiser()
+{
+    if (estVide())
+        return;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+        {
+            PipelineTransformations<PlanDe<M>> plan(&matrice_->getPlan(canal), politique_);
+            for (Direction direction : pivotements_)
+                plan.ajouterPivotement(direction);
+            plan.ajouterAgrandissement(unsigned(rapport_));
+            plan.materialiser();
+        }
+    }
+    else if constexpr (estFixe<M>::value)
+    {
+        // Les dimensions ne changent pas : chaque pivotement est remplace par
+        // la pivotee calculee a la compilation (voir PivoterMatrice)
+        PivoterMatrice<M> pivotement(matrice_, politique_);
+        for (Direction direction : pivotements_)
+            pivotement.pivoterMatrice(direction);
+    }
+    else
+        appliquerEnUnePasse();
+
+    pivotements_.clear();
+    rapport_ = 1;
+}
+
+/**
+ * @brief ramene la suite de transformations a une correspondance, puis
+ * remplit la destination en une passe
+ */
+template<class M>
+void PipelineTransformations<M>::appliquerEnUnePasse()
+{
+    // L'agrandissement commute avec les pivotements : la correspondance se
+    // calcule a la resolution source et l'agrandissement se fait en dernier
+    long height = long(matrice_->getHeight());
+    long width = long(matrice_->getWidth());
+    Correspondance correspondance = {1, 0, 0, 0, 1, 0};
+    for (Direction direction : pivotements_)
+    {
+        correspondance = composer(correspondance, inverser(direction, height, width));
+        if (direction == Direction::Right || direction == Direction::Left)
+            std::swap(height, width);
+    }
+
+    if constexpr (estContigue<M>::value)
+        remplirParLignes(tampon_.prendreSource(*matrice_), correspondance, size_t(height),
+                         size_t(width));
+    else
+        remplirElementParElement(*matrice_->clone(), correspondance, size_t(height),
+                                 size_t(width));
+}
+
+/**
+ * @brief matrice contigue : chaque bande de TAILLE_TUILE lignes transformees
+ * est lue tuile par tuile dans source, puis chacune de ses lignes est agrandie
+ * une fois (agrandirLigne) et recopiee dans les rapport - 1 lignes suivantes
+ * @param height, width, les dimensions transformees, avant agrandissement
+ */
+template<class M>
+void PipelineTransformations<M>::remplirParLignes(const M& source,
+                                                  const Correspondance& correspondance,
+                                                  size_t height, size_t width)
+{
+    size_t rapport = rapport_;
+    size_t largeur = width * rapport;
+    matrice_->reinitialiser(height * rapport, largeur);
+
+    size_t nombreTuiles = (height + TAILLE_TUILE - 1) / TAILLE_TUILE;
+    politique_.executerParBandes(nombreTuiles, [&](size_t debut, size_t fin) {
+        std::vector<Element> bande(TAILLE_TUILE * width);
+        for (size_t tuileY = debut * TAILLE_TUILE; tuileY < std::min(fin * TAILLE_TUILE, height);
+             tuileY += TAILLE_TUILE)
+        {
+            size_t finY = std::min(tuileY + TAILLE_TUILE, height);
+            for (size_t tuileX = 0; tuileX < width; tuileX += TAILLE_TUILE)
+            {
+                size_t finX = std::min(tuileX + TAILLE_TUILE, width);
+                for (size_t y = tuileY; y < finY; ++y)
+                {
+                    long ligne = correspondance.yy * long(y) + correspondance.yx * long(tuileX) +
+                                 correspondance.y0;
+                    long colonne = correspondance.xy * long(y) +
+                                   correspondance.xx * long(tuileX) + correspondance.x0;
+                    Element* sortie = &bande[(y - tuileY) * width];
+                    for (size_t x = tuileX; x < finX; ++x)
+                    {
+                        sortie[x] = source.getLigne(size_t(ligne))[colonne];
+                        ligne += correspondance.yx;
+                        colonne += correspondance.xx;
+                    }
+                }
+            }
+
+            for (size_t y = tuileY; y < finY; ++y)
+            {
+                const Element* transformee = &bande[(y - tuileY) * width];
+                Element* premiereLigne = matrice_->getLigne(y * rapport);
+                if (rapport == 1)
+                    std::copy(transformee, transformee + width, premiereLigne);
+                else
+                    agrandirLigne(transformee, width, unsigned(rapport), premiereLigne);
+                for (size_t i = 1; i < rapport; ++i)
+                    std::copy(premiereLigne, premiereLigne + largeur,
+                              matrice_->getLigne(y * rapport + i));
+            }
+        }
+    });
+}
+
+/**
+ * @brief version pour les matrices sans acces contigu : chaque element
+ * destination est lu dans source avec operator() et ecrit avec ajouterElement,
+ * dans l'ordre de parcourirPositions
+ */
+template<class M>
+void PipelineTransformations<M>::remplirElementParElement(const M& source,
+                                                          const Correspondance& correspondance,
+                                                          size_t height, size_t width)
+{
+    matrice_->setHeight(height * rapport_);
+    matrice_->setWidth(width * rapport_);
+
+    parcourirPositions(*matrice_, height * rapport_, width * rapport_, [&](size_t y, size_t x) {
+        long yTransforme = long(y / rapport_);
+        long xTransforme = long(x / rapport_);
+        size_t ligne = size_t(correspondance.yy * yTransforme + correspondance.yx * xTransforme +
+                              correspondance.y0);
+        size_t colonne = size_t(correspondance.xy * yTransforme +
+                                correspondance.xx * xTransforme + correspondance.x0);
+        matrice_->ajouterElement(source(ligne, colonne), y, x);
+    });
+}
+
+#endif
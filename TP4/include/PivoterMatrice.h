@@ -7,10 +7,45 @@
 #ifndef PIVOTER_MATRICE_H
 #define PIVOTER_MATRICE_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include "CanauxElement.h"
+#include "DoubleTampon.h"
+#include "Pixel.h"
+#include "PolitiqueExecution.h"
 #include "def.h"
 
+namespace
+{
+    // Cote des tuiles parcourues par les pivotements : une tuile source et une
+    // tuile destination tiennent ensemble dans le cache L1
+    static constexpr size_t TAILLE_TUILE = 64;
+    // Bits de la partie fractionnaire des coordonnees sources d'une rotation :
+    // l'erreur des pas arrondis reste sous 1e-4 element sur 100000 colonnes
+    static constexpr int BITS_FRACTION = 32;
+    static constexpr double PI = 3.14159265358979323846;
+}
+
 /**
  * @brief definition de la classe PivoterMatrice
+ *
+ * Les quarts de tour d'une matrice carree, le demi-tour et les miroirs se font
+ * sur place (transposition par tuiles puis inversion des lignes ou des
+ * colonnes). Un quart de tour d'une matrice rectangulaire echange la hauteur
+ * et la largeur et copie la matrice tuile par tuile. Le travail est reparti
+ * par bandes de lignes (ou de tuiles) selon la politique d'execution. Les
+ * plans d'une matrice planaire sont pivotes l'un apres l'autre. Une matrice
+ * de taille fixe est remplacee par sa pivotee, calculee a la compilation, si
+ * ses dimensions le permettent.
+ *
+ * pivoterAngle tourne la matrice d'un angle quelconque autour de son centre.
+ * Chaque element destination va chercher sa position dans la source : au
+ * lieu d'un sinus et d'un cosinus par element, la position source avance
+ * d'un pas constant, en virgule fixe, d'une colonne a l'autre et d'une ligne
+ * a l'autre. Les bandes de lignes destination sont independantes.
  */
 template<class M>
 class PivoterMatrice
@@ -18,15 +53,56 @@ class PivoterMatrice
 public:
     // Constructeurs
     PivoterMatrice();
-    PivoterMatrice(M* matrice);
+    PivoterMatrice(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
     // Destructeur
     ~PivoterMatrice() = default;
-    void pivoterMatrice(Direction direction);
+    bool pivoterMatrice(Direction direction);
+    bool pivoterAngle(double degres, Filtre filtre = Filtre::Bilinear,
+                      Cadre cadre = Cadre::Englober, ElementDe<M> fond = ElementDe<M>());
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+    void setDoubleTampon(const DoubleTampon<M>& tampon);
+    static constexpr Coordonnees trouverDestination(Direction direction, size_t posY,
+                                                    size_t posX, size_t height, size_t width);
+    static constexpr Direction trouverInverse(Direction direction);
 
 private:
-    Coordonnees changerCoordonneesCentreMatrice(Coordonnees coords) const;
-    Coordonnees recupererCoordonnees(Coordonnees coords) const;
+    using Element = ElementDe<M>;
+
+    // Position source de l'element destination (0, 0) et ses pas d'une colonne
+    // et d'une ligne destination, en virgule fixe de BITS_FRACTION bits
+    struct Rotation
+    {
+        int64_t departX;
+        int64_t departY;
+        int64_t colonneX;
+        int64_t colonneY;
+        int64_t ligneX;
+        int64_t ligneY;
+    };
+
+    static Rotation preparerRotation(double degres, size_t height, size_t width,
+                                     size_t hauteurDestination, size_t largeurDestination);
+    static void echantillonner(const M& source, int64_t sourceX, int64_t sourceY,
+                               bool bilineaire, const Element& fond, Element& destination);
+    static void interpoler(const M& source, int64_t sourceX, int64_t sourceY,
+                           Element& destination);
+    static void interpolerLigne(const M& source, const Rotation& rotation, int64_t sourceX,
+                                int64_t sourceY, const Element& fond, Element* ligne,
+                                size_t largeur);
+    // Elements faits d'octets (Pixel, plans) : interpoles en entiers, sans float
+    static constexpr bool sontDesOctets =
+        std::is_same_v<Element, Pixel> || std::is_same_v<Element, uint8_t>;
+    void transposerSurPlace();
+    void inverserColonnes();
+    void inverserLignes();
+    void pivoterTuiles(const M& source, Direction direction);
+    void pivoterElementParElement(Direction direction);
+    bool pivoterFixe(Direction direction);
+    template<Direction D>
+    bool remplacerParPivotee();
     M* matrice_;
+    PolitiqueExecution politique_;
+    DoubleTampon<M> tampon_;
 };
 
 /**
@@ -34,6 +110,7 @@ private:
  */
 template<class M>
 inline PivoterMatrice<M>::PivoterMatrice()
+    : matrice_(nullptr)
 {
 }
 
@@ -41,65 +118,545 @@ inline PivoterMatrice<M>::PivoterMatrice()
  * @brief constructeur par paramètre de la classe
  */
 template<class M>
-inline PivoterMatrice<M>::PivoterMatrice(M* matrice)
+inline PivoterMatrice<M>::PivoterMatrice(M* matrice, PolitiqueExecution politique)
     : matrice_(matrice)
+    , politique_(std::move(politique))
 {
 }
 
 /**
- * @brief trouver les coordonnées du point par rapport au centre de la matrice
- * @param coords les coordonnées du point originales
- * @return coordonnees changees du point par rapport au centre de la matrice
+ * @brief change la facon dont les pivotements repartissent leur travail
  */
 template<class M>
-inline Coordonnees PivoterMatrice<M>::changerCoordonneesCentreMatrice(Coordonnees coords) const
+inline void PivoterMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
 {
-    return {(int)(coords.x - matrice_->getWidth() / 2),
-            (int)(coords.y - matrice_->getHeight() / 2)};
+    politique_ = politique;
 }
 
 /**
- * @brief revenir au système précédent, trouver les coordonnées du point par
- * rapport au premier élément de la matrice
- * @param coords les coordonnées du point originales
+ * @brief partage le tampon des operations avec d'autres transformations
  */
 template<class M>
-inline Coordonnees PivoterMatrice<M>::recupererCoordonnees(Coordonnees coords) const
+inline void PivoterMatrice<M>::setDoubleTampon(const DoubleTampon<M>& tampon)
 {
-    return {(int)(coords.x + matrice_->getWidth() / 2),
-            (int)(coords.y + matrice_->getHeight() / 2)};
+    tampon_ = tampon;
 }
 
 /**
- * @brief pivote la matrice dans une certaine direction par rapport au centre de cette derniere
- * @param direction les coordonnées du point originales
+ * @brief trouve ou va l'element (posY, posX) d'une matrice height x width
+ * @param direction, la transformation appliquee
+ * @return les coordonnees de l'element dans la matrice transformee
  */
 template<class M>
-void PivoterMatrice<M>::pivoterMatrice(Direction direction)
+constexpr Coordonnees PivoterMatrice<M>::trouverDestination(Direction direction, size_t posY,
+                                                           size_t posX, size_t height,
+                                                           size_t width)
 {
-    std::unique_ptr<M> matriceCopie = matrice_->clone();
+    switch (direction)
+    {
+    case Direction::Right:
+        return {int(height - 1 - posY), int(posX)};
+    case Direction::Left:
+        return {int(posY), int(width - 1 - posX)};
+    case Direction::UpsideDown:
+        return {int(width - 1 - posX), int(height - 1 - posY)};
+    case Direction::FlipHorizontal:
+        return {int(width - 1 - posX), int(posY)};
+    default:
+        return {int(posX), int(height - 1 - posY)};
+    }
+}
+
+/**
+ * @brief retourne la transformation qui annule direction : le quart de tour
+ * dans l'autre sens, ou la meme pour le demi-tour et les miroirs
+ */
+template<class M>
+constexpr Direction PivoterMatrice<M>::trouverInverse(Direction direction)
+{
+    switch (direction)
+    {
+    case Direction::Right:
+        return Direction::Left;
+    case Direction::Left:
+        return Direction::Right;
+    default:
+        return direction;
+    }
+}
+
+/**
+ * @brief pivote ou retourne la matrice par rapport a son centre
+ * @param direction la transformation a appliquer
+ * @return false, sans rien modifier, pour un quart de tour d'une matrice de
+ * taille fixe rectangulaire, qui ne peut pas echanger ses dimensions
+ */
+template<class M>
+bool PivoterMatrice<M>::pivoterMatrice(Direction direction)
+{
+    bool quartDeTour = direction == Direction::Right || direction == Direction::Left;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            PivoterMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .pivoterMatrice(direction);
+    }
+    else if constexpr (estFixe<M>::value)
+        return pivoterFixe(direction);
+    else if constexpr (estContigue<M>::value)
+    {
+        if (quartDeTour && matrice_->getHeight() != matrice_->getWidth())
+        {
+            pivoterTuiles(tampon_.prendreSource(*matrice_), direction);
+            return true;
+        }
+
+        if (quartDeTour)
+            transposerSurPlace();
+        if (direction == Direction::Right || direction == Direction::UpsideDown ||
+            direction == Direction::FlipHorizontal)
+            inverserColonnes();
+        if (direction == Direction::Left || direction == Direction::UpsideDown ||
+            direction == Direction::FlipVertical)
+            inverserLignes();
+    }
+    else
+        pivoterElementParElement(direction);
+    return true;
+}
+
+/**
+ * @brief tourne la matrice autour de son centre, dans le sens horaire pour un
+ * angle positif comme Direction::Right. Un multiple de 90 degres passe par
+ * pivoterMatrice, sans reechantillonnage, si le cadre le permet.
+ * @param degres, l'angle de rotation
+ * @param filtre, NearestNeighbour ou Bilinear (Box est traite comme Bilinear) ;
+ * des elements sans canaux (voir CanauxElement.h) sont toujours copies du plus
+ * proche voisin
+ * @param cadre, Englober agrandit la matrice a la boite de l'image pivotee,
+ * Conserver garde ses dimensions
+ * @param fond, la valeur des elements destination hors de l'image pivotee
+ * @return false, sans rien modifier, pour une matrice de taille fixe qui
+ * devrait changer de dimensions ou etre reechantillonnee
+ */
+template<class M>
+bool PivoterMatrice<M>::pivoterAngle(double degres, Filtre filtre, Cadre cadre, ElementDe<M> fond)
+{
+    size_t height = matrice_->getHeight();
+    size_t width = matrice_->getWidth();
+    if (std::fmod(degres, 90.0) == 0.0)
+    {
+        int quart = (int(std::fmod(degres, 360.0) / 90.0) + 4) % 4;
+        if (quart == 0)
+            return true;
+        if (quart == 2)
+            return pivoterMatrice(Direction::UpsideDown);
+        if (cadre == Cadre::Englober || height == width)
+            return pivoterMatrice(quart == 1 ? Direction::Right : Direction::Left);
+    }
+
+    if constexpr (estFixe<M>::value)
+        return false;
+    else if constexpr (estPlanaire<M>::value)
+    {
+        // Chaque plan recoit la composante du fond qui lui correspond
+        float canaux[CanauxElement<Element>::nombre];
+        CanauxElement<Element>::lire(fond, canaux);
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            PivoterMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .pivoterAngle(degres, filtre, cadre,
+                              CanauxElement<ElementDe<PlanDe<M>>>::ecrire(&canaux[canal]));
+        return true;
+    }
+    else
+    {
+        size_t hauteurDestination = height;
+        size_t largeurDestination = width;
+        if (cadre == Cadre::Englober)
+        {
+            // La tolerance garde les dimensions exactes malgre l'arrondi de cos et sin
+            double cosinus = std::abs(std::cos(degres * PI / 180.0));
+            double sinus = std::abs(std::sin(degres * PI / 180.0));
+            hauteurDestination =
+                size_t(std::ceil(sinus * double(width) + cosinus * double(height) - 1e-6));
+            largeurDestination =
+                size_t(std::ceil(cosinus * double(width) + sinus * double(height) - 1e-6));
+        }
+        Rotation rotation =
+            preparerRotation(degres, height, width, hauteurDestination, largeurDestination);
+        bool bilineaire = filtre != Filtre::NearestNeighbour;
+
+        if constexpr (estContigue<M>::value)
+        {
+            const M& source = tampon_.prendreSource(*matrice_);
+            matrice_->reinitialiser(hauteurDestination, largeurDestination);
+            politique_.executerParBandes(hauteurDestination, [&](size_t debut, size_t fin) {
+                for (size_t y = debut; y < fin; ++y)
+                {
+                    int64_t sourceX = rotation.departX + int64_t(y) * rotation.ligneX;
+                    int64_t sourceY = rotation.departY + int64_t(y) * rotation.ligneY;
+                    Element* ligne = matrice_->getLigne(y);
+                    if constexpr (sontDesOctets)
+                    {
+                        if (bilineaire)
+                        {
+                            interpolerLigne(source, rotation, sourceX, sourceY, fond, ligne,
+                                            largeurDestination);
+                            continue;
+                        }
+                    }
+                    for (size_t x = 0; x < largeurDestination; ++x)
+                    {
+                        echantillonner(source, sourceX, sourceY, bilineaire, fond, ligne[x]);
+                        sourceX += rotation.colonneX;
+                        sourceY += rotation.colonneY;
+                    }
+                }
+            });
+        }
+        else
+        {
+            std::unique_ptr<M> copie = matrice_->clone();
+            matrice_->setHeight(hauteurDestination);
+            matrice_->setWidth(largeurDestination);
+            parcourirPositions(*matrice_, hauteurDestination, largeurDestination,
+                               [&](size_t y, size_t x) {
+                                   int64_t sourceX = rotation.departX +
+                                                     int64_t(y) * rotation.ligneX +
+                                                     int64_t(x) * rotation.colonneX;
+                                   int64_t sourceY = rotation.departY +
+                                                     int64_t(y) * rotation.ligneY +
+                                                     int64_t(x) * rotation.colonneY;
+                                   Element element = fond;
+                                   echantillonner(*copie, sourceX, sourceY, bilineaire, fond,
+                                                  element);
+                                   matrice_->ajouterElement(element, y, x);
+                               });
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief position source de la destination (0, 0) et pas de la rotation ; un
+ * element est centre sur ses indices, les deux matrices sur leur milieu
+ */
+template<class M>
+typename PivoterMatrice<M>::Rotation
+PivoterMatrice<M>::preparerRotation(double degres, size_t height, size_t width,
+                                    size_t hauteurDestination, size_t largeurDestination)
+{
+    const double un = double(int64_t(1) << BITS_FRACTION);
+    double cosinus = std::cos(degres * PI / 180.0);
+    double sinus = std::sin(degres * PI / 180.0);
+
+    // Rotation inverse du centre de la destination (0, 0) vers la source
+    double dx = 0.5 - double(largeurDestination) / 2.0;
+    double dy = 0.5 - double(hauteurDestination) / 2.0;
+    double departX = double(width) / 2.0 + cosinus * dx + sinus * dy - 0.5;
+    double departY = double(height) / 2.0 - sinus * dx + cosinus * dy - 0.5;
+    return {std::llround(departX * un), std::llround(departY * un),
+            std::llround(cosinus * un), std::llround(-sinus * un),
+            std::llround(sinus * un),   std::llround(cosinus * un)};
+}
+
+/**
+ * @brief ecrit dans destination l'element dont la position source est
+ * (sourceX, sourceY), ou fond si l'element source le plus proche est hors de
+ * la matrice
+ */
+template<class M>
+inline void PivoterMatrice<M>::echantillonner(const M& source, int64_t sourceX, int64_t sourceY,
+                                              bool bilineaire, const Element& fond,
+                                              Element& destination)
+{
+    // Une position negative devient un tres grand size_t, hors de la matrice
+    const int64_t demi = int64_t(1) << (BITS_FRACTION - 1);
+    size_t x = size_t((sourceX + demi) >> BITS_FRACTION);
+    size_t y = size_t((sourceY + demi) >> BITS_FRACTION);
+    if (x >= source.getWidth() || y >= source.getHeight())
+    {
+        destination = fond;
+        return;
+    }
+
+    if constexpr (aDesCanaux<Element>::value)
+    {
+        if (bilineaire)
+        {
+            interpoler(source, sourceX, sourceY, destination);
+            return;
+        }
+    }
+    if constexpr (estContigue<M>::value)
+        destination = source.getLigne(y)[x];
+    else
+        destination = source(y, x);
+}
+
+/**
+ * @brief interpolation bilineaire, sur leurs canaux en float, des quatre
+ * elements sources qui entourent (sourceX, sourceY), ceux du bord etant repetes
+ */
+template<class M>
+inline void PivoterMatrice<M>::interpoler(const M& source, int64_t sourceX, int64_t sourceY,
+                                          Element& destination)
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    int64_t x = sourceX >> BITS_FRACTION;
+    int64_t y = sourceY >> BITS_FRACTION;
+    int64_t dernierX = int64_t(source.getWidth()) - 1;
+    int64_t dernierY = int64_t(source.getHeight()) - 1;
+    size_t gauche = size_t(std::clamp<int64_t>(x, 0, dernierX));
+    size_t droite = size_t(std::clamp<int64_t>(x + 1, 0, dernierX));
+    size_t haut = size_t(std::clamp<int64_t>(y, 0, dernierY));
+    size_t bas = size_t(std::clamp<int64_t>(y + 1, 0, dernierY));
 
-    for (unsigned int y = 0; y < matrice_->getHeight(); ++y)
+    auto lire = [&](size_t posY, size_t posX, float* valeurs) {
+        if constexpr (estContigue<M>::value)
+            CanauxElement<Element>::lire(source.getLigne(posY)[posX], valeurs);
+        else
+            CanauxElement<Element>::lire(source(posY, posX), valeurs);
+    };
+    const int64_t masque = (int64_t(1) << BITS_FRACTION) - 1;
+    const float un = float(int64_t(1) << BITS_FRACTION);
+    float fractionX = float(sourceX & masque) / un;
+    float fractionY = float(sourceY & masque) / un;
+    float coins[4][canaux];
+    lire(haut, gauche, coins[0]);
+    lire(haut, droite, coins[1]);
+    lire(bas, gauche, coins[2]);
+    lire(bas, droite, coins[3]);
+    float resultat[canaux];
+    for (size_t c = 0; c < canaux; ++c)
     {
-        for (unsigned int x = 0; x < matrice_->getWidth(); ++x)
+        float dessus = coins[0][c] + (coins[1][c] - coins[0][c]) * fractionX;
+        float dessous = coins[2][c] + (coins[3][c] - coins[2][c]) * fractionX;
+        resultat[c] = dessus + (dessous - dessus) * fractionY;
+    }
+    destination = CanauxElement<Element>::ecrire(resultat);
+}
+
+/**
+ * @brief ligne destination d'une matrice contigue d'octets (Pixel, plans),
+ * interpolee en entiers avec des poids de 8 bits : comme echantillonner et
+ * interpoler, mais avec les dimensions et le tampon source lus une seule fois
+ * et chaque element ecrit octet par octet, sans passer par un Element
+ * @param sourceX, sourceY, la position source du premier element de la ligne
+ */
+template<class M>
+void PivoterMatrice<M>::interpolerLigne(const M& source, const Rotation& rotation,
+                                        int64_t sourceX, int64_t sourceY, const Element& fond,
+                                        Element* ligne, size_t largeur)
+{
+    constexpr size_t canaux = sizeof(Element);
+    const int64_t demi = int64_t(1) << (BITS_FRACTION - 1);
+    const uint64_t width = source.getWidth();
+    const uint64_t height = source.getHeight();
+    const int64_t dernierX = int64_t(width) - 1;
+    const int64_t dernierY = int64_t(height) - 1;
+    const uint8_t* debut = reinterpret_cast<const uint8_t*>(source.getLigne(0));
+    const size_t pas = source.getStride() * canaux;
+    const int64_t colonneX = rotation.colonneX;
+    const int64_t colonneY = rotation.colonneY;
+    uint8_t* resultat = reinterpret_cast<uint8_t*>(ligne);
+
+    for (size_t w = 0; w < largeur; ++w, resultat += canaux)
+    {
+        int64_t positionX = sourceX;
+        int64_t positionY = sourceY;
+        sourceX += colonneX;
+        sourceY += colonneY;
+        if (uint64_t((positionX + demi) >> BITS_FRACTION) >= width ||
+            uint64_t((positionY + demi) >> BITS_FRACTION) >= height)
         {
-            Coordonnees coord = changerCoordonneesCentreMatrice({(int)x, (int)y});
-            int temp = coord.x;
+            ligne[w] = fond;
+            continue;
+        }
+
+        int64_t x = positionX >> BITS_FRACTION;
+        int64_t y = positionY >> BITS_FRACTION;
+        size_t gauche = size_t(std::clamp<int64_t>(x, 0, dernierX)) * canaux;
+        size_t droite = size_t(std::clamp<int64_t>(x + 1, 0, dernierX)) * canaux;
+        const uint8_t* haut = debut + size_t(std::clamp<int64_t>(y, 0, dernierY)) * pas;
+        const uint8_t* bas = debut + size_t(std::clamp<int64_t>(y + 1, 0, dernierY)) * pas;
+        uint32_t fractionX = uint32_t(positionX >> (BITS_FRACTION - 8)) & 255;
+        uint32_t fractionY = uint32_t(positionY >> (BITS_FRACTION - 8)) & 255;
+        // Calcule avant d'ecrire : une ecriture d'octets forcerait a relire la source
+        uint8_t valeurs[canaux];
+        for (size_t c = 0; c < canaux; ++c)
+        {
+            uint32_t dessus = haut[gauche + c] * (256 - fractionX) + haut[droite + c] * fractionX;
+            uint32_t dessous = bas[gauche + c] * (256 - fractionX) + bas[droite + c] * fractionX;
+            valeurs[c] = uint8_t((dessus * (256 - fractionY) + dessous * fractionY + 32768) >> 16);
+        }
+        for (size_t c = 0; c < canaux; ++c)
+            resultat[c] = valeurs[c];
+    }
+}
 
-            if (direction == Direction::Right)
+/**
+ * @brief matrice de taille fixe : choisit la pivotee calculee a la compilation
+ */
+template<class M>
+bool PivoterMatrice<M>::pivoterFixe(Direction direction)
+{
+    switch (direction)
+    {
+    case Direction::Right:
+        return remplacerParPivotee<Direction::Right>();
+    case Direction::Left:
+        return remplacerParPivotee<Direction::Left>();
+    case Direction::UpsideDown:
+        return remplacerParPivotee<Direction::UpsideDown>();
+    case Direction::FlipHorizontal:
+        return remplacerParPivotee<Direction::FlipHorizontal>();
+    default:
+        return remplacerParPivotee<Direction::FlipVertical>();
+    }
+}
+
+/**
+ * @brief remplace la matrice par sa pivotee dans la direction D, si elles ont
+ * le meme type (memes dimensions)
+ */
+template<class M>
+template<Direction D>
+bool PivoterMatrice<M>::remplacerParPivotee()
+{
+    using Pivotee = decltype(matrice_->template pivotee<D>());
+    if constexpr (std::is_same_v<Pivotee, M>)
+    {
+        *matrice_ = matrice_->template pivotee<D>();
+        return true;
+    }
+    else
+        return false;
+}
+
+/**
+ * @brief transpose une matrice carree sur place, tuile par tuile : chaque
+ * tuile au-dessus de la diagonale est echangee avec sa symetrique
+ */
+template<class M>
+void PivoterMatrice<M>::transposerSurPlace()
+{
+    size_t taille = matrice_->getHeight();
+    size_t nombreTuiles = (taille + TAILLE_TUILE - 1) / TAILLE_TUILE;
+
+    // Une rangee de tuiles n'echange que ses propres paires : les bandes sont independantes
+    politique_.executerParBandes(nombreTuiles, [&](size_t debut, size_t fin) {
+        // swap trouve par ADL celui d'un element qui en definit un (Couleur)
+        using std::swap;
+        for (size_t tuileY = debut * TAILLE_TUILE; tuileY < std::min(fin * TAILLE_TUILE, taille);
+             tuileY += TAILLE_TUILE)
+        {
+            size_t finY = std::min(tuileY + TAILLE_TUILE, taille);
+            for (size_t tuileX = tuileY; tuileX < taille; tuileX += TAILLE_TUILE)
             {
-                coord.x = 0 - coord.y;
-                coord.y = temp;
+                size_t finX = std::min(tuileX + TAILLE_TUILE, taille);
+                for (size_t y = tuileY; y < finY; ++y)
+                {
+                    auto* ligne = matrice_->getLigne(y);
+                    for (size_t x = std::max(tuileX, y + 1); x < finX; ++x)
+                        swap(ligne[x], matrice_->getLigne(x)[y]);
+                }
             }
-            else
+        }
+    });
+}
+
+/**
+ * @brief miroir gauche-droite : inverse l'ordre des elements de chaque ligne
+ */
+template<class M>
+void PivoterMatrice<M>::inverserColonnes()
+{
+    politique_.executerParBandes(matrice_->getHeight(), [&](size_t debut, size_t fin) {
+        for (size_t y = debut; y < fin; ++y)
+            std::reverse(matrice_->getLigne(y), matrice_->getLigne(y) + matrice_->getWidth());
+    });
+}
+
+/**
+ * @brief miroir haut-bas : echange les lignes symetriques
+ */
+template<class M>
+void PivoterMatrice<M>::inverserLignes()
+{
+    size_t height = matrice_->getHeight();
+
+    politique_.executerParBandes(height / 2, [&](size_t debut, size_t fin) {
+        for (size_t y = debut; y < fin; ++y)
+            std::swap_ranges(matrice_->getLigne(y), matrice_->getLigne(y) + matrice_->getWidth(),
+                             matrice_->getLigne(height - 1 - y));
+    });
+}
+
+/**
+ * @brief quart de tour d'une matrice rectangulaire : la matrice prend les
+ * dimensions inversees de source et est remplie tuile par tuile
+ * @param source la matrice avant le pivotement, echangee dans le double tampon
+ */
+template<class M>
+void PivoterMatrice<M>::pivoterTuiles(const M& source, Direction direction)
+{
+    size_t height = source.getHeight();
+    size_t width = source.getWidth();
+    matrice_->reinitialiser(width, height);
+
+    // Une colonne de tuiles source remplit une bande de lignes destination
+    size_t nombreTuiles = (width + TAILLE_TUILE - 1) / TAILLE_TUILE;
+    politique_.executerParBandes(nombreTuiles, [&](size_t debut, size_t fin) {
+        for (size_t tuileX = debut * TAILLE_TUILE; tuileX < std::min(fin * TAILLE_TUILE, width);
+             tuileX += TAILLE_TUILE)
+        {
+            size_t finX = std::min(tuileX + TAILLE_TUILE, width);
+            for (size_t tuileY = 0; tuileY < height; tuileY += TAILLE_TUILE)
             {
-                coord.x = coord.y;
-                coord.y = 0 - temp;
+                size_t finY = std::min(tuileY + TAILLE_TUILE, height);
+                for (size_t y = tuileY; y < finY; ++y)
+                {
+                    const auto* ligne = source.getLigne(y);
+                    if (direction == Direction::Right)
+                        for (size_t x = tuileX; x < finX; ++x)
+                            matrice_->getLigne(x)[height - 1 - y] = ligne[x];
+                    else
+                        for (size_t x = tuileX; x < finX; ++x)
+                            matrice_->getLigne(width - 1 - x)[y] = ligne[x];
+                }
             }
-            coord = recupererCoordonnees(coord);
-            matrice_->ajouterElement(matriceCopie->operator()(y, x), coord.y, coord.x);
         }
+    });
+}
+
+/**
+ * @brief version pour les matrices sans acces contigu : chaque element
+ * destination est lu a sa source dans une copie, avec operator(), et ecrit
+ * avec ajouterElement. La destination est parcourue avec parcourirPositions,
+ * tuile par tuile pour une matrice rangee par tuiles.
+ */
+template<class M>
+void PivoterMatrice<M>::pivoterElementParElement(Direction direction)
+{
+    std::unique_ptr<M> matriceCopie = matrice_->clone();
+    size_t height = matriceCopie->getHeight();
+    size_t width = matriceCopie->getWidth();
+
+    // La transformation inverse ramene chaque destination a sa source
+    Direction inverse = trouverInverse(direction);
+    if (direction == Direction::Right || direction == Direction::Left)
+    {
+        std::swap(height, width);
+        matrice_->setHeight(height);
+        matrice_->setWidth(width);
     }
+
+    parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+        Coordonnees coord = trouverDestination(inverse, y, x, height, width);
+        matrice_->ajouterElement(matriceCopie->operator()(size_t(coord.y), size_t(coord.x)), y, x);
+    });
 }
 
 #endif
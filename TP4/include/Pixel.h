@@ -9,6 +9,10 @@
 
 #include <iomanip>
 #include <iostream>
+#include "CanauxElement.h"
+#include "EcritureElement.h"
+#include "FichierBinaire.h"
+#include "LectureElement.h"
 
 /**
  * @brief definition de la classe Pixel
@@ -22,7 +26,7 @@ public:
     // Destructeur
     ~Pixel() = default;
     // Operateurs
-    void operator=(const Pixel& pixel);
+    Pixel& operator=(const Pixel& pixel) = default;
     // Setters
     void setRouge(int rouge);
     void setVert(int vert);
@@ -41,4 +45,59 @@ private:
 std::ostream& operator<<(std::ostream& os, Pixel pixel);
 std::istream& operator>>(std::istream& is, Pixel& pixel);
 
+/**
+ * @brief lecture d'un pixel "R G B" sans passer par un flux
+ */
+template<>
+struct LectureElement<Pixel>
+{
+    static void lire(const char* debut, const char* fin, Pixel& pixel);
+};
+
+/**
+ * @brief ecriture d'un pixel sans flux : "#RR GG BB" en hexadecimal pour
+ * l'affichage, comme l'operateur <<, et "R G B" en decimal dans un fichier
+ */
+template<>
+struct EcritureElement<Pixel>
+{
+    static void afficher(const Pixel& pixel, std::string& tampon);
+    static void ecrire(const Pixel& pixel, std::string& tampon);
+};
+
+/**
+ * @brief un pixel s'ecrit en binaire sous forme de trois octets R, G, B
+ */
+template<>
+struct FormatBinaire<Pixel> : FormatBinaireBase<Pixel, binaire::TYPE_PIXEL>
+{
+    static_assert(sizeof(Pixel) == 3, "Un Pixel doit occuper exactement trois octets");
+};
+
+/**
+ * @brief un pixel a trois canaux, rouge, vert et bleu, satures entre 0 et 255
+ */
+template<>
+struct CanauxElement<Pixel>
+{
+    static constexpr size_t nombre = 3;
+
+    static void lire(const Pixel& pixel, float* canaux)
+    {
+        canaux[0] = pixel.getRouge();
+        canaux[1] = pixel.getVert();
+        canaux[2] = pixel.getBleu();
+    }
+
+    static Pixel ecrire(const float* canaux)
+    {
+        return Pixel(saturer(canaux[0]), saturer(canaux[1]), saturer(canaux[2]));
+    }
+
+    static uint8_t saturer(float canal)
+    {
+        return canal <= 0.0f ? 0 : canal >= 255.0f ? 255 : uint8_t(canal + 0.5f);
+    }
+};
+
 #endif
@@ -0,0 +1,66 @@
+/*
+ * Titre : PolitiqueExecution.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef POLITIQUE_EXECUTION_H
+#define POLITIQUE_EXECUTION_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief definition de la classe PoolTravailleurs, des threads qui executent
+ * des taches jusqu'a la destruction du pool
+ */
+class PoolTravailleurs
+{
+public:
+    PoolTravailleurs(size_t nombreTravailleurs);
+    ~PoolTravailleurs();
+    PoolTravailleurs(const PoolTravailleurs&) = delete;
+    PoolTravailleurs& operator=(const PoolTravailleurs&) = delete;
+    void executerParBandes(size_t taille, size_t nombreBandes,
+                           const std::function<void(size_t, size_t)>& tache);
+    size_t getNombreTravailleurs() const;
+
+private:
+    void travailler();
+    bool executerUneTache(std::unique_lock<std::mutex>& verrou);
+
+    std::vector<std::thread> travailleurs_;
+    std::deque<std::function<void()>> taches_;
+    std::mutex mutex_;
+    std::condition_variable tacheDisponible_;
+    bool arret_;
+};
+
+/**
+ * @brief definition de la classe PolitiqueExecution
+ *
+ * Decide comment une transformation parcourt ses lignes : toutes dans le
+ * thread appelant (politique sequentielle, par defaut) ou par bandes de
+ * lignes reparties sur un pool de travailleurs. Chaque ligne est traitee par
+ * une seule bande, le resultat ne depend donc pas du nombre de threads. Les
+ * copies d'une politique partagent le meme pool.
+ */
+class PolitiqueExecution
+{
+public:
+    PolitiqueExecution();
+    PolitiqueExecution(size_t nombreTravailleurs);
+    void executerParBandes(size_t taille, const std::function<void(size_t, size_t)>& tache) const;
+    size_t getNombreTravailleurs() const;
+
+private:
+    std::shared_ptr<PoolTravailleurs> pool_;
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Titre : PyramideMatrice.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef PYRAMIDE_MATRICE_H
+#define PYRAMIDE_MATRICE_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "PolitiqueExecution.h"
+#include "RedimensionnerMatrice.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe PyramideMatrice
+ *
+ * Copies reduites d'une matrice (mipmap) : chaque niveau a la moitie des
+ * lignes et des colonnes du precedent, reduit avec le filtre Box, jusqu'a
+ * une seule ligne et une seule colonne. Les niveaux ne sont calcules qu'a la
+ * premiere demande. Ensemble, ils occupent au plus le tiers d'une matrice a
+ * peu pres carree ; pour une matrice allongee, les derniers niveaux d'une seule
+ * ligne ou colonne s'y ajoutent, jusqu'a sa taille entiere pour une seule ligne.
+ *
+ * copieRedimensionnee part du plus petit niveau qui couvre encore les
+ * dimensions demandees, plutot que de la pleine resolution ; une pyramide
+ * inactive (setActive) ne garde aucun niveau et part toujours de la matrice.
+ * La pyramide ne voit pas les modifications de la matrice : invalider()
+ * oublie les niveaux calcules (Image le fait a chaque transformation).
+ */
+template<class M>
+class PyramideMatrice
+{
+public:
+    PyramideMatrice();
+    PyramideMatrice(const M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~PyramideMatrice() = default;
+    const M& getNiveau(size_t niveau);
+    size_t getNombreNiveaux() const;
+    size_t choisirNiveau(size_t height, size_t width) const;
+    std::unique_ptr<M> copieRedimensionnee(size_t height, size_t width, Filtre filtre);
+    void invalider();
+    void setActive(bool active);
+    bool estActive() const;
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    std::unique_ptr<M> reduire(const M& source, size_t height, size_t width,
+                               Filtre filtre) const;
+    const M* matrice_;
+    PolitiqueExecution politique_;
+    // niveaux_[i] est le niveau i + 1 ; le niveau 0 est la matrice elle-meme
+    std::vector<std::unique_ptr<M>> niveaux_;
+    bool active_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline PyramideMatrice<M>::PyramideMatrice()
+    : matrice_(nullptr)
+    , active_(true)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe ; aucun niveau n'est calcule
+ */
+template<class M>
+inline PyramideMatrice<M>::PyramideMatrice(const M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+    , active_(true)
+{
+}
+
+/**
+ * @brief change la facon dont les reductions repartissent leur travail
+ */
+template<class M>
+inline void PyramideMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief oublie les niveaux calcules, apres une modification de la matrice
+ */
+template<class M>
+inline void PyramideMatrice<M>::invalider()
+{
+    niveaux_.clear();
+}
+
+/**
+ * @brief active ou desactive la conservation des niveaux ; desactivee, la
+ * pyramide libere ses niveaux
+ */
+template<class M>
+inline void PyramideMatrice<M>::setActive(bool active)
+{
+    if (!active)
+        invalider();
+    active_ = active;
+}
+
+/**
+ * @brief vrai si les niveaux calcules sont conserves
+ */
+template<class M>
+inline bool PyramideMatrice<M>::estActive() const
+{
+    return active_;
+}
+
+/**
+ * @brief retourne le nombre de niveaux de la pyramide, matrice comprise : le
+ * dernier n'a qu'une ligne et une colonne
+ */
+template<class M>
+size_t PyramideMatrice<M>::getNombreNiveaux() const
+{
+    size_t nombre = 1;
+    for (size_t cote = std::max(matrice_->getHeight(), matrice_->getWidth()); cote > 1;
+         cote /= 2)
+        ++nombre;
+    return nombre;
+}
+
+/**
+ * @brief choisit le plus petit niveau dont les deux dimensions couvrent
+ * encore height x width, ou la matrice elle-meme (0) pour un agrandissement
+ */
+template<class M>
+size_t PyramideMatrice<M>::choisirNiveau(size_t height, size_t width) const
+{
+    size_t niveau = 0;
+    size_t h = matrice_->getHeight();
+    size_t w = matrice_->getWidth();
+    while (niveau + 1 < getNombreNiveaux() && std::max<size_t>(h / 2, 1) >= height &&
+           std::max<size_t>(w / 2, 1) >= width)
+    {
+        h = std::max<size_t>(h / 2, 1);
+        w = std::max<size_t>(w / 2, 1);
+        ++niveau;
+    }
+    return niveau;
+}
+
+/**
+ * @brief retourne un niveau de la pyramide, calcule avec ceux qui le
+ * precedent s'il ne l'est pas encore
+ * @param niveau, de 0 (la matrice) a getNombreNiveaux() - 1
+ */
+template<class M>
+const M& PyramideMatrice<M>::getNiveau(size_t niveau)
+{
+    niveau = std::min(niveau, getNombreNiveaux() - 1);
+    while (niveaux_.size() < niveau)
+    {
+        const M& precedent = niveaux_.empty() ? *matrice_ : *niveaux_.back();
+        niveaux_.push_back(reduire(precedent, std::max<size_t>(precedent.getHeight() / 2, 1),
+                                   std::max<size_t>(precedent.getWidth() / 2, 1), Filtre::Box));
+    }
+    return niveau == 0 ? *matrice_ : *niveaux_[niveau - 1];
+}
+
+/**
+ * @brief copie de la matrice aux dimensions height x width, redimensionnee
+ * depuis le niveau que choisit choisirNiveau
+ * @param filtre, le filtre du dernier redimensionnement (voir RedimensionnerMatrice)
+ */
+template<class M>
+std::unique_ptr<M> PyramideMatrice<M>::copieRedimensionnee(size_t height, size_t width,
+                                                           Filtre filtre)
+{
+    const M& niveau = active_ ? getNiveau(choisirNiveau(height, width)) : *matrice_;
+    if (niveau.getHeight() == height && niveau.getWidth() == width)
+        return niveau.clone();
+    return reduire(niveau, height, width, filtre);
+}
+
+/**
+ * @brief nouvelle matrice, copie redimensionnee de source
+ */
+template<class M>
+std::unique_ptr<M> PyramideMatrice<M>::reduire(const M& source, size_t height, size_t width,
+                                               Filtre filtre) const
+{
+    static_assert(!estFixe<M>::value, "Une matrice de taille fixe ne peut pas etre reduite");
+    auto matrice = std::make_unique<M>();
+    RedimensionnerMatrice<M>(matrice.get(), politique_)
+        .redimensionnerDepuis(source, height, width, filtre);
+    return matrice;
+}
+
+#endif
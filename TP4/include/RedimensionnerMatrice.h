@@ -0,0 +1,317 @@
+/*
+ * Titre : RedimensionnerMatrice.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef REDIMENSIONNER_MATRICE_H
+#define REDIMENSIONNER_MATRICE_H
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "CanauxElement.h"
+#include "DoubleTampon.h"
+#include "Echantillonnage.h"
+#include "PolitiqueExecution.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe RedimensionnerMatrice
+ *
+ * Redimensionne une matrice a des dimensions quelconques, en agrandissement
+ * comme en reduction. Les filtres Box et Bilinear se font en deux passes
+ * separables sur des canaux en float : une passe horizontale par ligne
+ * source, puis une passe verticale qui combine des lignes entieres (boucle
+ * contigue que le compilateur vectorise). Les bandes de lignes destination
+ * sont reparties selon la politique d'execution ; chacune garde ses lignes
+ * sources deja redimensionnees horizontalement dans un anneau de nombreMax
+ * lignes, plutot qu'une copie intermediaire de toute la source.
+ * Les elements sans CanauxElement sont toujours copies depuis leur plus
+ * proche voisin. Les plans d'une matrice planaire sont redimensionnes un a un.
+ */
+template<class M>
+class RedimensionnerMatrice
+{
+public:
+    RedimensionnerMatrice();
+    RedimensionnerMatrice(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~RedimensionnerMatrice() = default;
+    void redimensionner(size_t height, size_t width, Filtre filtre);
+    void redimensionnerDepuis(const M& source, size_t height, size_t width, Filtre filtre);
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+    void setDoubleTampon(const DoubleTampon<M>& tampon);
+
+private:
+    using Element = ElementDe<M>;
+
+    void redimensionnerPlusProcheVoisin(const M& source, size_t height, size_t width);
+    void filtrer(const M& source, size_t height, size_t width, Filtre filtre);
+    void passeHorizontale(const M& source, const Echantillonnage& colonnes, size_t y,
+                          float* ligneSource, float* sortie) const;
+    void passeVerticale(const M& source, const Echantillonnage& lignes,
+                        const Echantillonnage& colonnes, size_t debut, size_t fin);
+    void preparerDestination(size_t height, size_t width);
+    M* matrice_;
+    PolitiqueExecution politique_;
+    DoubleTampon<M> tampon_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline RedimensionnerMatrice<M>::RedimensionnerMatrice()
+    : matrice_(nullptr)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ */
+template<class M>
+inline RedimensionnerMatrice<M>::RedimensionnerMatrice(M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+{
+}
+
+/**
+ * @brief change la facon dont les passes repartissent leur travail
+ */
+template<class M>
+inline void RedimensionnerMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief partage le tampon des operations avec d'autres transformations
+ */
+template<class M>
+inline void RedimensionnerMatrice<M>::setDoubleTampon(const DoubleTampon<M>& tampon)
+{
+    tampon_ = tampon;
+}
+
+/**
+ * @brief redimensionne la matrice
+ * @param height, le nouveau nombre de lignes
+ * @param width, le nouveau nombre de colonnes
+ * @param filtre, la facon de combiner les elements sources
+ */
+template<class M>
+void RedimensionnerMatrice<M>::redimensionner(size_t height, size_t width, Filtre filtre)
+{
+    static_assert(!estFixe<M>::value, "Une matrice de taille fixe ne peut pas etre redimensionnee");
+    if (height == matrice_->getHeight() && width == matrice_->getWidth())
+        return;
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        // Les filtres sont separables par canal : chaque plan est filtre seul
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            RedimensionnerMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .redimensionner(height, width, filtre);
+        return;
+    }
+
+    // Une matrice contigue est echangee dans le double tampon, les autres clonees
+    std::unique_ptr<M> copie;
+    const M* source = nullptr;
+    if constexpr (estContigue<M>::value)
+        source = &tampon_.prendreSource(*matrice_);
+    else
+    {
+        copie = matrice_->clone();
+        source = copie.get();
+    }
+    redimensionnerDepuis(*source, height, width, filtre);
+}
+
+/**
+ * @brief remplace la matrice par une copie redimensionnee de source, sans
+ * copier source au prealable (voir PyramideMatrice)
+ * @param source, une autre matrice que celle de la transformation
+ * @param height, le nombre de lignes de la copie
+ * @param width, le nombre de colonnes de la copie
+ * @param filtre, la facon de combiner les elements sources
+ */
+template<class M>
+void RedimensionnerMatrice<M>::redimensionnerDepuis(const M& source, size_t height, size_t width,
+                                                    Filtre filtre)
+{
+    if constexpr (estPlanaire<M>::value)
+    {
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            RedimensionnerMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                .redimensionnerDepuis(source.getPlan(canal), height, width, filtre);
+        return;
+    }
+
+    if (height == 0 || width == 0 || source.getHeight() == 0 || source.getWidth() == 0)
+    {
+        preparerDestination(height, width);
+        return;
+    }
+
+    if constexpr (aDesCanaux<Element>::value)
+    {
+        if (filtre != Filtre::NearestNeighbour)
+        {
+            filtrer(source, height, width, filtre);
+            return;
+        }
+    }
+    redimensionnerPlusProcheVoisin(source, height, width);
+}
+
+/**
+ * @brief donne a la matrice ses nouvelles dimensions, sans se soucier de ses elements
+ */
+template<class M>
+void RedimensionnerMatrice<M>::preparerDestination(size_t height, size_t width)
+{
+    if constexpr (estContigue<M>::value)
+        matrice_->reinitialiser(height, width);
+    else
+    {
+        matrice_->setHeight(height);
+        matrice_->setWidth(width);
+    }
+}
+
+/**
+ * @brief chaque element destination est copie de l'element source dont le
+ * centre est le plus proche du sien
+ */
+template<class M>
+void RedimensionnerMatrice<M>::redimensionnerPlusProcheVoisin(const M& source, size_t height,
+                                                              size_t width)
+{
+    Echantillonnage lignes =
+        calculerEchantillonnage(source.getHeight(), height, Filtre::NearestNeighbour);
+    Echantillonnage colonnes =
+        calculerEchantillonnage(source.getWidth(), width, Filtre::NearestNeighbour);
+
+    preparerDestination(height, width);
+
+    // Seules les matrices contigues garantissent des ecritures independantes par
+    // ligne ; elles sont copiees d'une ligne a l'autre, sans element temporaire
+    if constexpr (estContigue<M>::value)
+        politique_.executerParBandes(height, [&](size_t debut, size_t fin) {
+            for (size_t y = debut; y < fin; ++y)
+            {
+                const auto* ligneSource = source.getLigne(lignes.premier[y]);
+                auto* ligne = matrice_->getLigne(y);
+                for (size_t x = 0; x < width; ++x)
+                    ligne[x] = ligneSource[colonnes.premier[x]];
+            }
+        });
+    else
+        parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+            matrice_->ajouterElement(source(lignes.premier[y], colonnes.premier[x]), y, x);
+        });
+}
+
+/**
+ * @brief redimensionnement filtre en deux passes separables
+ */
+template<class M>
+void RedimensionnerMatrice<M>::filtrer(const M& source, size_t height, size_t width,
+                                       Filtre filtre)
+{
+    Echantillonnage lignes = calculerEchantillonnage(source.getHeight(), height, filtre);
+    Echantillonnage colonnes = calculerEchantillonnage(source.getWidth(), width, filtre);
+
+    preparerDestination(height, width);
+    politique_.executerParBandes(height, [&](size_t debut, size_t fin) {
+        passeVerticale(source, lignes, colonnes, debut, fin);
+    });
+}
+
+/**
+ * @brief redimensionne horizontalement la ligne source y
+ * @param ligneSource, recoit les canaux de la ligne, source.getWidth() * nombre
+ * de canaux float
+ * @param sortie, recoit width * nombre de canaux float
+ */
+template<class M>
+void RedimensionnerMatrice<M>::passeHorizontale(const M& source, const Echantillonnage& colonnes,
+                                                size_t y, float* ligneSource,
+                                                float* sortie) const
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t width = colonnes.premier.size();
+
+    for (size_t x = 0; x < source.getWidth(); ++x)
+    {
+        if constexpr (estContigue<M>::value)
+            CanauxElement<Element>::lire(source.getLigne(y)[x], &ligneSource[x * canaux]);
+        else
+            CanauxElement<Element>::lire(source(y, x), &ligneSource[x * canaux]);
+    }
+
+    for (size_t x = 0; x < width; ++x)
+    {
+        const float* poids = &colonnes.poids[x * colonnes.nombreMax];
+        const float* entree = &ligneSource[colonnes.premier[x] * canaux];
+        float somme[canaux] = {};
+        for (size_t k = 0; k < colonnes.nombre[x]; ++k)
+            for (size_t c = 0; c < canaux; ++c)
+                somme[c] += poids[k] * entree[k * canaux + c];
+        std::copy(somme, somme + canaux, sortie + x * canaux);
+    }
+}
+
+/**
+ * @brief calcule les lignes destination [debut, fin) en combinant des lignes
+ * sources redimensionnees horizontalement, puis les reconvertit en elements
+ *
+ * Les lignes sources d'un element destination sont consecutives et au plus
+ * nombreMax : la ligne source s occupe la case s % nombreMax de l'anneau, et
+ * n'est redimensionnee qu'a sa premiere utilisation dans la bande.
+ */
+template<class M>
+void RedimensionnerMatrice<M>::passeVerticale(const M& source, const Echantillonnage& lignes,
+                                              const Echantillonnage& colonnes, size_t debut,
+                                              size_t fin)
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t largeurCanaux = colonnes.premier.size() * canaux;
+    std::vector<float> ligneSource(source.getWidth() * canaux);
+    std::vector<float> anneau(lignes.nombreMax * largeurCanaux);
+    std::vector<size_t> occupants(lignes.nombreMax, std::numeric_limits<size_t>::max());
+    std::vector<float> somme(largeurCanaux);
+
+    for (size_t y = debut; y < fin; ++y)
+    {
+        std::fill(somme.begin(), somme.end(), 0.0f);
+        const float* poids = &lignes.poids[y * lignes.nombreMax];
+        for (size_t k = 0; k < lignes.nombre[y]; ++k)
+        {
+            size_t ligne = lignes.premier[y] + k;
+            size_t position = ligne % lignes.nombreMax;
+            float* entree = &anneau[position * largeurCanaux];
+            if (occupants[position] != ligne)
+            {
+                passeHorizontale(source, colonnes, ligne, ligneSource.data(), entree);
+                occupants[position] = ligne;
+            }
+            for (size_t i = 0; i < largeurCanaux; ++i)
+                somme[i] += poids[k] * entree[i];
+        }
+
+        for (size_t x = 0; x < largeurCanaux / canaux; ++x)
+        {
+            if constexpr (estContigue<M>::value)
+                matrice_->getLigne(y)[x] = CanauxElement<Element>::ecrire(&somme[x * canaux]);
+            else
+                matrice_->ajouterElement(CanauxElement<Element>::ecrire(&somme[x * canaux]), y,
+                                         x);
+        }
+    }
+}
+
+#endif
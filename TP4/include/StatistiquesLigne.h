@@ -0,0 +1,56 @@
+/*
+ * Titre : StatistiquesLigne.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef STATISTIQUES_LIGNE_H
+#define STATISTIQUES_LIGNE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Noyaux de StatistiquesMatrice, sur une ligne d'octets (pixels entrelaces
+ * ou plan de MatricePlanaire) ou une ligne d'entiers.
+ */
+
+/**
+ * @brief nombre de copies des histogrammes remplies par
+ * accumulerHistogrammes : deux elements consecutifs incrementent des
+ * compteurs differents, meme s'ils ont la meme valeur, ce qui evite
+ * d'attendre l'increment precedent
+ */
+constexpr size_t COPIES_HISTOGRAMME = 4;
+
+/**
+ * @brief ajoute les nombre elements de canaux octets chacun a leurs
+ * histogrammes
+ * @param histogrammes, COPIES_HISTOGRAMME tables consecutives de canaux * 256
+ * compteurs ; l'element i est compte dans la table i % COPIES_HISTOGRAMME,
+ * le canal c de sa valeur v au compteur c * 256 + v
+ */
+void accumulerHistogrammes(const uint8_t* octets, size_t nombre, size_t canaux,
+                           uint64_t* histogrammes);
+
+/**
+ * @brief minimum, maximum, somme et somme des carres des ecarts au pivot
+ * d'une suite d'entiers ; un pivot proche de la moyenne (une des valeurs)
+ * garde les carres petits, et la variance exacte meme pour de grandes valeurs
+ */
+struct ResumeEntiers
+{
+    int minimum;
+    int maximum;
+    int pivot;
+    int64_t somme;
+    double sommeCarres;
+};
+
+/**
+ * @brief ajoute nombre entiers a resume, sans changer son pivot ; vectorise
+ * avec SSE2 ou AVX2 selon les options de compilation
+ */
+void resumerEntiers(const int* valeurs, size_t nombre, ResumeEntiers& resume);
+
+#endif
@@ -0,0 +1,341 @@
+/*
+ * Titre : StatistiquesMatrice.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef STATISTIQUES_MATRICE_H
+#define STATISTIQUES_MATRICE_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include "CanauxElement.h"
+#include "Pixel.h"
+#include "PolitiqueExecution.h"
+#include "StatistiquesLigne.h"
+#include "def.h"
+
+/**
+ * @brief statistiques d'un canal des elements d'une matrice
+ */
+struct StatistiquesCanal
+{
+    double minimum;
+    double maximum;
+    double moyenne;
+    double ecartType;
+    // Nombre d'elements de chaque valeur, de 0 a 255, pour un canal d'octets
+    // (Pixel, plan de MatricePlanaire) ; vide pour les autres elements
+    std::vector<uint64_t> histogramme;
+};
+
+/**
+ * @brief resultat de StatistiquesMatrice::calculer, un StatistiquesCanal par
+ * canal (rouge, vert et bleu pour un Pixel) ; toutes les valeurs sont nulles
+ * pour une matrice vide
+ */
+struct StatistiquesImage
+{
+    size_t nombre;
+    std::vector<StatistiquesCanal> canaux;
+};
+
+/**
+ * @brief definition de la classe StatistiquesMatrice
+ *
+ * Calcule en une seule lecture de la matrice le minimum, le maximum, la
+ * moyenne et l'ecart type de chaque canal de ses elements (CanauxElement).
+ * Chaque bande de lignes de la politique d'execution accumule ses resultats
+ * partiels, fusionnes a la fin de la bande :
+ * - pour les canaux d'octets (Pixel, plans d'une matrice planaire), un
+ *   histogramme de 256 valeurs par canal (StatistiquesLigne.h), dont toutes
+ *   les autres statistiques sont ensuite deduites exactement ;
+ * - pour les entiers, le minimum, le maximum, la somme des ecarts au premier
+ *   element de la bande et celle de leurs carres, calcules par blocs SSE2 ou
+ *   AVX2, puis fusionnes dans l'ordre des bandes ;
+ * - pour les autres elements et les matrices non contigues, la moyenne et la
+ *   somme des carres des ecarts mises a jour element par element, sur les
+ *   canaux en float, par un seul thread.
+ */
+template<class M>
+class StatistiquesMatrice
+{
+public:
+    StatistiquesMatrice();
+    StatistiquesMatrice(const M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~StatistiquesMatrice() = default;
+    StatistiquesImage calculer() const;
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    using Element = ElementDe<M>;
+    static constexpr bool estOctets =
+        std::is_same_v<Element, Pixel> || std::is_same_v<Element, uint8_t>;
+
+    static StatistiquesCanal depuisHistogramme(std::vector<uint64_t> histogramme);
+    StatistiquesImage calculerOctets() const;
+    StatistiquesImage calculerEntiers() const;
+    StatistiquesImage calculerElements() const;
+    const M* matrice_;
+    PolitiqueExecution politique_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline StatistiquesMatrice<M>::StatistiquesMatrice()
+    : matrice_(nullptr)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ */
+template<class M>
+inline StatistiquesMatrice<M>::StatistiquesMatrice(const M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+{
+}
+
+/**
+ * @brief change la facon dont le calcul repartit son travail
+ */
+template<class M>
+inline void StatistiquesMatrice<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief calcule les statistiques de chaque canal de la matrice
+ */
+template<class M>
+StatistiquesImage StatistiquesMatrice<M>::calculer() const
+{
+    static_assert(aDesCanaux<Element>::value,
+                  "Les statistiques demandent des elements a canaux (voir CanauxElement.h)");
+
+    if constexpr (estPlanaire<M>::value)
+    {
+        StatistiquesImage statistiques = {matrice_->getHeight() * matrice_->getWidth(), {}};
+        for (size_t canal = 0; canal < matrice_->getNombrePlans(); ++canal)
+            statistiques.canaux.push_back(
+                StatistiquesMatrice<PlanDe<M>>(&matrice_->getPlan(canal), politique_)
+                    .calculer()
+                    .canaux[0]);
+        return statistiques;
+    }
+    else if constexpr (estContigue<M>::value && estOctets)
+        return calculerOctets();
+    else if constexpr (estContigue<M>::value && std::is_same_v<Element, int>)
+        return calculerEntiers();
+    else
+        return calculerElements();
+}
+
+/**
+ * @brief deduit les statistiques d'un canal d'octets de son histogramme
+ */
+template<class M>
+StatistiquesCanal StatistiquesMatrice<M>::depuisHistogramme(std::vector<uint64_t> histogramme)
+{
+    StatistiquesCanal canal = {0.0, 0.0, 0.0, 0.0, {}};
+    uint64_t nombre = 0;
+    double somme = 0.0;
+    for (size_t valeur = 0; valeur < histogramme.size(); ++valeur)
+    {
+        nombre += histogramme[valeur];
+        somme += double(valeur) * double(histogramme[valeur]);
+    }
+
+    if (nombre != 0)
+    {
+        auto nonNul = [](uint64_t compte) { return compte != 0; };
+        canal.minimum = double(std::find_if(histogramme.begin(), histogramme.end(), nonNul) -
+                               histogramme.begin());
+        canal.maximum = double(histogramme.rend() -
+                               std::find_if(histogramme.rbegin(), histogramme.rend(), nonNul) - 1);
+        canal.moyenne = somme / double(nombre);
+
+        double variance = 0.0;
+        for (size_t valeur = 0; valeur < histogramme.size(); ++valeur)
+        {
+            double ecart = double(valeur) - canal.moyenne;
+            variance += ecart * ecart * double(histogramme[valeur]);
+        }
+        canal.ecartType = std::sqrt(variance / double(nombre));
+    }
+    canal.histogramme = std::move(histogramme);
+    return canal;
+}
+
+/**
+ * @brief histogrammes des canaux d'octets d'une matrice contigue
+ */
+template<class M>
+StatistiquesImage StatistiquesMatrice<M>::calculerOctets() const
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    constexpr size_t taille = canaux * 256;
+    size_t width = matrice_->getWidth();
+    std::vector<uint64_t> total(taille, 0);
+    std::mutex verrou;
+
+    politique_.executerParBandes(matrice_->getHeight(), [&](size_t debut, size_t fin) {
+        std::vector<uint64_t> copies(COPIES_HISTOGRAMME * taille, 0);
+        for (size_t y = debut; y < fin; ++y)
+            accumulerHistogrammes(reinterpret_cast<const uint8_t*>(matrice_->getLigne(y)), width,
+                                  canaux, copies.data());
+
+        std::lock_guard<std::mutex> garde(verrou);
+        for (size_t copie = 0; copie < COPIES_HISTOGRAMME; ++copie)
+            for (size_t i = 0; i < taille; ++i)
+                total[i] += copies[copie * taille + i];
+    });
+
+    StatistiquesImage statistiques = {matrice_->getHeight() * width, {}};
+    for (size_t canal = 0; canal < canaux; ++canal)
+        statistiques.canaux.push_back(depuisHistogramme(
+            std::vector<uint64_t>(total.begin() + std::ptrdiff_t(canal * 256),
+                                  total.begin() + std::ptrdiff_t((canal + 1) * 256))));
+    return statistiques;
+}
+
+/**
+ * @brief minimum, maximum, moyenne et ecart type d'une matrice contigue
+ * d'entiers ; chaque bande resume ses lignes autour de son premier element,
+ * puis les bandes sont fusionnees dans l'ordre de leurs lignes, quel que soit
+ * celui dans lequel les threads les terminent
+ */
+template<class M>
+StatistiquesImage StatistiquesMatrice<M>::calculerEntiers() const
+{
+    size_t width = matrice_->getWidth();
+    size_t nombre = matrice_->getHeight() * width;
+    std::map<size_t, ResumeEntiers> bandes;
+    std::mutex verrou;
+
+    if (nombre != 0)
+        politique_.executerParBandes(matrice_->getHeight(), [&](size_t debut, size_t fin) {
+            ResumeEntiers bande = {INT_MAX, INT_MIN, matrice_->getLigne(debut)[0], 0, 0.0};
+            for (size_t y = debut; y < fin; ++y)
+                resumerEntiers(matrice_->getLigne(y), width, bande);
+
+            std::lock_guard<std::mutex> garde(verrou);
+            bandes.emplace(debut, bande);
+        });
+
+    // Fusion de Chan et al. : deux groupes de na et nb elements, de moyennes
+    // ma et mb et de sommes des carres des ecarts a leur moyenne Ca et Cb,
+    // forment un groupe de moyenne ma + (mb - ma) nb / n et de somme des
+    // carres Ca + Cb + (mb - ma)^2 na nb / n
+    StatistiquesCanal canal = {0.0, 0.0, 0.0, 0.0, {}};
+    double compte = 0.0;
+    double carres = 0.0;
+    for (auto debutBande = bandes.begin(); debutBande != bandes.end(); ++debutBande)
+    {
+        auto finBande = std::next(debutBande);
+        size_t fin = finBande == bandes.end() ? matrice_->getHeight() : finBande->first;
+        const ResumeEntiers& bande = debutBande->second;
+        double compteBande = double((fin - debutBande->first) * width);
+        double ecartMoyen = double(bande.somme) / compteBande;
+        double moyenneBande = double(bande.pivot) + ecartMoyen;
+        double carresBande = std::max(bande.sommeCarres - double(bande.somme) * ecartMoyen, 0.0);
+
+        if (compte == 0.0)
+        {
+            canal.minimum = bande.minimum;
+            canal.maximum = bande.maximum;
+            canal.moyenne = moyenneBande;
+            carres = carresBande;
+        }
+        else
+        {
+            double difference = moyenneBande - canal.moyenne;
+            double total = compte + compteBande;
+            canal.minimum = std::min(canal.minimum, double(bande.minimum));
+            canal.maximum = std::max(canal.maximum, double(bande.maximum));
+            canal.moyenne += difference * compteBande / total;
+            carres += carresBande + difference * difference * compte * compteBande / total;
+        }
+        compte += compteBande;
+    }
+    if (compte != 0.0)
+        canal.ecartType = std::sqrt(carres / compte);
+    return {nombre, {canal}};
+}
+
+/**
+ * @brief statistiques des canaux en float, element par element ; les canaux
+ * d'octets d'une matrice non contigue passent aussi par un histogramme
+ */
+template<class M>
+StatistiquesImage StatistiquesMatrice<M>::calculerElements() const
+{
+    constexpr size_t canaux = CanauxElement<Element>::nombre;
+    size_t height = matrice_->getHeight();
+    size_t width = matrice_->getWidth();
+    StatistiquesImage statistiques = {height * width, {}};
+
+    if constexpr (estOctets)
+    {
+        std::vector<uint64_t> histogrammes(canaux * 256, 0);
+        parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+            float valeurs[canaux];
+            CanauxElement<Element>::lire((*matrice_)(y, x), valeurs);
+            for (size_t canal = 0; canal < canaux; ++canal)
+                ++histogrammes[canal * 256 + size_t(valeurs[canal])];
+        });
+        for (size_t canal = 0; canal < canaux; ++canal)
+            statistiques.canaux.push_back(depuisHistogramme(
+                std::vector<uint64_t>(histogrammes.begin() + std::ptrdiff_t(canal * 256),
+                                      histogrammes.begin() + std::ptrdiff_t((canal + 1) * 256))));
+    }
+    else
+    {
+        // Moyenne et somme des carres des ecarts mises a jour a chaque
+        // element (Welford), sans la soustraction de deux grandes sommes
+        double minimums[canaux];
+        double maximums[canaux];
+        double moyennes[canaux] = {};
+        double carres[canaux] = {};
+        double compte = 0.0;
+        std::fill(minimums, minimums + canaux, HUGE_VAL);
+        std::fill(maximums, maximums + canaux, -HUGE_VAL);
+        parcourirPositions(*matrice_, height, width, [&](size_t y, size_t x) {
+            float valeurs[canaux];
+            CanauxElement<Element>::lire((*matrice_)(y, x), valeurs);
+            compte += 1.0;
+            for (size_t canal = 0; canal < canaux; ++canal)
+            {
+                double valeur = valeurs[canal];
+                double ecart = valeur - moyennes[canal];
+                minimums[canal] = std::min(minimums[canal], valeur);
+                maximums[canal] = std::max(maximums[canal], valeur);
+                moyennes[canal] += ecart / compte;
+                carres[canal] += ecart * (valeur - moyennes[canal]);
+            }
+        });
+
+        for (size_t canal = 0; canal < canaux; ++canal)
+        {
+            StatistiquesCanal resultat = {0.0, 0.0, 0.0, 0.0, {}};
+            if (compte != 0.0)
+                resultat = {minimums[canal], maximums[canal], moyennes[canal],
+                            std::sqrt(carres[canal] / compte), {}};
+            statistiques.canaux.push_back(resultat);
+        }
+    }
+    return statistiques;
+}
+
+#endif
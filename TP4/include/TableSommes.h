@@ -0,0 +1,417 @@
+/*
+ * Titre : TableSommes.h - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#ifndef TABLE_SOMMES_H
+#define TABLE_SOMMES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "CanauxElement.h"
+#include "Echantillonnage.h"
+#include "Pixel.h"
+#include "PolitiqueExecution.h"
+#include "def.h"
+
+/**
+ * @brief definition de la classe TableSommes
+ *
+ * Table des sommes cumulees (image integrale) d'une matrice d'entiers, de
+ * pixels ou d'octets : la case (y, x) de chaque canal vaut la somme des
+ * elements des lignes < y et des colonnes < x. Une fois la table construite,
+ * la somme ou la moyenne d'un rectangle quelconque se lit en quatre cases.
+ *
+ * La construction est repartie par bandes de lignes selon la politique
+ * d'execution : chaque bande cumule ses lignes comme si elle commencait la
+ * matrice, puis une seconde passe, elle aussi par bandes, ajoute a chaque
+ * ligne la derniere ligne complete de la bande precedente.
+ *
+ * La table ne voit pas les ecritures faites directement dans la matrice :
+ * ajouterElement ecrit l'element et invalide la table a partir de sa ligne,
+ * invalider le fait pour les autres ecritures. La requete suivante
+ * (ou mettreAJour) ne recalcule que les lignes invalidees ; un changement
+ * de dimensions de la matrice reconstruit toute la table.
+ *
+ * redimensionner ecrit dans une autre matrice le resultat du filtre Box de
+ * RedimensionnerMatrice, chaque element etant la moyenne exacte de son
+ * rectangle source : une fois la table construite, une reduction ne coute
+ * qu'au plus neuf rectangles par element destination, quelle que soit la source.
+ */
+template<class M>
+class TableSommes
+{
+public:
+    using Element = ElementDe<M>;
+
+    TableSommes();
+    TableSommes(M* matrice, PolitiqueExecution politique = PolitiqueExecution());
+    ~TableSommes() = default;
+    bool ajouterElement(Element element, size_t posY, size_t posX);
+    void invalider(size_t posY = 0);
+    void mettreAJour();
+    int64_t somme(size_t posY, size_t posX, size_t height, size_t width, size_t canal = 0);
+    size_t sommes(size_t posY, size_t posX, size_t height, size_t width, int64_t* parCanal);
+    double moyenne(size_t posY, size_t posX, size_t height, size_t width, size_t canal = 0);
+    template<class D>
+    void redimensionner(D& destination, size_t height, size_t width);
+    void setPolitiqueExecution(const PolitiqueExecution& politique);
+
+private:
+    static_assert(std::is_same_v<Element, int> || std::is_same_v<Element, Pixel> ||
+                      std::is_same_v<Element, uint8_t>,
+                  "La table des sommes demande des entiers, des pixels ou des octets");
+    static_assert(!estPlanaire<M>::value, "Une matrice planaire demande une table par plan");
+
+    static constexpr size_t canaux = CanauxElement<Element>::nombre;
+    // Les canaux d'un pixel sont lus comme des octets consecutifs
+    using Valeur = std::conditional_t<std::is_same_v<Element, int>, int, uint8_t>;
+
+    int64_t* getLigneTable(size_t posY);
+    void cumulerLignes(size_t debut, size_t fin, bool depuisZero);
+    void construire(size_t premiereLigne);
+    M* matrice_;
+    PolitiqueExecution politique_;
+    // Non initialisee a l'allocation : chaque case est ecrite par construire
+    std::unique_ptr<int64_t[]> table_;
+    size_t height_;
+    size_t width_;
+    // Premiere ligne de la matrice dont les sommes sont a recalculer ; height_
+    // si la table est a jour
+    size_t ligneInvalide_;
+};
+
+/**
+ * @brief constructeur par défaut de la classe
+ */
+template<class M>
+inline TableSommes<M>::TableSommes()
+    : matrice_(nullptr)
+    , height_(0)
+    , width_(0)
+    , ligneInvalide_(0)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe ; la table est construite
+ * a la premiere requete
+ */
+template<class M>
+inline TableSommes<M>::TableSommes(M* matrice, PolitiqueExecution politique)
+    : matrice_(matrice)
+    , politique_(std::move(politique))
+    , height_(0)
+    , width_(0)
+    , ligneInvalide_(0)
+{
+}
+
+/**
+ * @brief change la facon dont la construction repartit son travail
+ */
+template<class M>
+inline void TableSommes<M>::setPolitiqueExecution(const PolitiqueExecution& politique)
+{
+    politique_ = politique;
+}
+
+/**
+ * @brief ecrit un element dans la matrice et invalide les sommes qui en dependent
+ * @return false si la position est hors de la matrice
+ */
+template<class M>
+bool TableSommes<M>::ajouterElement(Element element, size_t posY, size_t posX)
+{
+    if (!matrice_->ajouterElement(element, posY, posX))
+        return false;
+
+    invalider(posY);
+    return true;
+}
+
+/**
+ * @brief signale que les lignes a partir de posY ont pu changer
+ */
+template<class M>
+inline void TableSommes<M>::invalider(size_t posY)
+{
+    ligneInvalide_ = std::min(ligneInvalide_, posY);
+}
+
+/**
+ * @brief recalcule les sommes invalidees, ou toute la table si les
+ * dimensions de la matrice ont change
+ */
+template<class M>
+void TableSommes<M>::mettreAJour()
+{
+    if (matrice_->getHeight() != height_ || matrice_->getWidth() != width_ || !table_)
+    {
+        height_ = matrice_->getHeight();
+        width_ = matrice_->getWidth();
+        // L'ancienne table est liberee avant l'allocation de la nouvelle
+        table_.reset();
+        table_.reset(new int64_t[(height_ + 1) * (width_ + 1) * canaux]);
+        std::fill(getLigneTable(0), getLigneTable(1), 0);
+        ligneInvalide_ = 0;
+    }
+
+    // A jour, la table n'est que lue : plusieurs threads peuvent l'interroger
+    if (ligneInvalide_ < height_)
+    {
+        construire(ligneInvalide_);
+        ligneInvalide_ = height_;
+    }
+}
+
+/**
+ * @brief somme de chaque canal des elements d'un rectangle, borne a la matrice
+ * @param posY, la premiere ligne du rectangle
+ * @param posX, la premiere colonne du rectangle
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ * @param parCanal, recoit une somme par canal (rouge, vert, bleu pour un pixel)
+ * @return le nombre d'elements du rectangle borne
+ */
+template<class M>
+size_t TableSommes<M>::sommes(size_t posY, size_t posX, size_t height, size_t width,
+                              int64_t* parCanal)
+{
+    mettreAJour();
+    size_t haut = std::min(posY, height_);
+    size_t gauche = std::min(posX, width_);
+    size_t bas = haut + std::min(height, height_ - haut);
+    size_t droite = gauche + std::min(width, width_ - gauche);
+
+    const int64_t* ligneHaut = getLigneTable(haut);
+    const int64_t* ligneBas = getLigneTable(bas);
+    for (size_t c = 0; c < canaux; ++c)
+        parCanal[c] = ligneBas[droite * canaux + c] - ligneBas[gauche * canaux + c] -
+                      ligneHaut[droite * canaux + c] + ligneHaut[gauche * canaux + c];
+    return (bas - haut) * (droite - gauche);
+}
+
+/**
+ * @brief somme d'un canal des elements d'un rectangle, borne a la matrice
+ * @param canal, 0 pour les entiers, 0 (rouge) a 2 (bleu) pour les pixels
+ */
+template<class M>
+int64_t TableSommes<M>::somme(size_t posY, size_t posX, size_t height, size_t width,
+                              size_t canal)
+{
+    int64_t parCanal[canaux];
+    sommes(posY, posX, height, width, parCanal);
+    return canal < canaux ? parCanal[canal] : 0;
+}
+
+/**
+ * @brief moyenne d'un canal des elements d'un rectangle, borne a la matrice
+ * @return 0 pour un rectangle vide
+ */
+template<class M>
+double TableSommes<M>::moyenne(size_t posY, size_t posX, size_t height, size_t width,
+                               size_t canal)
+{
+    int64_t parCanal[canaux];
+    size_t nombre = sommes(posY, posX, height, width, parCanal);
+    return nombre == 0 || canal >= canaux ? 0.0 : double(parCanal[canal]) / double(nombre);
+}
+
+/**
+ * @brief redimensionne la matrice dans destination avec le filtre Box : chaque
+ * element destination est la moyenne des elements sources ponderes par la part
+ * qu'en couvre son intervalle source (voir calculerEchantillonnage), soit au
+ * plus neuf rectangles de la table
+ * @param destination, une matrice de memes elements, de dimensions quelconques
+ * @param height, le nombre de lignes de destination
+ * @param width, le nombre de colonnes de destination
+ */
+template<class M>
+template<class D>
+void TableSommes<M>::redimensionner(D& destination, size_t height, size_t width)
+{
+    static_assert(std::is_same_v<ElementDe<D>, Element> && !estFixe<D>::value,
+                  "La destination doit avoir les memes elements et des dimensions variables");
+
+    mettreAJour();
+    if constexpr (estContigue<D>::value)
+        destination.reinitialiser(height, width);
+    else
+    {
+        destination.setHeight(height);
+        destination.setWidth(width);
+    }
+    if (height == 0 || width == 0 || height_ == 0 || width_ == 0)
+        return;
+
+    // Les poids Box d'un element sont egaux sauf le premier et le dernier, que
+    // l'intervalle source ne couvre qu'en partie : chaque element destination se
+    // decoupe en au plus trois segments de poids constant par axe
+    struct Segment
+    {
+        size_t debut;
+        size_t nombre;
+        double poids;
+    };
+    auto decouper = [](const Echantillonnage& echantillonnage, size_t i, Segment* segments) {
+        const float* poids = &echantillonnage.poids[i * echantillonnage.nombreMax];
+        size_t debut = 0;
+        size_t fin = echantillonnage.nombre[i];
+        while (debut + 1 < fin && poids[debut] == 0.0f)
+            ++debut;
+        while (fin > debut + 1 && poids[fin - 1] == 0.0f)
+            --fin;
+        size_t premier = echantillonnage.premier[i];
+        size_t nombre = 0;
+        segments[nombre++] = {premier + debut, 1, poids[debut]};
+        if (fin - debut > 2)
+            segments[nombre++] = {premier + debut + 1, fin - debut - 2, poids[debut + 1]};
+        if (fin - debut > 1)
+            segments[nombre++] = {premier + fin - 1, 1, poids[fin - 1]};
+        return nombre;
+    };
+    Echantillonnage lignes = calculerEchantillonnage(height_, height, Filtre::Box);
+    Echantillonnage colonnes = calculerEchantillonnage(width_, width, Filtre::Box);
+
+    auto calculer = [&](size_t y, size_t x) {
+        Segment segmentsY[3];
+        Segment segmentsX[3];
+        size_t nombreY = decouper(lignes, y, segmentsY);
+        size_t nombreX = decouper(colonnes, x, segmentsX);
+        double moyennes[canaux] = {};
+        for (size_t i = 0; i < nombreY; ++i)
+            for (size_t j = 0; j < nombreX; ++j)
+            {
+                int64_t parCanal[canaux];
+                sommes(segmentsY[i].debut, segmentsX[j].debut, segmentsY[i].nombre,
+                       segmentsX[j].nombre, parCanal);
+                for (size_t c = 0; c < canaux; ++c)
+                    moyennes[c] += double(parCanal[c]) * segmentsY[i].poids * segmentsX[j].poids;
+            }
+        float resultat[canaux];
+        for (size_t c = 0; c < canaux; ++c)
+            resultat[c] = float(moyennes[c]);
+        return CanauxElement<Element>::ecrire(resultat);
+    };
+    if constexpr (estContigue<D>::value)
+        politique_.executerParBandes(height, [&](size_t debut, size_t fin) {
+            for (size_t y = debut; y < fin; ++y)
+                for (size_t x = 0; x < width; ++x)
+                    destination.getLigne(y)[x] = calculer(y, x);
+        });
+    else
+        parcourirPositions(destination, height, width, [&](size_t y, size_t x) {
+            destination.ajouterElement(calculer(y, x), y, x);
+        });
+}
+
+/**
+ * @brief retourne la ligne posY de la table, de (width_ + 1) * canaux cases
+ */
+template<class M>
+inline int64_t* TableSommes<M>::getLigneTable(size_t posY)
+{
+    return table_.get() + posY * (width_ + 1) * canaux;
+}
+
+/**
+ * @brief calcule les lignes de la table des lignes [debut, fin) de la matrice
+ * @param depuisZero, vrai pour cumuler comme si la ligne debut etait la
+ * premiere de la matrice ; faux pour partir de la ligne de table debut
+ */
+template<class M>
+void TableSommes<M>::cumulerLignes(size_t debut, size_t fin, bool depuisZero)
+{
+    std::vector<Element> ligneCopiee(estContigue<M>::value ? 0 : width_);
+    std::vector<int64_t> zeros(depuisZero ? (width_ + 1) * canaux : 0, 0);
+
+    for (size_t y = debut; y < fin; ++y)
+    {
+        const Element* elements = nullptr;
+        if constexpr (estContigue<M>::value)
+            elements = matrice_->getLigne(y);
+        else
+        {
+            for (size_t x = 0; x < width_; ++x)
+                ligneCopiee[x] = (*matrice_)(y, x);
+            elements = ligneCopiee.data();
+        }
+        const Valeur* valeurs = reinterpret_cast<const Valeur*>(elements);
+
+        const int64_t* dessus = y == debut && depuisZero ? zeros.data() : getLigneTable(y);
+        int64_t* sortie = getLigneTable(y + 1);
+        int64_t cumul[canaux] = {};
+        std::fill(sortie, sortie + canaux, 0);
+        for (size_t x = 0; x < width_; ++x)
+            for (size_t c = 0; c < canaux; ++c)
+            {
+                cumul[c] += valeurs[x * canaux + c];
+                sortie[(x + 1) * canaux + c] = dessus[(x + 1) * canaux + c] + cumul[c];
+            }
+    }
+}
+
+/**
+ * @brief recalcule la table a partir de la ligne premiereLigne de la matrice
+ */
+template<class M>
+void TableSommes<M>::construire(size_t premiereLigne)
+{
+    // Les ecritures d'une MatriceTuilee ne sont pas independantes d'un thread a l'autre
+    if constexpr (!estContigue<M>::value)
+    {
+        cumulerLignes(premiereLigne, height_, false);
+        return;
+    }
+
+    std::vector<std::pair<size_t, size_t>> bandes;
+    std::mutex verrou;
+    politique_.executerParBandes(height_ - premiereLigne, [&](size_t debut, size_t fin) {
+        debut += premiereLigne;
+        fin += premiereLigne;
+        // La premiere bande part de la ligne de table deja a jour
+        cumulerLignes(debut, fin, debut != premiereLigne);
+        std::lock_guard<std::mutex> garde(verrou);
+        bandes.emplace_back(debut, fin);
+    });
+    if (bandes.size() < 2)
+        return;
+
+    // Chaque bande suivante est decalee de la derniere ligne complete de la
+    // precedente ; ces decalages se calculent d'une bande a l'autre
+    std::sort(bandes.begin(), bandes.end());
+    size_t largeurTable = (width_ + 1) * canaux;
+    std::vector<int64_t> decalages(bandes.size() * largeurTable, 0);
+    for (size_t b = 1; b < bandes.size(); ++b)
+    {
+        const int64_t* precedente = getLigneTable(bandes[b - 1].second);
+        for (size_t i = 0; i < largeurTable; ++i)
+            decalages[b * largeurTable + i] =
+                decalages[(b - 1) * largeurTable + i] + precedente[i];
+    }
+
+    politique_.executerParBandes(height_ - premiereLigne, [&](size_t debut, size_t fin) {
+        for (size_t y = debut + premiereLigne; y < fin + premiereLigne; ++y)
+        {
+            size_t b = size_t(std::upper_bound(bandes.begin(), bandes.end(),
+                                               std::make_pair(y, height_ + 1)) -
+                              bandes.begin()) -
+                       1;
+            if (b == 0)
+                continue;
+            int64_t* ligne = getLigneTable(y + 1);
+            const int64_t* decalage = &decalages[b * largeurTable];
+            for (size_t i = 0; i < largeurTable; ++i)
+                ligne[i] += decalage[i];
+        }
+    });
+}
+
+#endif
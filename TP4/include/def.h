@@ -7,8 +7,13 @@
 #ifndef DEF_H
 #define DEF_H
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#include "EcritureElement.h"
+#include "LectureElement.h"
 
 /** ----------------------------------------------------------------------- **/
 struct Coordonnees
@@ -20,10 +25,128 @@ struct Coordonnees
 enum class Direction
 {
     first_ = -1,
-    Right,
-    Left,
+    Right,          // quart de tour horaire
+    Left,           // quart de tour anti-horaire
+    UpsideDown,     // demi-tour
+    FlipHorizontal, // miroir gauche-droite
+    FlipVertical,   // miroir haut-bas
     last_
 };
+/** ----------------------------------------------------------------------- **/
+/** Filtres de redimensionnement (voir RedimensionnerMatrice.h) **/
+enum class Filtre
+{
+    first_ = -1,
+    NearestNeighbour, // copie de l'element source le plus proche
+    Box,              // moyenne des elements sources couverts
+    Bilinear,         // interpolation lineaire dans chaque direction
+    last_
+};
+/** ----------------------------------------------------------------------- **/
+/** Dimensions d'une matrice pivotee d'un angle quelconque (voir PivoterMatrice.h) **/
+enum class Cadre
+{
+    first_ = -1,
+    Englober,  // la matrice s'agrandit pour contenir toute l'image pivotee
+    Conserver, // la matrice garde ses dimensions, les coins sortants sont perdus
+    last_
+};
+/** ----------------------------------------------------------------------- **/
+/** Traitement des bords d'une convolution (voir ConvoluerMatrice.h) **/
+enum class Bord
+{
+    first_ = -1,
+    Etendre,    // l'element du bord est repete
+    Miroir,     // l'image est refletee autour de l'element du bord
+    Periodique, // l'image reprend du cote oppose
+    Zero,       // les elements hors de l'image sont nuls
+    last_
+};
+/** ----------------------------------------------------------------------- **/
+/** Canaux d'un pixel (voir AjusterCouleurs.h) **/
+enum class Canal
+{
+    first_ = -1,
+    Rouge,
+    Vert,
+    Bleu,
+    last_
+};
+/** ----------------------------------------------------------------------- **/
+/** Type des elements d'une matrice M, tel que retourne par son operateur () **/
+template<class M>
+using ElementDe = std::decay_t<decltype(std::declval<const M&>()(size_t(0), size_t(0)))>;
+/** ----------------------------------------------------------------------- **/
+/** Vrai si M donne acces a ses lignes en memoire contigue (getLigne, getStride),
+ * ce qui permet aux transformations de parcourir directement le tampon **/
+template<class M, class = void>
+struct estContigue : std::false_type
+{
+};
+template<class M>
+struct estContigue<M, std::void_t<decltype(std::declval<M&>().getLigne(size_t(0))),
+                                  decltype(std::declval<const M&>().getStride())>>
+    : std::true_type
+{
+};
+/** Vrai si M range ses elements en plans separes (getPlan, getNombrePlans),
+ * chacun etant une matrice que les transformations traitent a part **/
+template<class M, class = void>
+struct estPlanaire : std::false_type
+{
+};
+template<class M>
+struct estPlanaire<M, std::void_t<decltype(std::declval<M&>().getPlan(size_t(0))),
+                                  decltype(std::declval<const M&>().getNombrePlans())>>
+    : std::true_type
+{
+};
+/** Type des plans d'une matrice planaire M **/
+template<class M>
+using PlanDe = std::decay_t<decltype(std::declval<M&>().getPlan(size_t(0)))>;
+/** Vrai si M range ses elements par tuiles carrees (getCoteTuile), dont l'acces
+ * est peu couteux tant qu'on reste dans la meme tuile **/
+template<class M, class = void>
+struct estTuilee : std::false_type
+{
+};
+template<class M>
+struct estTuilee<M, std::void_t<decltype(std::declval<const M&>().getCoteTuile())>>
+    : std::true_type
+{
+};
+/** Vrai si les dimensions de M sont fixees a la compilation (M::HEIGHT et
+ * M::WIDTH) : les transformations ne peuvent alors pas les changer **/
+template<class M, class = void>
+struct estFixe : std::false_type
+{
+};
+template<class M>
+struct estFixe<M, std::void_t<decltype(M::HEIGHT), decltype(M::WIDTH)>> : std::true_type
+{
+};
+/** Appelle fonction(y, x) pour chaque position d'une matrice height x width de
+ * type M : ligne par ligne, ou tuile par tuile si M est rangee par tuiles **/
+template<class M, class F>
+void parcourirPositions(const M& matrice, size_t height, size_t width, F fonction)
+{
+    if constexpr (estTuilee<M>::value)
+    {
+        size_t cote = matrice.getCoteTuile();
+        for (size_t tuileY = 0; tuileY < height; tuileY += cote)
+            for (size_t tuileX = 0; tuileX < width; tuileX += cote)
+                for (size_t y = tuileY; y < std::min(tuileY + cote, height); ++y)
+                    for (size_t x = tuileX; x < std::min(tuileX + cote, width); ++x)
+                        fonction(y, x);
+    }
+    else
+    {
+        (void)matrice;
+        for (size_t y = 0; y < height; ++y)
+            for (size_t x = 0; x < width; ++x)
+                fonction(y, x);
+    }
+}
 /** Classe Couleur est définie pour les tests! Veuillez ne pas la modifier! **/
 /** ----------------------------------------------------------------------- **/
 class Couleur
@@ -38,20 +161,58 @@ public:
     bool operator==(const Couleur& couleur) { return couleur_ == couleur.couleur_; }
     std::string couleur_;
 };
+/** Echange de deux couleurs sans copier leurs chaines : Couleur n'a pas de
+ * deplacement, std::swap ferait trois copies (voir PivoterMatrice) **/
+inline void swap(Couleur& premiere, Couleur& seconde) noexcept
+{
+    premiere.couleur_.swap(seconde.couleur_);
+}
 /** Operateur >> : nécessaire pour que la classe soit compatible avec
  * l'implémentation de la classe générique Matrice **/
-std::istream& operator>>(std::istream& is, Couleur& couleur)
+inline std::istream& operator>>(std::istream& is, Couleur& couleur)
 {
     is >> couleur.couleur_;
     return is;
 }
 /** Operateur << : nécessaire pour que la classe soit compatible avec
  * l'implémentation de la classe générique Image **/
-std::ostream& operator<<(std::ostream& os, Couleur couleur)
+inline std::ostream& operator<<(std::ostream& os, Couleur couleur)
 {
     os << std::setw(10) << std::setfill(' ') << couleur.couleur_;
     return os;
 }
+/** Lecture d'une couleur par le chargeur de Matrice : premier mot de la ligne,
+ * comme l'operateur >>, sans construire de flux **/
+template<>
+struct LectureElement<Couleur>
+{
+    static void lire(const char* debut, const char* fin, Couleur& couleur)
+    {
+        debut = lecture::ignorerEspaces(debut, fin);
+        const char* finMot = debut;
+        while (finMot != fin && *finMot != ' ' && *finMot != '\t' && *finMot != '\r')
+            ++finMot;
+        if (finMot != debut)
+            couleur.couleur_.assign(debut, finMot);
+    }
+};
+/** Ecriture d'une couleur sans flux : alignee a droite sur 10 caracteres pour
+ * l'affichage, comme l'operateur <<, et seule sur sa ligne dans un fichier **/
+template<>
+struct EcritureElement<Couleur>
+{
+    static void afficher(const Couleur& couleur, std::string& tampon)
+    {
+        if (couleur.couleur_.size() < 10)
+            tampon.append(10 - couleur.couleur_.size(), ' ');
+        tampon += couleur.couleur_;
+    }
+
+    static void ecrire(const Couleur& couleur, std::string& tampon)
+    {
+        tampon += couleur.couleur_;
+    }
+};
 /** ---------------------------------------------------------------------- **/
 /** Classe Entier est définie pour les tests! Veuillez ne pas la modifier! **/
 class Entier
@@ -68,7 +229,7 @@ public:
 };
 /** Operateur >> : nécessaire pour que la classe soit compatible avec
  * l'implémentation de la classe générique Matrice **/
-std::istream& operator>>(std::istream& is, Entier& entier)
+inline std::istream& operator>>(std::istream& is, Entier& entier)
 {
     is >> entier.nombre_;
     return is;
@@ -0,0 +1,151 @@
+/*
+ * Titre : AgrandirLigne.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "AgrandirLigne.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief agrandissement d'une ligne d'entiers ; les rapports 2 et 4 (les
+ * plus frequents) sont vectorises, les autres repetent chaque valeur avec fill_n
+ */
+void agrandirLigne(const int* source, size_t width, unsigned int rapport, int* destination)
+{
+    size_t x = 0;
+
+#if defined(__AVX2__)
+    if (rapport == 2)
+    {
+        const __m256i doubler = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        for (; x + 4 <= width; x += 4, destination += 8)
+        {
+            __m128i valeurs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination),
+                                _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(valeurs),
+                                                            doubler));
+        }
+    }
+#elif defined(__SSE2__)
+    if (rapport == 2)
+    {
+        for (; x + 4 <= width; x += 4, destination += 8)
+        {
+            __m128i valeurs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                             _mm_unpacklo_epi32(valeurs, valeurs));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4),
+                             _mm_unpackhi_epi32(valeurs, valeurs));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    if (rapport == 4)
+    {
+        for (; x + 4 <= width; x += 4, destination += 16)
+        {
+            __m128i valeurs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+            __m128i* sortie = reinterpret_cast<__m128i*>(destination);
+            _mm_storeu_si128(sortie, _mm_shuffle_epi32(valeurs, 0x00));
+            _mm_storeu_si128(sortie + 1, _mm_shuffle_epi32(valeurs, 0x55));
+            _mm_storeu_si128(sortie + 2, _mm_shuffle_epi32(valeurs, 0xAA));
+            _mm_storeu_si128(sortie + 3, _mm_shuffle_epi32(valeurs, 0xFF));
+        }
+    }
+#endif
+
+    agrandirLigne<int>(source + x, width - x, rapport, destination);
+}
+
+/**
+ * @brief agrandissement d'une ligne d'octets ; les rapports 2 et 4 entrelacent
+ * 16 octets avec eux-memes (punpcklbw / punpckhbw)
+ */
+void agrandirLigne(const uint8_t* source, size_t width, unsigned int rapport,
+                   uint8_t* destination)
+{
+    size_t x = 0;
+
+#if defined(__SSE2__)
+    if (rapport == 2 || rapport == 4)
+    {
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i valeurs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+            __m128i bas = _mm_unpacklo_epi8(valeurs, valeurs);
+            __m128i haut = _mm_unpackhi_epi8(valeurs, valeurs);
+            __m128i* sortie = reinterpret_cast<__m128i*>(destination);
+            if (rapport == 2)
+            {
+                _mm_storeu_si128(sortie, bas);
+                _mm_storeu_si128(sortie + 1, haut);
+            }
+            else
+            {
+                _mm_storeu_si128(sortie, _mm_unpacklo_epi16(bas, bas));
+                _mm_storeu_si128(sortie + 1, _mm_unpackhi_epi16(bas, bas));
+                _mm_storeu_si128(sortie + 2, _mm_unpacklo_epi16(haut, haut));
+                _mm_storeu_si128(sortie + 3, _mm_unpackhi_epi16(haut, haut));
+            }
+            destination += 16 * rapport;
+        }
+    }
+#endif
+
+    agrandirLigne<uint8_t>(source + x, width - x, rapport, destination);
+}
+
+/**
+ * @brief agrandissement d'une ligne de pixels (3 octets chacun). Avec SSSE3,
+ * le rapport 2 traite 5 pixels par iteration avec deux pshufb. Sinon, le
+ * premier pixel de chaque groupe est ecrit puis recopie par blocs doublants.
+ */
+void agrandirLigne(const Pixel* source, size_t width, unsigned int rapport, Pixel* destination)
+{
+    size_t x = 0;
+
+#if defined(__SSSE3__)
+    if (rapport == 2)
+    {
+        const __m128i debut = _mm_setr_epi8(0, 1, 2, 0, 1, 2, 3, 4, 5, 3, 4, 5, 6, 7, 8, 6);
+        const __m128i suite = _mm_setr_epi8(7, 8, 9, 10, 11, 9, 10, 11, 12, 13, 14, 12, 13, 14,
+                                            -1, -1);
+        const uint8_t* octets = reinterpret_cast<const uint8_t*>(source);
+        uint8_t* sortie = reinterpret_cast<uint8_t*>(destination);
+
+        // Chaque iteration lit 16 octets et en ecrit 32 : il faut un pixel de plus
+        // que les 5 traites pour ne deborder ni de la source ni de la destination
+        for (; x + 6 <= width; x += 5, sortie += 30)
+        {
+            __m128i valeurs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(octets + 3 * x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sortie), _mm_shuffle_epi8(valeurs, debut));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sortie + 16),
+                             _mm_shuffle_epi8(valeurs, suite));
+        }
+        destination = reinterpret_cast<Pixel*>(sortie);
+    }
+#endif
+
+    if (rapport == 0)
+        return;
+
+    const uint8_t* octets = reinterpret_cast<const uint8_t*>(source);
+    uint8_t* sortie = reinterpret_cast<uint8_t*>(destination);
+    for (; x < width; ++x, sortie += sizeof(Pixel) * rapport)
+    {
+        std::memcpy(sortie, octets + sizeof(Pixel) * x, sizeof(Pixel));
+        for (unsigned int copies = 1; copies < rapport; copies *= 2)
+            std::memcpy(sortie + sizeof(Pixel) * copies, sortie,
+                        sizeof(Pixel) * std::min(copies, rapport - copies));
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Titre : ComparerLigne.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "ComparerLigne.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+#if defined(__SSE2__)
+    // Un bit par octet egal dans les 16 octets a premiere et seconde
+    unsigned masqueEgaux(const uint8_t* premiere, const uint8_t* seconde)
+    {
+        __m128i gauche = _mm_loadu_si128(reinterpret_cast<const __m128i*>(premiere));
+        __m128i droite = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seconde));
+        return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(gauche, droite)));
+    }
+
+    // Vrai si les 64 octets a premiere et seconde sont identiques
+    bool blocIdentique(const uint8_t* premiere, const uint8_t* seconde)
+    {
+        __m128i egaux = _mm_set1_epi8(-1);
+        for (size_t i = 0; i < 64; i += 16)
+        {
+            __m128i gauche = _mm_loadu_si128(reinterpret_cast<const __m128i*>(premiere + i));
+            __m128i droite = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seconde + i));
+            egaux = _mm_and_si128(egaux, _mm_cmpeq_epi8(gauche, droite));
+        }
+        return _mm_movemask_epi8(egaux) == 0xFFFF;
+    }
+#endif
+} // namespace
+
+size_t trouverPremiereDifference(const uint8_t* premiere, const uint8_t* seconde, size_t taille)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    while (i + 64 <= taille && blocIdentique(premiere + i, seconde + i))
+        i += 64;
+    for (; i + 16 <= taille; i += 16)
+    {
+        unsigned differents = ~masqueEgaux(premiere + i, seconde + i) & 0xFFFF;
+        if (differents != 0)
+            return i + size_t(__builtin_ctz(differents));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        if (premiere[i] != seconde[i])
+            return i;
+    return taille;
+}
+
+size_t trouverFinDifferences(const uint8_t* premiere, const uint8_t* seconde, size_t taille)
+{
+    size_t fin = taille;
+
+#if defined(__SSE2__)
+    while (fin >= 64 && blocIdentique(premiere + fin - 64, seconde + fin - 64))
+        fin -= 64;
+    for (; fin >= 16; fin -= 16)
+    {
+        unsigned differents = ~masqueEgaux(premiere + fin - 16, seconde + fin - 16) & 0xFFFF;
+        if (differents != 0)
+            return fin - 16 + size_t(32 - __builtin_clz(differents));
+    }
+#endif
+
+    for (; fin > 0; --fin)
+        if (premiere[fin - 1] != seconde[fin - 1])
+            return fin;
+    return 0;
+}
+
+size_t compterDifferences(const uint8_t* premiere, const uint8_t* seconde, size_t nombre,
+                          size_t tailleElement)
+{
+    size_t differences = 0;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // 16 elements a la fois : un bit par octet different, puis les bits d'un
+    // element sont reunis sur son premier octet et comptes
+    if (tailleElement >= 1 && tailleElement <= 4)
+    {
+        uint64_t premiersOctets = 0;
+        for (size_t element = 0; element < 16; ++element)
+            premiersOctets |= uint64_t(1) << (element * tailleElement);
+
+        for (; i + 16 <= nombre; i += 16)
+        {
+            const uint8_t* gauche = premiere + i * tailleElement;
+            const uint8_t* droite = seconde + i * tailleElement;
+            uint64_t differents = 0;
+            for (size_t bloc = 0; bloc < tailleElement; ++bloc)
+                differents |= uint64_t(~masqueEgaux(gauche + 16 * bloc, droite + 16 * bloc) &
+                                       0xFFFF)
+                              << (16 * bloc);
+
+            uint64_t elements = differents;
+            for (size_t octet = 1; octet < tailleElement; ++octet)
+                elements |= differents >> octet;
+            differences += size_t(__builtin_popcountll(elements & premiersOctets));
+        }
+    }
+#endif
+
+    for (; i < nombre; ++i)
+        differences += std::memcmp(premiere + i * tailleElement, seconde + i * tailleElement,
+                                   tailleElement) != 0;
+    return differences;
+}
@@ -0,0 +1,93 @@
+/*
+ * Titre : ConvolutionLigne.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "ConvolutionLigne.h"
+
+#include "CanauxElement.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void accumulerLigne(float* somme, const float* entree, float poids, size_t taille)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256 poids8 = _mm256_set1_ps(poids);
+    for (; i + 8 <= taille; i += 8)
+    {
+        __m256 produit = _mm256_mul_ps(poids8, _mm256_loadu_ps(entree + i));
+        _mm256_storeu_ps(somme + i, _mm256_add_ps(_mm256_loadu_ps(somme + i), produit));
+    }
+#elif defined(__SSE2__)
+    const __m128 poids4 = _mm_set1_ps(poids);
+    for (; i + 4 <= taille; i += 4)
+    {
+        __m128 produit = _mm_mul_ps(poids4, _mm_loadu_ps(entree + i));
+        _mm_storeu_ps(somme + i, _mm_add_ps(_mm_loadu_ps(somme + i), produit));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        somme[i] += poids * entree[i];
+}
+
+void octetsVersFloat(const uint8_t* octets, size_t taille, float* valeurs)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 8 <= taille; i += 8)
+    {
+        __m128i huit = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(octets + i));
+        _mm256_storeu_ps(valeurs + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(huit)));
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= taille; i += 16)
+    {
+        __m128i seize = _mm_loadu_si128(reinterpret_cast<const __m128i*>(octets + i));
+        __m128i bas = _mm_unpacklo_epi8(seize, zero);
+        __m128i haut = _mm_unpackhi_epi8(seize, zero);
+        _mm_storeu_ps(valeurs + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(bas, zero)));
+        _mm_storeu_ps(valeurs + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(bas, zero)));
+        _mm_storeu_ps(valeurs + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(haut, zero)));
+        _mm_storeu_ps(valeurs + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(haut, zero)));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        valeurs[i] = octets[i];
+}
+
+void floatVersOctets(const float* valeurs, size_t taille, uint8_t* octets)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // Borner a [0, 255] puis tronquer v + 0.5 donne le meme arrondi que
+    // CanauxElement<uint8_t>::ecrire
+    const __m128 minimum = _mm_setzero_ps();
+    const __m128 maximum = _mm_set1_ps(255.0f);
+    const __m128 demi = _mm_set1_ps(0.5f);
+    auto convertir = [&](const float* quatre) {
+        __m128 valeur = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(quatre), minimum), maximum);
+        return _mm_cvttps_epi32(_mm_add_ps(valeur, demi));
+    };
+    for (; i + 16 <= taille; i += 16)
+    {
+        __m128i bas = _mm_packs_epi32(convertir(valeurs + i), convertir(valeurs + i + 4));
+        __m128i haut = _mm_packs_epi32(convertir(valeurs + i + 8), convertir(valeurs + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(octets + i), _mm_packus_epi16(bas, haut));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        octets[i] = CanauxElement<uint8_t>::ecrire(valeurs + i);
+}
@@ -0,0 +1,175 @@
+/*
+ * Titre : CouleurInternee.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "CouleurInternee.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * @brief noms des couleurs, ranges par identifiant ; une std::deque ne
+     * deplace pas ses elements en grandissant, l'index et les appelants de
+     * getNom peuvent donc pointer directement sur eux. Les recherches se
+     * partagent le verrou, un ajout le prend seul.
+     */
+    struct TableNoms
+    {
+        TableNoms() { ajouter("Noir"); }
+
+        uint32_t ajouter(std::string_view nom)
+        {
+            uint32_t identifiant = uint32_t(noms.size());
+            noms.emplace_back(nom);
+            index.emplace(noms.back(), identifiant);
+            return identifiant;
+        }
+
+        std::deque<std::string> noms;
+        std::unordered_map<std::string_view, uint32_t> index;
+        std::shared_mutex verrou;
+    };
+
+    TableNoms& table()
+    {
+        static TableNoms table;
+        return table;
+    }
+} // namespace
+
+/**
+ * @brief constructeur par défaut de la classe, la couleur est "Noir"
+ */
+CouleurInternee::CouleurInternee()
+    : identifiant_(0)
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ * @param nom, le nom de la couleur, ajoute a la table s'il n'y est pas
+ */
+CouleurInternee::CouleurInternee(const std::string& nom)
+    : identifiant_(interner(nom.data(), nom.data() + nom.size()))
+{
+}
+
+/**
+ * @brief constructeur par conversion d'une Couleur
+ */
+CouleurInternee::CouleurInternee(const Couleur& couleur)
+    : CouleurInternee(couleur.couleur_)
+{
+}
+
+/**
+ * @brief constructeur sur un identifiant deja present dans la table
+ */
+CouleurInternee::CouleurInternee(uint32_t identifiant)
+    : identifiant_(identifiant)
+{
+}
+
+/**
+ * @brief retourne la Couleur du meme nom
+ */
+Couleur CouleurInternee::versCouleur() const
+{
+    return Couleur(getNom());
+}
+
+/**
+ * @brief retourne le nom de la couleur, range dans la table
+ */
+const std::string& CouleurInternee::getNom() const
+{
+    TableNoms& noms = table();
+    std::shared_lock<std::shared_mutex> lecture(noms.verrou);
+    return noms.noms[identifiant_];
+}
+
+/**
+ * @brief retourne l'identifiant du nom [debut, fin), en l'ajoutant a la
+ * table s'il n'y est pas encore
+ */
+uint32_t CouleurInternee::interner(const char* debut, const char* fin)
+{
+    std::string_view nom(debut, size_t(fin - debut));
+    TableNoms& noms = table();
+    {
+        std::shared_lock<std::shared_mutex> lecture(noms.verrou);
+        auto trouve = noms.index.find(nom);
+        if (trouve != noms.index.end())
+            return trouve->second;
+    }
+
+    // Un autre thread a pu ajouter le meme nom entre les deux verrous
+    std::unique_lock<std::shared_mutex> ecriture(noms.verrou);
+    auto trouve = noms.index.find(nom);
+    if (trouve != noms.index.end())
+        return trouve->second;
+    return noms.ajouter(nom);
+}
+
+/**
+ * @brief retourne le nombre de noms distincts internes jusqu'ici
+ */
+size_t CouleurInternee::getNombreNoms()
+{
+    TableNoms& noms = table();
+    std::shared_lock<std::shared_mutex> lecture(noms.verrou);
+    return noms.noms.size();
+}
+
+/**
+ * @brief Operateur << : affiche le nom comme l'operateur de Couleur
+ */
+std::ostream& operator<<(std::ostream& os, CouleurInternee couleur)
+{
+    os << std::setw(10) << std::setfill(' ') << couleur.getNom();
+    return os;
+}
+
+/**
+ * @brief Operateur >> : lit un mot et l'interne
+ */
+std::istream& operator>>(std::istream& is, CouleurInternee& couleur)
+{
+    std::string nom;
+    if (is >> nom)
+        couleur = CouleurInternee(nom);
+    return is;
+}
+
+void LectureElement<CouleurInternee>::lire(const char* debut, const char* fin,
+                                           CouleurInternee& couleur)
+{
+    debut = lecture::ignorerEspaces(debut, fin);
+    const char* finMot = debut;
+    while (finMot != fin && *finMot != ' ' && *finMot != '\t' && *finMot != '\r')
+        ++finMot;
+    if (finMot != debut)
+        couleur = CouleurInternee(CouleurInternee::interner(debut, finMot));
+}
+
+void EcritureElement<CouleurInternee>::afficher(const CouleurInternee& couleur,
+                                                std::string& tampon)
+{
+    const std::string& nom = couleur.getNom();
+    if (nom.size() < 10)
+        tampon.append(10 - nom.size(), ' ');
+    tampon += nom;
+}
+
+void EcritureElement<CouleurInternee>::ecrire(const CouleurInternee& couleur,
+                                              std::string& tampon)
+{
+    tampon += couleur.getNom();
+}
@@ -0,0 +1,275 @@
+/*
+ * Titre : CouleurLigne.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "CouleurLigne.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    static constexpr size_t NOMBRE_CANAUX = 3;
+
+#if defined(__SSSE3__)
+    /**
+     * @brief masques pshufb qui extraient d'un bloc de 16 octets entrelaces
+     * (le bloc numero bloc d'un groupe de 16 pixels) les octets d'un canal
+     */
+    struct MasquesCanaux
+    {
+        alignas(16) int8_t separer[NOMBRE_CANAUX][3][16];
+        alignas(16) int8_t entrelacer[3][NOMBRE_CANAUX][16];
+
+        MasquesCanaux()
+        {
+            for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+                for (size_t bloc = 0; bloc < 3; ++bloc)
+                    for (size_t i = 0; i < 16; ++i)
+                    {
+                        // Pixel i du plan, a l'octet 3 * i + canal du groupe
+                        size_t octet = 3 * i + canal;
+                        separer[canal][bloc][i] =
+                            octet / 16 == bloc ? int8_t(octet % 16) : int8_t(-1);
+                        // Octet i du bloc entrelace, pris dans le plan de son canal
+                        octet = 16 * bloc + i;
+                        entrelacer[bloc][canal][i] =
+                            octet % 3 == canal ? int8_t(octet / 3) : int8_t(-1);
+                    }
+        }
+    };
+
+    const MasquesCanaux MASQUES;
+
+    __m128i charger(const int8_t* masque)
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(masque));
+    }
+#endif
+} // namespace
+
+void separerCanaux(const uint8_t* source, size_t width, uint8_t* const* plans)
+{
+    size_t x = 0;
+
+#if defined(__SSSE3__)
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i* entree = reinterpret_cast<const __m128i*>(source + 3 * x);
+        __m128i blocs[3] = {_mm_loadu_si128(entree), _mm_loadu_si128(entree + 1),
+                            _mm_loadu_si128(entree + 2)};
+        for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+        {
+            __m128i valeurs = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(blocs[0], charger(MASQUES.separer[canal][0])),
+                             _mm_shuffle_epi8(blocs[1], charger(MASQUES.separer[canal][1]))),
+                _mm_shuffle_epi8(blocs[2], charger(MASQUES.separer[canal][2])));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(plans[canal] + x), valeurs);
+        }
+    }
+#endif
+
+    for (; x < width; ++x)
+        for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+            plans[canal][x] = source[3 * x + canal];
+}
+
+void entrelacerCanaux(const uint8_t* const* plans, size_t width, uint8_t* destination)
+{
+    size_t x = 0;
+
+#if defined(__SSSE3__)
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i canaux[NOMBRE_CANAUX];
+        for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+            canaux[canal] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plans[canal] + x));
+
+        __m128i* sortie = reinterpret_cast<__m128i*>(destination + 3 * x);
+        for (size_t bloc = 0; bloc < 3; ++bloc)
+        {
+            __m128i valeurs = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(canaux[0], charger(MASQUES.entrelacer[bloc][0])),
+                             _mm_shuffle_epi8(canaux[1], charger(MASQUES.entrelacer[bloc][1]))),
+                _mm_shuffle_epi8(canaux[2], charger(MASQUES.entrelacer[bloc][2])));
+            _mm_storeu_si128(sortie + bloc, valeurs);
+        }
+    }
+#endif
+
+    for (; x < width; ++x)
+        for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+            destination[3 * x + canal] = plans[canal][x];
+}
+
+/**
+ * @brief avec SSSE3, chaque groupe de 16 pixels (48 octets) est recompose par
+ * quatre pshufb sur des fenetres de 16 octets commencant aux octets 0, 15, 30
+ * et 33 ; toutes les fenetres sont lues avant la premiere ecriture
+ */
+void permuterCanaux(uint8_t* octets, size_t width, const size_t* ordre)
+{
+    size_t x = 0;
+
+#if defined(__SSSE3__)
+    // Une fenetre commence sur un pixel ; son 16e octet (pixel suivant) est
+    // recopie tel quel et reecrit ensuite par la fenetre ou le groupe suivant
+    alignas(16) int8_t indices[16];
+    for (size_t i = 0; i < 15; ++i)
+        indices[i] = int8_t(i - i % 3 + ordre[i % 3]);
+    indices[15] = 15;
+    const __m128i masque = charger(indices);
+    const size_t debuts[4] = {0, 15, 30, 33};
+
+    // La derniere fenetre deborde d'un octet sur le pixel qui suit le groupe
+    for (; x + 17 <= width; x += 16)
+    {
+        __m128i* blocs[4];
+        __m128i valeurs[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            blocs[i] = reinterpret_cast<__m128i*>(octets + 3 * x + debuts[i]);
+            valeurs[i] = _mm_shuffle_epi8(_mm_loadu_si128(blocs[i]), masque);
+        }
+        for (size_t i = 0; i < 4; ++i)
+            _mm_storeu_si128(blocs[i], valeurs[i]);
+    }
+#endif
+
+    for (; x < width; ++x)
+    {
+        uint8_t pixel[NOMBRE_CANAUX] = {octets[3 * x], octets[3 * x + 1], octets[3 * x + 2]};
+        for (size_t canal = 0; canal < NOMBRE_CANAUX; ++canal)
+            octets[3 * x + canal] = pixel[ordre[canal]];
+    }
+}
+
+/**
+ * @brief un decalage positif est une addition saturee (paddusb), un decalage
+ * negatif une soustraction saturee (psubusb)
+ */
+void decalerOctets(uint8_t* octets, size_t taille, int decalage)
+{
+    bool positif = decalage >= 0;
+    uint8_t valeur = uint8_t(std::min(positif ? decalage : -decalage, 255));
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i decalages = _mm256_set1_epi8(char(valeur));
+    for (; i + 32 <= taille; i += 32)
+    {
+        __m256i* bloc = reinterpret_cast<__m256i*>(octets + i);
+        __m256i valeurs = _mm256_loadu_si256(bloc);
+        _mm256_storeu_si256(bloc, positif ? _mm256_adds_epu8(valeurs, decalages)
+                                          : _mm256_subs_epu8(valeurs, decalages));
+    }
+#elif defined(__SSE2__)
+    const __m128i decalages = _mm_set1_epi8(char(valeur));
+    for (; i + 16 <= taille; i += 16)
+    {
+        __m128i* bloc = reinterpret_cast<__m128i*>(octets + i);
+        __m128i valeurs = _mm_loadu_si128(bloc);
+        _mm_storeu_si128(bloc, positif ? _mm_adds_epu8(valeurs, decalages)
+                                       : _mm_subs_epu8(valeurs, decalages));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        octets[i] = positif ? uint8_t(std::min(octets[i] + valeur, 255))
+                            : uint8_t(std::max(octets[i] - valeur, 0));
+}
+
+void additionnerOctets(uint8_t* octets, const uint8_t* autres, size_t taille)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= taille; i += 32)
+    {
+        __m256i* bloc = reinterpret_cast<__m256i*>(octets + i);
+        __m256i autre = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(autres + i));
+        _mm256_storeu_si256(bloc, _mm256_adds_epu8(_mm256_loadu_si256(bloc), autre));
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= taille; i += 16)
+    {
+        __m128i* bloc = reinterpret_cast<__m128i*>(octets + i);
+        __m128i autre = _mm_loadu_si128(reinterpret_cast<const __m128i*>(autres + i));
+        _mm_storeu_si128(bloc, _mm_adds_epu8(_mm_loadu_si128(bloc), autre));
+    }
+#endif
+
+    for (; i < taille; ++i)
+        octets[i] = uint8_t(std::min(octets[i] + autres[i], 255));
+}
+
+/**
+ * @brief la table de 256 octets tient dans le cache L1 ; la boucle est deroulee
+ * par quatre pour que les lectures de la table se chevauchent
+ */
+void appliquerTable(uint8_t* octets, size_t taille, const uint8_t* table)
+{
+    size_t i = 0;
+    for (; i + 4 <= taille; i += 4)
+    {
+        uint8_t a = table[octets[i]];
+        uint8_t b = table[octets[i + 1]];
+        uint8_t c = table[octets[i + 2]];
+        uint8_t d = table[octets[i + 3]];
+        octets[i] = a;
+        octets[i + 1] = b;
+        octets[i + 2] = c;
+        octets[i + 3] = d;
+    }
+    for (; i < taille; ++i)
+        octets[i] = table[octets[i]];
+}
+
+/**
+ * @brief les produits sont calcules sur 16 bits (pmullw) : 255 * 256 + 128
+ * tient dans un mot non signe
+ */
+void calculerGris(const uint8_t* rouge, const uint8_t* vert, const uint8_t* bleu, size_t width,
+                  uint8_t* gris)
+{
+    size_t x = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i poidsRouge = _mm_set1_epi16(77);
+    const __m128i poidsVert = _mm_set1_epi16(150);
+    const __m128i poidsBleu = _mm_set1_epi16(29);
+    const __m128i arrondi = _mm_set1_epi16(128);
+
+    auto luminance = [&](__m128i r, __m128i g, __m128i b) {
+        __m128i somme = _mm_add_epi16(_mm_mullo_epi16(r, poidsRouge),
+                                      _mm_mullo_epi16(g, poidsVert));
+        somme = _mm_add_epi16(somme, _mm_mullo_epi16(b, poidsBleu));
+        return _mm_srli_epi16(_mm_add_epi16(somme, arrondi), 8);
+    };
+
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rouge + x));
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vert + x));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bleu + x));
+        __m128i bas = luminance(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero),
+                                _mm_unpacklo_epi8(b, zero));
+        __m128i haut = luminance(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero),
+                                 _mm_unpackhi_epi8(b, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(gris + x), _mm_packus_epi16(bas, haut));
+    }
+#endif
+
+    for (; x < width; ++x)
+        gris[x] = uint8_t((77 * rouge[x] + 150 * vert[x] + 29 * bleu[x] + 128) >> 8);
+}
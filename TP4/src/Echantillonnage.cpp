@@ -0,0 +1,110 @@
+/*
+ * Titre : Echantillonnage.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "Echantillonnage.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief rayon du filtre, en elements sources, lorsque la taille ne change pas
+     */
+    double rayonFiltre(Filtre filtre)
+    {
+        return filtre == Filtre::Bilinear ? 1.0 : 0.5;
+    }
+
+    /**
+     * @brief valeur du filtre Bilinear a la distance (normalisee) distance du centre
+     */
+    double evaluerFiltre(double distance)
+    {
+        return std::max(0.0, 1.0 - std::abs(distance));
+    }
+
+    /**
+     * @brief part de l'element source k, l'intervalle [k, k + 1), couverte par
+     * l'intervalle [debut, fin)
+     */
+    double couvrir(size_t k, double debut, double fin)
+    {
+        return std::max(0.0, std::min(double(k) + 1.0, fin) - std::max(double(k), debut));
+    }
+} // namespace
+
+/**
+ * @brief calcule les poids du redimensionnement d'un axe de tailleSource a
+ * tailleDestination elements. Avec Box, l'element destination i couvre
+ * l'intervalle source [i * rapport, (i + 1) * rapport) et chaque element
+ * source pese la part de lui-meme qu'il y occupe. Avec Bilinear, le filtre
+ * est elargi du rapport de reduction pour couvrir tous les elements sources
+ * (anticrenelage).
+ * @param filtre, Box ou Bilinear ; NearestNeighbour donne un seul poids par element
+ */
+Echantillonnage calculerEchantillonnage(size_t tailleSource, size_t tailleDestination,
+                                        Filtre filtre)
+{
+    Echantillonnage echantillonnage;
+    double rapport = double(tailleSource) / double(tailleDestination);
+    double echelleFiltre = std::max(rapport, 1.0);
+    double rayon = filtre == Filtre::NearestNeighbour ? 0.0 : rayonFiltre(filtre) * echelleFiltre;
+
+    echantillonnage.nombreMax = size_t(std::ceil(rayon)) * 2 + 1;
+    echantillonnage.premier.resize(tailleDestination);
+    echantillonnage.nombre.resize(tailleDestination);
+    echantillonnage.poids.assign(tailleDestination * echantillonnage.nombreMax, 0.0f);
+
+    for (size_t i = 0; i < tailleDestination; ++i)
+    {
+        double centre = (double(i) + 0.5) * rapport;
+        float* poids = &echantillonnage.poids[i * echantillonnage.nombreMax];
+
+        if (filtre == Filtre::NearestNeighbour)
+        {
+            echantillonnage.premier[i] = std::min(size_t(centre), tailleSource - 1);
+            echantillonnage.nombre[i] = 1;
+            poids[0] = 1.0f;
+            continue;
+        }
+
+        // Intervalle source couvert par l'element destination (Box)
+        double debut = double(i) * rapport;
+        double fin = double(i + 1) * rapport;
+        size_t premier = filtre == Filtre::Box ? size_t(debut)
+                                               : size_t(std::max(centre - rayon + 0.5, 0.0));
+        size_t dernier = filtre == Filtre::Box ? size_t(std::ceil(fin))
+                                               : size_t(std::max(centre + rayon + 0.5, 0.0));
+        dernier = std::min(std::min(dernier, tailleSource), premier + echantillonnage.nombreMax);
+
+        double total = 0.0;
+        for (size_t k = premier; k < dernier; ++k)
+        {
+            double valeur = filtre == Filtre::Box
+                                ? couvrir(k, debut, fin)
+                                : evaluerFiltre((double(k) + 0.5 - centre) / echelleFiltre);
+            poids[k - premier] = float(valeur);
+            total += valeur;
+        }
+
+        // Aucun poids non nul (bord de l'image) : l'element le plus proche est copie
+        if (total <= 0.0)
+        {
+            premier = std::min(size_t(centre), tailleSource - 1);
+            dernier = premier + 1;
+            poids[0] = 1.0f;
+            total = 1.0;
+        }
+        for (size_t k = 0; k < dernier - premier; ++k)
+            poids[k] = float(poids[k] / total);
+
+        echantillonnage.premier[i] = premier;
+        echantillonnage.nombre[i] = dernier - premier;
+    }
+
+    return echantillonnage;
+}
@@ -0,0 +1,63 @@
+/*
+ * Titre : FichierBinaire.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "FichierBinaire.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+/**
+ * @brief sans mmap, le fichier est lu d'un bloc dans un tampon aligne
+ */
+std::shared_ptr<void> projeterFichier(const std::string& nomFichier, size_t& taille)
+{
+    std::ifstream file(nomFichier, std::ios::binary | std::ios::ate);
+    if (!file || file.tellg() <= 0)
+        return nullptr;
+
+    taille = static_cast<size_t>(file.tellg());
+    std::shared_ptr<char> tampon(new char[taille], std::default_delete<char[]>());
+    file.seekg(0);
+    if (!file.read(tampon.get(), static_cast<std::streamsize>(taille)))
+        return nullptr;
+
+    return tampon;
+}
+#else
+std::shared_ptr<void> projeterFichier(const std::string& nomFichier, size_t& taille)
+{
+    int descripteur = open(nomFichier.c_str(), O_RDONLY);
+    if (descripteur < 0)
+        return nullptr;
+
+    struct stat etat;
+    if (fstat(descripteur, &etat) != 0 || etat.st_size <= 0)
+    {
+        close(descripteur);
+        return nullptr;
+    }
+
+    size_t tailleFichier = static_cast<size_t>(etat.st_size);
+    void* projection =
+        mmap(nullptr, tailleFichier, PROT_READ | PROT_WRITE, MAP_PRIVATE, descripteur, 0);
+    // La projection reste valide apres la fermeture du descripteur
+    close(descripteur);
+    if (projection == MAP_FAILED)
+        return nullptr;
+
+    taille = tailleFichier;
+    return std::shared_ptr<void>(projection, [tailleFichier](void* debut) {
+        munmap(debut, tailleFichier);
+    });
+}
+#endif
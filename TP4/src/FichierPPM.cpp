@@ -0,0 +1,259 @@
+/*
+ * Titre : FichierPPM.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "FichierPPM.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace
+{
+    using Traits = std::char_traits<char>;
+
+    // Taille des blocs lus directement dans le tampon d'une image P6
+    static constexpr size_t TAILLE_BLOC = 1 << 20;
+    // Longueur maximale d'une ligne d'une image P3
+    static constexpr size_t LONGUEUR_LIGNE = 70;
+    // Plus grand nombre lu, au-dela de toute dimension ou composante raisonnable
+    static constexpr uint32_t NOMBRE_MAXIMAL = 1u << 28;
+
+    bool estEspace(Traits::int_type caractere)
+    {
+        return caractere == ' ' || caractere == '\n' || caractere == '\r' || caractere == '\t' ||
+               caractere == '\v' || caractere == '\f';
+    }
+
+    /**
+     * @brief lit un nombre decimal precede d'espaces et de commentaires ; le
+     * caractere qui le suit, un espace ou la fin du flux, est consomme
+     */
+    bool lireNombre(std::streambuf& tampon, uint32_t& valeur)
+    {
+        Traits::int_type caractere = tampon.sbumpc();
+        while (estEspace(caractere) || caractere == '#')
+        {
+            if (caractere == '#')
+                while (caractere != '\n' && caractere != '\r' && caractere != Traits::eof())
+                    caractere = tampon.sbumpc();
+            caractere = tampon.sbumpc();
+        }
+
+        if (caractere < '0' || caractere > '9')
+            return false;
+        valeur = 0;
+        for (; caractere >= '0' && caractere <= '9'; caractere = tampon.sbumpc())
+        {
+            valeur = valeur * 10 + uint32_t(caractere - '0');
+            if (valeur > NOMBRE_MAXIMAL)
+                return false;
+        }
+        return estEspace(caractere) || caractere == Traits::eof();
+    }
+
+    /**
+     * @brief ramene une composante entre 0 et maximum a une composante entre 0 et 255
+     */
+    uint8_t ramener(uint32_t composante, uint32_t maximum)
+    {
+        return uint8_t((composante * 255 + maximum / 2) / maximum);
+    }
+
+    /**
+     * @brief lit taille octets du flux, par blocs de TAILLE_BLOC
+     */
+    bool lireOctets(std::streambuf& tampon, uint8_t* octets, size_t taille)
+    {
+        while (taille != 0)
+        {
+            size_t bloc = std::min(taille, TAILLE_BLOC);
+            if (tampon.sgetn(reinterpret_cast<char*>(octets), std::streamsize(bloc)) !=
+                std::streamsize(bloc))
+                return false;
+            octets += bloc;
+            taille -= bloc;
+        }
+        return true;
+    }
+
+    /**
+     * @brief composantes d'une image P6 : un octet chacune jusqu'a 255, deux
+     * (poids fort en premier) au-dela
+     */
+    bool lireBinaire(std::streambuf& tampon, uint8_t* octets, size_t height, size_t width,
+                     uint32_t maximum)
+    {
+        size_t taille = height * width * 3;
+        if (maximum < 256)
+        {
+            if (!lireOctets(tampon, octets, taille))
+                return false;
+            if (maximum != 255)
+            {
+                uint8_t table[256];
+                for (uint32_t valeur = 0; valeur < 256; ++valeur)
+                    table[valeur] = ramener(std::min(valeur, maximum), maximum);
+                for (size_t i = 0; i < taille; ++i)
+                {
+                    if (octets[i] > maximum)
+                        return false;
+                    octets[i] = table[octets[i]];
+                }
+            }
+            return true;
+        }
+
+        // Deux octets par composante : une ligne a la fois dans un tampon
+        std::vector<uint8_t> ligne(width * 6);
+        for (size_t h = 0; h < height; ++h, octets += width * 3)
+        {
+            if (!lireOctets(tampon, ligne.data(), ligne.size()))
+                return false;
+            for (size_t i = 0; i < width * 3; ++i)
+            {
+                uint32_t composante = uint32_t(ligne[2 * i]) << 8 | ligne[2 * i + 1];
+                if (composante > maximum)
+                    return false;
+                octets[i] = ramener(composante, maximum);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief composantes d'une image P3, en decimal
+     */
+    bool lireTexte(std::streambuf& tampon, uint8_t* octets, size_t taille, uint32_t maximum)
+    {
+        for (size_t i = 0; i < taille; ++i)
+        {
+            uint32_t composante = 0;
+            if (!lireNombre(tampon, composante) || composante > maximum)
+                return false;
+            octets[i] = maximum == 255 ? uint8_t(composante) : ramener(composante, maximum);
+        }
+        return true;
+    }
+} // namespace
+
+bool lirePPM(std::istream& is, Matrice<Pixel>& matrice)
+{
+    std::streambuf* tampon = is.rdbuf();
+    if (!is || tampon == nullptr)
+        return false;
+
+    Traits::int_type p = tampon->sbumpc();
+    Traits::int_type variante = tampon->sbumpc();
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t maximum = 0;
+    if (p != 'P' || (variante != '3' && variante != '6') || !lireNombre(*tampon, width) ||
+        !lireNombre(*tampon, height) || !lireNombre(*tampon, maximum) || maximum == 0 ||
+        maximum > 65535 || (width != 0 && height > std::numeric_limits<size_t>::max() / 6 / width))
+    {
+        is.setstate(std::ios::failbit);
+        return false;
+    }
+
+    // Tampon non initialise, garde en vie par la matrice comme une projection ;
+    // des dimensions demesurees echouent ici plutot que de lancer bad_alloc
+    size_t taille = size_t(height) * width * 3;
+    std::shared_ptr<uint8_t> octets(new (std::nothrow) uint8_t[std::max<size_t>(taille, 1)],
+                                    std::default_delete<uint8_t[]>());
+    if (!octets || !(variante == '6'
+                         ? lireBinaire(*tampon, octets.get(), height, width, maximum)
+                         : lireTexte(*tampon, octets.get(), taille, maximum)))
+    {
+        is.setstate(std::ios::failbit);
+        return false;
+    }
+
+    Pixel* donnees = reinterpret_cast<Pixel*>(octets.get());
+    Matrice<Pixel> image(std::move(octets), donnees, height, width, width);
+    matrice.echanger(image);
+    return true;
+}
+
+bool ecrirePPM(std::ostream& os, const Matrice<Pixel>& matrice, FormatPPM format)
+{
+    size_t height = matrice.getHeight();
+    size_t width = matrice.getWidth();
+    std::string tampon = format == FormatPPM::Binaire ? "P6\n" : "P3\n";
+    tampon.reserve(ecriture::TAILLE_BLOC + LONGUEUR_LIGNE);
+    tampon += std::to_string(width) + ' ' + std::to_string(height) + "\n255\n";
+
+    if (format == FormatPPM::Binaire)
+    {
+        ecriture::vider(tampon, os, true);
+        // Les lignes sont deja dans l'ordre R, G, B du format
+        if (matrice.getStride() == width && height != 0)
+            os.write(reinterpret_cast<const char*>(matrice.getLigne(0)),
+                     std::streamsize(height * width * 3));
+        else
+            for (size_t h = 0; h < height; ++h)
+                os.write(reinterpret_cast<const char*>(matrice.getLigne(h)),
+                         std::streamsize(width * 3));
+        return bool(os);
+    }
+
+    // Texte decimal des 256 valeurs d'une composante
+    struct TexteOctet
+    {
+        char texte[3];
+        size_t taille;
+    } octets[256];
+    for (int valeur = 0; valeur < 256; ++valeur)
+        octets[valeur].taille = size_t(
+            std::to_chars(octets[valeur].texte, octets[valeur].texte + 3, valeur).ptr -
+            octets[valeur].texte);
+
+    for (size_t h = 0; h < height; ++h)
+    {
+        const Pixel* ligne = matrice.getLigne(h);
+        size_t longueur = 0;
+        for (size_t w = 0; w < width; ++w)
+        {
+            // Un pixel et son separateur occupent au plus 12 caracteres
+            if (longueur + 12 > LONGUEUR_LIGNE)
+            {
+                tampon += '\n';
+                longueur = 0;
+            }
+            else if (w != 0)
+                tampon += ' ';
+
+            size_t debut = tampon.size();
+            tampon.append(octets[ligne[w].getRouge()].texte, octets[ligne[w].getRouge()].taille);
+            tampon += ' ';
+            tampon.append(octets[ligne[w].getVert()].texte, octets[ligne[w].getVert()].taille);
+            tampon += ' ';
+            tampon.append(octets[ligne[w].getBleu()].texte, octets[ligne[w].getBleu()].taille);
+            longueur += tampon.size() - debut + 1;
+        }
+        tampon += '\n';
+        ecriture::vider(tampon, os);
+    }
+    ecriture::vider(tampon, os, true);
+    return bool(os);
+}
+
+bool chargerFichierPPM(Matrice<Pixel>& matrice, const std::string& nomFichier)
+{
+    std::ifstream file(nomFichier, std::ios::binary);
+    return lirePPM(file, matrice);
+}
+
+bool sauvegarderFichierPPM(const Matrice<Pixel>& matrice, const std::string& nomFichier,
+                           FormatPPM format)
+{
+    std::ofstream file(nomFichier, std::ios::binary);
+    return ecrirePPM(file, matrice, format);
+}
@@ -0,0 +1,186 @@
+/*
+ * Titre : FichierTuiles.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "FichierTuiles.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Taille des blocs lus puis ecrits par copier()
+    static constexpr size_t TAILLE_COPIE = 1 << 20;
+} // namespace
+
+#ifdef _WIN32
+/**
+ * @brief constructeur par parametre de la classe, le fichier est cree par
+ * std::tmpfile et supprime a sa fermeture
+ * @param tailleTuile, la taille d'un emplacement en octets
+ */
+FichierTuiles::FichierTuiles(size_t tailleTuile)
+    : tailleTuile_(tailleTuile)
+    , nombreEmplacements_(0)
+    , fichier_(std::tmpfile())
+{
+}
+
+FichierTuiles::~FichierTuiles()
+{
+    if (fichier_ != nullptr)
+        std::fclose(fichier_);
+}
+
+bool FichierTuiles::estOuvert() const
+{
+    return fichier_ != nullptr;
+}
+
+bool FichierTuiles::lireOctets(size_t position, void* octets, size_t taille) const
+{
+    return fichier_ != nullptr &&
+           _fseeki64(fichier_, static_cast<long long>(position), SEEK_SET) == 0 &&
+           std::fread(octets, 1, taille, fichier_) == taille;
+}
+
+bool FichierTuiles::ecrireOctets(size_t position, const void* octets, size_t taille)
+{
+    return fichier_ != nullptr &&
+           _fseeki64(fichier_, static_cast<long long>(position), SEEK_SET) == 0 &&
+           std::fwrite(octets, 1, taille, fichier_) == taille;
+}
+#else
+/**
+ * @brief constructeur par parametre de la classe, le fichier est retire du
+ * dossier des sa creation : il disparait avec son descripteur
+ * @param tailleTuile, la taille d'un emplacement en octets
+ */
+FichierTuiles::FichierTuiles(size_t tailleTuile)
+    : tailleTuile_(tailleTuile)
+    , nombreEmplacements_(0)
+    , descripteur_(-1)
+{
+    const char* dossier = std::getenv("TMPDIR");
+    std::string modele = std::string(dossier != nullptr && *dossier != '\0' ? dossier : "/tmp") +
+                         "/tp4_tuiles_XXXXXX";
+    descripteur_ = mkstemp(modele.data());
+    if (descripteur_ >= 0)
+        unlink(modele.c_str());
+}
+
+FichierTuiles::~FichierTuiles()
+{
+    if (descripteur_ >= 0)
+        close(descripteur_);
+}
+
+bool FichierTuiles::estOuvert() const
+{
+    return descripteur_ >= 0;
+}
+
+/**
+ * @brief pread et pwrite peuvent transferer moins que demande : on reprend
+ * jusqu'a la fin ou jusqu'a une erreur
+ */
+bool FichierTuiles::lireOctets(size_t position, void* octets, size_t taille) const
+{
+    char* sortie = static_cast<char*>(octets);
+    while (taille > 0)
+    {
+        ssize_t lus = pread(descripteur_, sortie, taille, static_cast<off_t>(position));
+        if (lus <= 0)
+            return false;
+        sortie += lus;
+        position += size_t(lus);
+        taille -= size_t(lus);
+    }
+    return true;
+}
+
+bool FichierTuiles::ecrireOctets(size_t position, const void* octets, size_t taille)
+{
+    const char* entree = static_cast<const char*>(octets);
+    while (taille > 0)
+    {
+        ssize_t ecrits = pwrite(descripteur_, entree, taille, static_cast<off_t>(position));
+        if (ecrits <= 0)
+            return false;
+        entree += ecrits;
+        position += size_t(ecrits);
+        taille -= size_t(ecrits);
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief retourne un emplacement libre, de preference deja present dans le
+ * fichier ; son contenu est indefini jusqu'a la premiere ecriture
+ */
+size_t FichierTuiles::allouer()
+{
+    if (libres_.empty())
+        return nombreEmplacements_++;
+
+    size_t emplacement = libres_.back();
+    libres_.pop_back();
+    return emplacement;
+}
+
+void FichierTuiles::liberer(size_t emplacement)
+{
+    libres_.push_back(emplacement);
+}
+
+/**
+ * @brief lit une tuile complete
+ * @param emplacement, un emplacement deja ecrit
+ * @param tuile, recoit getTailleTuile() octets
+ */
+bool FichierTuiles::lire(size_t emplacement, void* tuile) const
+{
+    return estOuvert() && lireOctets(emplacement * tailleTuile_, tuile, tailleTuile_);
+}
+
+/**
+ * @brief ecrit une tuile complete
+ * @param emplacement, un emplacement retourne par allouer()
+ * @param tuile, getTailleTuile() octets
+ */
+bool FichierTuiles::ecrire(size_t emplacement, const void* tuile)
+{
+    return estOuvert() && ecrireOctets(emplacement * tailleTuile_, tuile, tailleTuile_);
+}
+
+/**
+ * @brief remplace le contenu du fichier par celui de source, emplacements
+ * libres compris, par blocs sequentiels de TAILLE_COPIE octets
+ * @return false si source n'a pas la meme taille de tuile ou en cas d'erreur
+ */
+bool FichierTuiles::copier(const FichierTuiles& source)
+{
+    if (source.tailleTuile_ != tailleTuile_ || !estOuvert() || !source.estOuvert())
+        return false;
+
+    std::vector<char> bloc(TAILLE_COPIE);
+    size_t taille = source.nombreEmplacements_ * tailleTuile_;
+    for (size_t position = 0; position < taille; position += TAILLE_COPIE)
+    {
+        size_t morceau = std::min(TAILLE_COPIE, taille - position);
+        if (!source.lireOctets(position, bloc.data(), morceau) ||
+            !ecrireOctets(position, bloc.data(), morceau))
+            return false;
+    }
+
+    nombreEmplacements_ = source.nombreEmplacements_;
+    libres_ = source.libres_;
+    return true;
+}
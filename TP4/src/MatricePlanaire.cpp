@@ -0,0 +1,190 @@
+/*
+ * Titre : MatricePlanaire.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "MatricePlanaire.h"
+
+#include <new>
+#include "CouleurLigne.h"
+
+/**
+ * @brief constructeur par défaut de la classe, la matrice est vide
+ */
+MatricePlanaire::MatricePlanaire() = default;
+
+/**
+ * @brief constructeur par paramètres de la classe, tous les pixels sont noirs
+ * @param height, le nombre de lignes
+ * @param width, le nombre de colonnes
+ */
+MatricePlanaire::MatricePlanaire(size_t height, size_t width)
+{
+    reinitialiser(height, width);
+}
+
+/**
+ * @brief constructeur par conversion d'une matrice de pixels entrelaces
+ */
+MatricePlanaire::MatricePlanaire(const Matrice<Pixel>& matrice)
+{
+    depuisEntrelacee(matrice);
+}
+
+/**
+ * @brief constructeur par copie, les plans de la copie sont alignes
+ */
+MatricePlanaire::MatricePlanaire(const MatricePlanaire& matrice)
+    : MatricePlanaire(matrice.getHeight(), matrice.getWidth())
+{
+    for (size_t canal = 0; canal < planaire::NOMBRE_PLANS; ++canal)
+        for (size_t h = 0; h < getHeight(); h++)
+            std::copy(matrice.plans_[canal].getLigne(h),
+                      matrice.plans_[canal].getLigne(h) + getWidth(), plans_[canal].getLigne(h));
+}
+
+/**
+ * @brief operateur d'affectation par copie
+ */
+MatricePlanaire& MatricePlanaire::operator=(const MatricePlanaire& matrice)
+{
+    if (this != &matrice)
+    {
+        MatricePlanaire copie(matrice);
+        for (size_t canal = 0; canal < planaire::NOMBRE_PLANS; ++canal)
+            plans_[canal].echanger(copie.plans_[canal]);
+    }
+    return *this;
+}
+
+/**
+ * @brief alloue un plan dont chaque ligne commence sur une frontiere de
+ * planaire::ALIGNEMENT octets ; ses octets valent tous 0
+ */
+Matrice<uint8_t> MatricePlanaire::creerPlan(size_t height, size_t width)
+{
+    size_t stride = (width + planaire::ALIGNEMENT - 1) / planaire::ALIGNEMENT;
+    stride *= planaire::ALIGNEMENT;
+    // Un espacement multiple de 512 octets envoie les lignes d'une tuile dans
+    // les memes ensembles du cache L1 : le pivotement par tuiles s'effondre
+    if (stride % 512 == 0)
+        stride += 2 * planaire::ALIGNEMENT;
+    uint8_t* octets = new (std::align_val_t(planaire::ALIGNEMENT)) uint8_t[height * stride]();
+    std::shared_ptr<void> stockage(octets, [](uint8_t* tampon) {
+        ::operator delete[](tampon, std::align_val_t(planaire::ALIGNEMENT));
+    });
+
+    return Matrice<uint8_t>(std::move(stockage), octets, height, width, stride);
+}
+
+/**
+ * @brief donne de nouvelles dimensions a la matrice sans conserver ses pixels,
+ * qui sont tous noirs ensuite
+ */
+void MatricePlanaire::reinitialiser(size_t height, size_t width)
+{
+    for (Matrice<uint8_t>& plan : plans_)
+    {
+        Matrice<uint8_t> nouveauPlan = creerPlan(height, width);
+        plan.echanger(nouveauPlan);
+    }
+}
+
+void MatricePlanaire::setHeight(size_t height)
+{
+    for (Matrice<uint8_t>& plan : plans_)
+        plan.setHeight(height);
+}
+
+void MatricePlanaire::setWidth(size_t width)
+{
+    for (Matrice<uint8_t>& plan : plans_)
+        plan.setWidth(width);
+}
+
+std::unique_ptr<MatricePlanaire> MatricePlanaire::clone() const
+{
+    return std::make_unique<MatricePlanaire>(*this);
+}
+
+/**
+ * @brief remplace la matrice par les pixels d'une matrice entrelacee
+ */
+void MatricePlanaire::depuisEntrelacee(const Matrice<Pixel>& matrice)
+{
+    reinitialiser(matrice.getHeight(), matrice.getWidth());
+
+    for (size_t h = 0; h < getHeight(); h++)
+    {
+        uint8_t* plans[planaire::NOMBRE_PLANS] = {plans_[planaire::ROUGE].getLigne(h),
+                                                  plans_[planaire::VERT].getLigne(h),
+                                                  plans_[planaire::BLEU].getLigne(h)};
+        separerCanaux(reinterpret_cast<const uint8_t*>(matrice.getLigne(h)), getWidth(), plans);
+    }
+}
+
+/**
+ * @brief retourne une copie de la matrice en pixels entrelaces
+ */
+std::unique_ptr<Matrice<Pixel>> MatricePlanaire::versEntrelacee() const
+{
+    auto matrice = std::make_unique<Matrice<Pixel>>(getHeight(), getWidth());
+
+    for (size_t h = 0; h < getHeight(); h++)
+    {
+        const uint8_t* plans[planaire::NOMBRE_PLANS] = {plans_[planaire::ROUGE].getLigne(h),
+                                                        plans_[planaire::VERT].getLigne(h),
+                                                        plans_[planaire::BLEU].getLigne(h)};
+        entrelacerCanaux(plans, getWidth(), reinterpret_cast<uint8_t*>(matrice->getLigne(h)));
+    }
+    return matrice;
+}
+
+/**
+ * @brief ajoute a la matrice les lignes d'un fichier texte, comme
+ * Matrice<Pixel>::chargerDepuisFichier
+ */
+bool MatricePlanaire::chargerDepuisFichier(const std::string& nomFichier)
+{
+    std::unique_ptr<Matrice<Pixel>> matrice = versEntrelacee();
+    if (!matrice->chargerDepuisFichier(nomFichier))
+        return false;
+
+    depuisEntrelacee(*matrice);
+    return true;
+}
+
+bool MatricePlanaire::sauvegarderFichierTexte(const std::string& nomFichier) const
+{
+    return versEntrelacee()->sauvegarderFichierTexte(nomFichier);
+}
+
+bool MatricePlanaire::lireElement(const std::string& elementFichier, const size_t& posY,
+                                  const size_t& posX)
+{
+    Pixel element;
+    LectureElement<Pixel>::lire(elementFichier.data(),
+                                elementFichier.data() + elementFichier.size(), element);
+
+    return ajouterElement(element, posY, posX);
+}
+
+/**
+ * @brief remplace la matrice par le contenu d'un fichier binaire de pixels ;
+ * contrairement a Matrice<Pixel>, les pixels sont copies dans les plans
+ */
+bool MatricePlanaire::chargerFichierBinaire(const std::string& nomFichier)
+{
+    Matrice<Pixel> matrice;
+    if (!matrice.chargerFichierBinaire(nomFichier))
+        return false;
+
+    depuisEntrelacee(matrice);
+    return true;
+}
+
+bool MatricePlanaire::sauvegarderFichierBinaire(const std::string& nomFichier) const
+{
+    return versEntrelacee()->sauvegarderFichierBinaire(nomFichier);
+}
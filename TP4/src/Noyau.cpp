@@ -0,0 +1,175 @@
+/*
+ * Titre : Noyau.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "Noyau.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief retrouve les facteurs vertical et horizontal d'un noyau
+     * separable, a partir de la ligne et de la colonne de son plus grand
+     * coefficient ; laisse le noyau tel quel s'il n'est pas separable
+     */
+    void separer(Noyau& noyau)
+    {
+        const std::vector<float>& coefficients = noyau.coefficients;
+        size_t pivot = 0;
+        for (size_t i = 1; i < coefficients.size(); ++i)
+            if (std::abs(coefficients[i]) > std::abs(coefficients[pivot]))
+                pivot = i;
+        float maximum = std::abs(coefficients[pivot]);
+        if (maximum == 0.0f)
+            return;
+
+        size_t ligne = pivot / noyau.width;
+        size_t colonne = pivot % noyau.width;
+        std::vector<float> vertical(noyau.height);
+        std::vector<float> horizontal(noyau.width);
+        for (size_t ky = 0; ky < noyau.height; ++ky)
+            vertical[ky] = coefficients[ky * noyau.width + colonne];
+        for (size_t kx = 0; kx < noyau.width; ++kx)
+            horizontal[kx] = coefficients[ligne * noyau.width + kx] / coefficients[pivot];
+
+        const float tolerance = 1e-5f * maximum;
+        for (size_t ky = 0; ky < noyau.height; ++ky)
+            for (size_t kx = 0; kx < noyau.width; ++kx)
+                if (std::abs(coefficients[ky * noyau.width + kx] - vertical[ky] * horizontal[kx]) >
+                    tolerance)
+                    return;
+
+        noyau.vertical = std::move(vertical);
+        noyau.horizontal = std::move(horizontal);
+    }
+} // namespace
+
+/**
+ * @brief vrai si les dimensions du noyau sont impaires et correspondent a
+ * ses coefficients (et a ses facteurs s'il est separable)
+ */
+bool Noyau::estValide() const
+{
+    return height % 2 == 1 && width % 2 == 1 && coefficients.size() == height * width &&
+           (vertical.empty() ? horizontal.empty()
+                             : vertical.size() == height && horizontal.size() == width);
+}
+
+/**
+ * @brief cree un noyau a partir de ses coefficients
+ * @param coefficients, height * width valeurs, ligne par ligne
+ * @param decalage, ajoute a chaque element destination
+ */
+Noyau creerNoyau(size_t height, size_t width, std::vector<float> coefficients, float decalage)
+{
+    Noyau noyau = {height, width, std::move(coefficients), {}, {}, decalage};
+    if (noyau.estValide())
+        separer(noyau);
+    return noyau;
+}
+
+/**
+ * @brief cree le noyau separable produit de vertical (une colonne) et de
+ * horizontal (une ligne)
+ */
+Noyau creerNoyauSeparable(std::vector<float> vertical, std::vector<float> horizontal,
+                          float decalage)
+{
+    Noyau noyau = {vertical.size(), horizontal.size(), {}, {}, {}, decalage};
+    noyau.coefficients.reserve(vertical.size() * horizontal.size());
+    for (float facteurVertical : vertical)
+        for (float facteurHorizontal : horizontal)
+            noyau.coefficients.push_back(facteurVertical * facteurHorizontal);
+    noyau.vertical = std::move(vertical);
+    noyau.horizontal = std::move(horizontal);
+    return noyau;
+}
+
+/**
+ * @brief flou par la moyenne du carre de cote 2 * rayon + 1
+ */
+Noyau noyauMoyenne(size_t rayon)
+{
+    std::vector<float> facteur(2 * rayon + 1, 1.0f / float(2 * rayon + 1));
+    return creerNoyauSeparable(facteur, facteur);
+}
+
+/**
+ * @brief flou gaussien d'ecart type sigma, tronque a 3 sigma et normalise
+ */
+Noyau noyauGaussien(float sigma)
+{
+    size_t rayon = size_t(std::ceil(3.0f * sigma));
+    std::vector<float> facteur(2 * rayon + 1);
+    float somme = 0.0f;
+    for (size_t i = 0; i < facteur.size(); ++i)
+    {
+        float distance = float(i) - float(rayon);
+        facteur[i] = sigma > 0.0f ? std::exp(-distance * distance / (2.0f * sigma * sigma)) : 1.0f;
+        somme += facteur[i];
+    }
+    for (float& poids : facteur)
+        poids /= somme;
+    return creerNoyauSeparable(facteur, facteur);
+}
+
+/**
+ * @brief gradient horizontal de Sobel, positif lorsque l'image s'eclaircit
+ * vers la droite ; pour des pixels, un decalage de 128 garde les gradients
+ * negatifs
+ */
+Noyau noyauSobelX()
+{
+    return creerNoyauSeparable({1.0f, 2.0f, 1.0f}, {-1.0f, 0.0f, 1.0f});
+}
+
+/**
+ * @brief gradient vertical de Sobel, positif lorsque l'image s'eclaircit
+ * vers le bas
+ */
+Noyau noyauSobelY()
+{
+    return creerNoyauSeparable({-1.0f, 0.0f, 1.0f}, {1.0f, 2.0f, 1.0f});
+}
+
+/**
+ * @brief accentuation : l'element moins force fois le laplacien de ses
+ * quatre voisins (noyau non separable)
+ */
+Noyau noyauNettete(float force)
+{
+    return creerNoyau(3, 3,
+                      {0.0f, -force, 0.0f, -force, 1.0f + 4.0f * force, -force, 0.0f, -force,
+                       0.0f});
+}
+
+size_t appliquerBord(std::ptrdiff_t position, size_t taille, Bord bord)
+{
+    std::ptrdiff_t n = std::ptrdiff_t(taille);
+    if (position >= 0 && position < n)
+        return size_t(position);
+
+    switch (bord)
+    {
+    case Bord::Miroir:
+    {
+        // Reflexion sans repeter l'element du bord : periode 2 * (taille - 1)
+        if (n == 1)
+            return 0;
+        std::ptrdiff_t periode = 2 * (n - 1);
+        std::ptrdiff_t reste = ((position % periode) + periode) % periode;
+        return size_t(reste < n ? reste : periode - reste);
+    }
+    case Bord::Periodique:
+        return size_t(((position % n) + n) % n);
+    case Bord::Zero:
+        return taille;
+    default:
+        return position < 0 ? 0 : taille - 1;
+    }
+}
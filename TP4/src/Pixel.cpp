@@ -28,17 +28,6 @@ Pixel::Pixel(uint8_t rouge, uint8_t vert, uint8_t bleu)
 {
 }
 
-/**
- * @brief surcharge de l'operateur = pour le constructeur de copie
- * @param pixel Le pixel duquel on souhaite copier les attributs
- */
-void Pixel::operator=(const Pixel& pixel)
-{
-    rouge_ = pixel.rouge_;
-    vert_ = pixel.vert_;
-    bleu_ = pixel.bleu_;
-}
-
 /**
  * @brief Setter de la couleur rouge
  * @param rouge La couleur rouge que l'on souhaite set
@@ -121,4 +110,59 @@ std::istream& operator>>(std::istream& is, Pixel& pixel)
     pixel.setBleu(bleu);
 
     return is;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Ajoute au tampon le texte de l'operateur << : '#' puis les trois
+ * composantes en hexadecimal majuscule sur deux chiffres
+ * @param pixel le pixel a afficher
+ * @param tampon le texte auquel ajouter le pixel
+ */
+void EcritureElement<Pixel>::afficher(const Pixel& pixel, std::string& tampon)
+{
+    static constexpr char CHIFFRES[] = "0123456789ABCDEF";
+    const uint8_t composantes[] = {pixel.getRouge(), pixel.getVert(), pixel.getBleu()};
+    char texte[9] = {'#'};
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        texte[1 + 3 * i] = CHIFFRES[composantes[i] >> 4];
+        texte[2 + 3 * i] = CHIFFRES[composantes[i] & 0xF];
+        if (i < 2)
+            texte[3 + 3 * i] = ' ';
+    }
+    tampon.append(texte, sizeof(texte));
+}
+
+/**
+ * @brief Ajoute au tampon la ligne "R G B" du format texte des matrices
+ * @param pixel le pixel a ecrire
+ * @param tampon le texte auquel ajouter le pixel
+ */
+void EcritureElement<Pixel>::ecrire(const Pixel& pixel, std::string& tampon)
+{
+    ecriture::ecrireEntier(pixel.getRouge(), tampon);
+    tampon += ' ';
+    ecriture::ecrireEntier(pixel.getVert(), tampon);
+    tampon += ' ';
+    ecriture::ecrireEntier(pixel.getBleu(), tampon);
+}
+
+/**
+ * @brief Lit les trois composantes d'un pixel directement dans le texte, avec
+ * la meme saturation que l'operateur >>
+ * @param debut debut du texte de la ligne
+ * @param fin fin du texte de la ligne
+ * @param pixel le pixel a remplir
+ */
+void LectureElement<Pixel>::lire(const char* debut, const char* fin, Pixel& pixel)
+{
+    int rouge = 0, vert = 0, bleu = 0;
+
+    debut = lecture::lireEntier(debut, fin, rouge);
+    debut = lecture::lireEntier(debut, fin, vert);
+    lecture::lireEntier(debut, fin, bleu);
+    pixel.setRouge(rouge);
+    pixel.setVert(vert);
+    pixel.setBleu(bleu);
+}
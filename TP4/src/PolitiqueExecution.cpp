@@ -0,0 +1,166 @@
+/*
+ * Titre : PolitiqueExecution.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "PolitiqueExecution.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // Plusieurs bandes par travailleur equilibrent les bandes plus couteuses
+    static constexpr size_t BANDES_PAR_TRAVAILLEUR = 4;
+}
+
+/**
+ * @brief constructeur par paramètre de la classe, demarre les travailleurs
+ * @param nombreTravailleurs, le nombre de threads du pool
+ */
+PoolTravailleurs::PoolTravailleurs(size_t nombreTravailleurs)
+    : arret_(false)
+{
+    for (size_t i = 0; i < nombreTravailleurs; i++)
+        travailleurs_.emplace_back(&PoolTravailleurs::travailler, this);
+}
+
+/**
+ * @brief destructeur de la classe, attend la fin des travailleurs
+ */
+PoolTravailleurs::~PoolTravailleurs()
+{
+    {
+        std::lock_guard<std::mutex> verrou(mutex_);
+        arret_ = true;
+    }
+    tacheDisponible_.notify_all();
+    for (std::thread& travailleur : travailleurs_)
+        travailleur.join();
+}
+
+/**
+ * @brief retourne le nombre de threads du pool
+ */
+size_t PoolTravailleurs::getNombreTravailleurs() const
+{
+    return travailleurs_.size();
+}
+
+/**
+ * @brief boucle d'un travailleur : execute les taches jusqu'a l'arret du pool
+ */
+void PoolTravailleurs::travailler()
+{
+    std::unique_lock<std::mutex> verrou(mutex_);
+    while (true)
+    {
+        tacheDisponible_.wait(verrou, [this] { return arret_ || !taches_.empty(); });
+        if (arret_ && taches_.empty())
+            return;
+        executerUneTache(verrou);
+    }
+}
+
+/**
+ * @brief retire une tache de la file et l'execute sans tenir le verrou
+ * @return false si la file etait vide
+ */
+bool PoolTravailleurs::executerUneTache(std::unique_lock<std::mutex>& verrou)
+{
+    if (taches_.empty())
+        return false;
+
+    std::function<void()> tache = std::move(taches_.front());
+    taches_.pop_front();
+    verrou.unlock();
+    tache();
+    verrou.lock();
+    return true;
+}
+
+/**
+ * @brief decoupe [0, taille) en nombreBandes bandes contigues, appelle
+ * tache(debut, fin) pour chacune et attend qu'elles soient toutes terminees.
+ * Le thread appelant execute lui aussi des bandes en attendant.
+ */
+void PoolTravailleurs::executerParBandes(size_t taille, size_t nombreBandes,
+                                         const std::function<void(size_t, size_t)>& tache)
+{
+    nombreBandes = std::min(nombreBandes, taille);
+    std::atomic<size_t> restantes(nombreBandes);
+    std::mutex mutexFin;
+    std::condition_variable fin;
+
+    {
+        std::lock_guard<std::mutex> verrou(mutex_);
+        for (size_t bande = 0; bande < nombreBandes; bande++)
+        {
+            size_t debut = taille * bande / nombreBandes;
+            size_t finBande = taille * (bande + 1) / nombreBandes;
+            taches_.emplace_back([&, debut, finBande] {
+                tache(debut, finBande);
+                // Decompte sous verrou : l'appelant ne peut pas detruire mutexFin et
+                // fin tant que la derniere bande les utilise
+                std::lock_guard<std::mutex> verrouFin(mutexFin);
+                if (--restantes == 0)
+                    fin.notify_all();
+            });
+        }
+    }
+    tacheDisponible_.notify_all();
+
+    {
+        std::unique_lock<std::mutex> verrou(mutex_);
+        while (restantes > 0 && executerUneTache(verrou))
+        {
+        }
+    }
+
+    std::unique_lock<std::mutex> verrouFin(mutexFin);
+    fin.wait(verrouFin, [&] { return restantes == 0; });
+}
+
+/**
+ * @brief constructeur par défaut de la classe, politique sequentielle
+ */
+PolitiqueExecution::PolitiqueExecution()
+{
+}
+
+/**
+ * @brief constructeur par paramètre de la classe
+ * @param nombreTravailleurs, le nombre de threads ; 0 ou 1 donne une politique
+ * sequentielle
+ */
+PolitiqueExecution::PolitiqueExecution(size_t nombreTravailleurs)
+{
+    if (nombreTravailleurs > 1)
+        pool_ = std::make_shared<PoolTravailleurs>(nombreTravailleurs);
+}
+
+/**
+ * @brief appelle tache(debut, fin) sur des bandes couvrant [0, taille), en
+ * parallele si la politique a un pool
+ */
+void PolitiqueExecution::executerParBandes(size_t taille,
+                                           const std::function<void(size_t, size_t)>& tache) const
+{
+    if (taille == 0)
+        return;
+
+    if (!pool_)
+        tache(0, taille);
+    else
+        pool_->executerParBandes(taille, pool_->getNombreTravailleurs() * BANDES_PAR_TRAVAILLEUR,
+                                 tache);
+}
+
+/**
+ * @brief retourne le nombre de threads utilises, 1 pour une politique sequentielle
+ */
+size_t PolitiqueExecution::getNombreTravailleurs() const
+{
+    return pool_ ? pool_->getNombreTravailleurs() : 1;
+}
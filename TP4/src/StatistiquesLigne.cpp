@@ -0,0 +1,139 @@
+/*
+ * Titre : StatistiquesLigne.cpp - Travail Pratique #4 - Programmation Orientée Objet
+ * Date : 27 Février 2020
+ * Auteur : Nabil Dabouz, Alexis Foulon et Florence Cloutier
+ */
+
+#include "StatistiquesLigne.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    template<size_t CANAUX>
+    void accumuler(const uint8_t* octets, size_t nombre, uint64_t* histogrammes)
+    {
+        constexpr size_t TABLE = CANAUX * 256;
+        size_t i = 0;
+
+        for (; i + COPIES_HISTOGRAMME <= nombre; i += COPIES_HISTOGRAMME)
+            for (size_t copie = 0; copie < COPIES_HISTOGRAMME; ++copie)
+                for (size_t canal = 0; canal < CANAUX; ++canal)
+                    ++histogrammes[copie * TABLE + canal * 256 +
+                                   octets[(i + copie) * CANAUX + canal]];
+
+        for (; i < nombre; ++i)
+            for (size_t canal = 0; canal < CANAUX; ++canal)
+                ++histogrammes[(i % COPIES_HISTOGRAMME) * TABLE + canal * 256 +
+                               octets[i * CANAUX + canal]];
+    }
+} // namespace
+
+void accumulerHistogrammes(const uint8_t* octets, size_t nombre, size_t canaux,
+                           uint64_t* histogrammes)
+{
+    if (canaux == 1)
+        accumuler<1>(octets, nombre, histogrammes);
+    else if (canaux == 3)
+        accumuler<3>(octets, nombre, histogrammes);
+    else
+        for (size_t i = 0; i < nombre; ++i)
+            for (size_t canal = 0; canal < canaux; ++canal)
+                ++histogrammes[(i % COPIES_HISTOGRAMME) * canaux * 256 + canal * 256 +
+                               octets[i * canaux + canal]];
+}
+
+void resumerEntiers(const int* valeurs, size_t nombre, ResumeEntiers& resume)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    __m256i minimums = _mm256_set1_epi32(resume.minimum);
+    __m256i maximums = _mm256_set1_epi32(resume.maximum);
+    __m256i sommes = _mm256_setzero_si256();
+    __m256d carres = _mm256_setzero_pd();
+    __m256d pivot = _mm256_set1_pd(resume.pivot);
+    for (; i + 8 <= nombre; i += 8)
+    {
+        __m256i huit = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valeurs + i));
+        __m128i bas = _mm256_castsi256_si128(huit);
+        __m128i haut = _mm256_extracti128_si256(huit, 1);
+        minimums = _mm256_min_epi32(minimums, huit);
+        maximums = _mm256_max_epi32(maximums, huit);
+        sommes = _mm256_add_epi64(sommes, _mm256_add_epi64(_mm256_cvtepi32_epi64(bas),
+                                                           _mm256_cvtepi32_epi64(haut)));
+        __m256d reelsBas = _mm256_sub_pd(_mm256_cvtepi32_pd(bas), pivot);
+        __m256d reelsHaut = _mm256_sub_pd(_mm256_cvtepi32_pd(haut), pivot);
+        carres = _mm256_add_pd(carres, _mm256_add_pd(_mm256_mul_pd(reelsBas, reelsBas),
+                                                     _mm256_mul_pd(reelsHaut, reelsHaut)));
+    }
+    alignas(32) int extremes[2][8];
+    alignas(32) int64_t partielles[4];
+    alignas(32) double partiellesCarres[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(extremes[0]), minimums);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(extremes[1]), maximums);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(partielles), sommes);
+    _mm256_store_pd(partiellesCarres, carres);
+    resume.minimum = *std::min_element(extremes[0], extremes[0] + 8);
+    resume.maximum = *std::max_element(extremes[1], extremes[1] + 8);
+    for (size_t k = 0; k < 4; ++k)
+    {
+        resume.somme += partielles[k];
+        resume.sommeCarres += partiellesCarres[k];
+    }
+    resume.somme -= int64_t(i) * resume.pivot;
+#elif defined(__SSE2__)
+    // SSE2 n'a ni pminsd ni pmaxsd : le minimum et le maximum passent par
+    // une comparaison et un masque
+    __m128i minimums = _mm_set1_epi32(resume.minimum);
+    __m128i maximums = _mm_set1_epi32(resume.maximum);
+    __m128i sommes = _mm_setzero_si128();
+    __m128d carres = _mm_setzero_pd();
+    __m128d pivot = _mm_set1_pd(resume.pivot);
+    for (; i + 4 <= nombre; i += 4)
+    {
+        __m128i quatre = _mm_loadu_si128(reinterpret_cast<const __m128i*>(valeurs + i));
+        __m128i plusGrands = _mm_cmpgt_epi32(quatre, minimums);
+        minimums = _mm_or_si128(_mm_and_si128(plusGrands, minimums),
+                                _mm_andnot_si128(plusGrands, quatre));
+        plusGrands = _mm_cmpgt_epi32(quatre, maximums);
+        maximums = _mm_or_si128(_mm_and_si128(plusGrands, quatre),
+                                _mm_andnot_si128(plusGrands, maximums));
+
+        __m128i signes = _mm_srai_epi32(quatre, 31);
+        sommes = _mm_add_epi64(sommes, _mm_add_epi64(_mm_unpacklo_epi32(quatre, signes),
+                                                     _mm_unpackhi_epi32(quatre, signes)));
+        __m128d reelsBas = _mm_sub_pd(_mm_cvtepi32_pd(quatre), pivot);
+        __m128d reelsHaut = _mm_sub_pd(
+            _mm_cvtepi32_pd(_mm_shuffle_epi32(quatre, _MM_SHUFFLE(1, 0, 3, 2))), pivot);
+        carres = _mm_add_pd(carres, _mm_add_pd(_mm_mul_pd(reelsBas, reelsBas),
+                                               _mm_mul_pd(reelsHaut, reelsHaut)));
+    }
+    alignas(16) int extremes[2][4];
+    alignas(16) int64_t partielles[2];
+    alignas(16) double partiellesCarres[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(extremes[0]), minimums);
+    _mm_store_si128(reinterpret_cast<__m128i*>(extremes[1]), maximums);
+    _mm_store_si128(reinterpret_cast<__m128i*>(partielles), sommes);
+    _mm_store_pd(partiellesCarres, carres);
+    resume.minimum = *std::min_element(extremes[0], extremes[0] + 4);
+    resume.maximum = *std::max_element(extremes[1], extremes[1] + 4);
+    resume.somme += partielles[0] + partielles[1] - int64_t(i) * resume.pivot;
+    resume.sommeCarres += partiellesCarres[0] + partiellesCarres[1];
+#endif
+
+    for (; i < nombre; ++i)
+    {
+        resume.minimum = std::min(resume.minimum, valeurs[i]);
+        resume.maximum = std::max(resume.maximum, valeurs[i]);
+        resume.somme += int64_t(valeurs[i]) - resume.pivot;
+        double ecart = double(valeurs[i]) - double(resume.pivot);
+        resume.sommeCarres += ecart * ecart;
+    }
+}
@@ -5,15 +5,86 @@
  * \date 27 Février 2020
  **/
 
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <set>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
+#include "CouleurInternee.h"
+#include "FichierPPM.h"
 #include "Image.h"
 #include "Matrice.h"
+#include "MatriceFixe.h"
+#include "MatricePlanaire.h"
+#include "MatriceTuilee.h"
+#include "MatriceVue.h"
 #include "Pixel.h"
+#include "TableSommes.h"
 #include "debogageMemoire.h"
 
+/**
+ * @brief egalite de deux elements : Pixel n'a pas d'operateur ==
+ */
+template<typename T>
+bool memeElement(const T& premier, const T& second)
+{
+    return premier == second;
+}
+
+inline bool memeElement(const Pixel& premier, const Pixel& second)
+{
+    return premier.getRouge() == second.getRouge() && premier.getVert() == second.getVert() &&
+           premier.getBleu() == second.getBleu();
+}
+
+inline bool memeElement(const Couleur& premiere, const Couleur& seconde)
+{
+    // L'operateur == de Couleur n'est pas const
+    return Couleur(premiere) == seconde;
+}
+
+/**
+ * @brief remplit la matrice avec les elements donnes ligne par ligne
+ * @param width, le nombre d'elements par ligne
+ */
+template<class M, typename T>
+void remplirMatrice(M& matrice, size_t width, const std::vector<T>& elements)
+{
+    for (size_t i = 0; i < elements.size(); i++)
+        matrice.ajouterElement(elements[i], i / width, i % width);
+}
+
+/**
+ * @brief vrai si la matrice a les dimensions height x width et les elements
+ * attendus, donnes ligne par ligne
+ */
+template<class M, typename T>
+bool estMatrice(const M& matrice, size_t height, size_t width, const std::vector<T>& elements)
+{
+    bool egale = (matrice.getHeight() == height) && (matrice.getWidth() == width);
+    for (size_t i = 0; egale && i < elements.size(); i++)
+        egale = memeElement(T(matrice(i / width, i % width)), elements[i]);
+    return egale;
+}
+
+/**
+ * @brief copie de la matrice transformee dans la direction donnee
+ */
+template<class M>
+M pivoter(const M& matrice, Direction direction)
+{
+    M copie(matrice);
+    PivoterMatrice<M>(&copie).pivoterMatrice(direction);
+    return copie;
+}
+
 // NOTE: Pour que le programme compile initialement, vous pouvez changer tous
 // les #if true à des #if false, et mettre en commentaire tout le code qui a été
 // écrit pour vous. Ainsi, vous pourrez graduellement les #if true et tester des
@@ -27,8 +98,8 @@ int main()
     Matrice<int> matriceNombres;
     if (matriceNombres.chargerDepuisFichier("matrice_nombres.txt"))
     {
-        Image<Matrice<int>>* imageNombres =
-            new Image<Matrice<int>>(std::make_unique<Matrice<int>>(matriceNombres));
+        Image<Matrice<int>>* imageNombres = new Image<Matrice<int>>(
+            std::make_unique<Matrice<int>>(std::move(matriceNombres)));
         std::cout << "############################## Affichage de la matrice des "
                      "entiers #############################"
                   << std::endl
@@ -52,8 +123,8 @@ int main()
     Matrice<Pixel> matricePixels;
     if (matricePixels.chargerDepuisFichier("matrice_pixel.txt"))
     {
-        Image<Matrice<Pixel>>* imagePixels =
-            new Image<Matrice<Pixel>>(std::make_unique<Matrice<Pixel>>(matricePixels));
+        Image<Matrice<Pixel>>* imagePixels = new Image<Matrice<Pixel>>(
+            std::make_unique<Matrice<Pixel>>(std::move(matricePixels)));
         std::cout << "############################## Affichage de la matrice des "
                      "pixels ##############################"
                   << std::endl
@@ -77,8 +148,8 @@ int main()
     Matrice<Couleur> matriceCouleur;
     if (matriceCouleur.chargerDepuisFichier("matrice_text.txt"))
     {
-        Image<Matrice<Couleur>>* imageCouleur =
-            new Image<Matrice<Couleur>>(std::make_unique<Matrice<Couleur>>(matriceCouleur));
+        Image<Matrice<Couleur>>* imageCouleur = new Image<Matrice<Couleur>>(
+            std::make_unique<Matrice<Couleur>>(std::move(matriceCouleur)));
         std::cout << "################# Affichage de la matrice des couleurs en "
                      "chaine de caracteres #################"
                   << std::endl
@@ -199,9 +270,916 @@ int main()
 #else
     tests.push_back(false);
 #endif
+    // Tests du format binaire
+#if true
+    Matrice<int> matriceBinaire(2, 3);
+    for (size_t i = 0; i < 6; i++)
+        matriceBinaire.ajouterElement(int(i) * 7, i / 3, i % 3);
+    Matrice<int> matriceRelue;
+    bool binaireTest = matriceBinaire.sauvegarderFichierBinaire("matrice_test.bin") &&
+                       matriceRelue.chargerFichierBinaire("matrice_test.bin");
+    binaireTest &= (matriceRelue.getHeight() == 2) && (matriceRelue.getWidth() == 3);
+    for (size_t i = 0; i < 6; i++)
+        binaireTest &= matriceRelue(i / 3, i % 3) == int(i) * 7;
+    tests.push_back(binaireTest);
+
+    // Entete tronque, elements manquants ou dimensions dont le produit deborde ;
+    // matriceRelue projette encore matrice_test.bin, qui ne doit pas changer
+    EnteteFichierBinaire entete = FormatBinaire<int>::creerEntete(2, 3);
+    std::ofstream fichierTronque("matrice_invalide.bin", std::ios::binary);
+    fichierTronque.write(reinterpret_cast<const char*>(&entete), sizeof(entete) / 2);
+    fichierTronque.close();
+    bool refusBinaireTest = !matriceRelue.chargerFichierBinaire("matrice_invalide.bin");
+    std::ofstream fichierIncomplet("matrice_invalide.bin", std::ios::binary);
+    fichierIncomplet.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    fichierIncomplet.write(reinterpret_cast<const char*>(matriceBinaire.getLigne(0)),
+                           5 * sizeof(int));
+    fichierIncomplet.close();
+    refusBinaireTest &= !matriceRelue.chargerFichierBinaire("matrice_invalide.bin");
+    entete = FormatBinaire<int>::creerEntete(size_t(1) << 62, 4);
+    std::ofstream fichierDemesure("matrice_invalide.bin", std::ios::binary);
+    fichierDemesure.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    fichierDemesure.write(reinterpret_cast<const char*>(matriceBinaire.getLigne(0)),
+                          sizeof(int));
+    fichierDemesure.close();
+    refusBinaireTest &= !matriceRelue.chargerFichierBinaire("matrice_invalide.bin");
+    refusBinaireTest &= (matriceRelue.getHeight() == 2) && (matriceRelue(1, 2) == 35);
+    std::remove("matrice_test.bin");
+    std::remove("matrice_invalide.bin");
+    tests.push_back(refusBinaireTest);
+#else
+    tests.push_back(false);
+    tests.push_back(false);
+#endif
+    // Tests des pivotements de chaque representation, sur 2 x 3 et 3 x 3
+#if true
+    std::vector<int> nombres = {1, 2, 3, 4, 5, 6};
+    std::vector<int> carres = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Matrice<int> rectangle(2, 3);
+    remplirMatrice(rectangle, 3, nombres);
+    Matrice<int> carre(3, 3);
+    remplirMatrice(carre, 3, carres);
+    bool pivoterEntiersTest =
+        estMatrice(pivoter(rectangle, Direction::Right), 3, 2, std::vector<int>{4, 1, 5, 2, 6, 3});
+    pivoterEntiersTest &=
+        estMatrice(pivoter(rectangle, Direction::Left), 3, 2, std::vector<int>{3, 6, 2, 5, 1, 4});
+    pivoterEntiersTest &= estMatrice(pivoter(rectangle, Direction::UpsideDown), 2, 3,
+                                     std::vector<int>{6, 5, 4, 3, 2, 1});
+    pivoterEntiersTest &= estMatrice(pivoter(rectangle, Direction::FlipHorizontal), 2, 3,
+                                     std::vector<int>{3, 2, 1, 6, 5, 4});
+    pivoterEntiersTest &= estMatrice(pivoter(rectangle, Direction::FlipVertical), 2, 3,
+                                     std::vector<int>{4, 5, 6, 1, 2, 3});
+    pivoterEntiersTest &= estMatrice(pivoter(carre, Direction::Right), 3, 3,
+                                     std::vector<int>{7, 4, 1, 8, 5, 2, 9, 6, 3});
+    pivoterEntiersTest &= estMatrice(pivoter(carre, Direction::Left), 3, 3,
+                                     std::vector<int>{3, 6, 9, 2, 5, 8, 1, 4, 7});
+    // Plusieurs blocs du pivotement par tuiles : l'element (y, x) vaut 100 * y + x
+    Matrice<int> grande(70, 45);
+    for (size_t i = 0; i < 70 * 45; i++)
+        grande.ajouterElement(int(i / 45 * 100 + i % 45), i / 45, i % 45);
+    Matrice<int> grandePivotee = pivoter(grande, Direction::Right);
+    pivoterEntiersTest &= (grandePivotee.getHeight() == 45) && (grandePivotee.getWidth() == 70);
+    for (size_t i = 0; pivoterEntiersTest && i < 70 * 45; i++)
+        pivoterEntiersTest = grandePivotee(i % 45, 69 - i / 45) == int(i / 45 * 100 + i % 45);
+    tests.push_back(pivoterEntiersTest);
+
+    std::vector<Pixel> pixels = {Pixel(1, 2, 3),   Pixel(40, 50, 60), Pixel(7, 8, 9),
+                                 Pixel(100, 0, 0), Pixel(0, 200, 0),  Pixel(0, 0, 250)};
+    Matrice<Pixel> rectanglePixels(2, 3);
+    remplirMatrice(rectanglePixels, 3, pixels);
+    bool pivoterPixelsTest =
+        estMatrice(pivoter(rectanglePixels, Direction::Right), 3, 2,
+                   std::vector<Pixel>{pixels[3], pixels[0], pixels[4], pixels[1], pixels[5],
+                                      pixels[2]});
+    pivoterPixelsTest &=
+        estMatrice(pivoter(rectanglePixels, Direction::Left), 3, 2,
+                   std::vector<Pixel>{pixels[2], pixels[5], pixels[1], pixels[4], pixels[0],
+                                      pixels[3]});
+    pivoterPixelsTest &=
+        estMatrice(pivoter(rectanglePixels, Direction::UpsideDown), 2, 3,
+                   std::vector<Pixel>{pixels[5], pixels[4], pixels[3], pixels[2], pixels[1],
+                                      pixels[0]});
+    tests.push_back(pivoterPixelsTest);
+
+    MatricePlanaire planaire(rectanglePixels);
+    bool pivoterPlanaireTest =
+        estMatrice(pivoter(planaire, Direction::Right), 3, 2,
+                   std::vector<Pixel>{pixels[3], pixels[0], pixels[4], pixels[1], pixels[5],
+                                      pixels[2]});
+    pivoterPlanaireTest &=
+        estMatrice(pivoter(planaire, Direction::Left), 3, 2,
+                   std::vector<Pixel>{pixels[2], pixels[5], pixels[1], pixels[4], pixels[0],
+                                      pixels[3]});
+    pivoterPlanaireTest &=
+        estMatrice(pivoter(planaire, Direction::FlipHorizontal), 2, 3,
+                   std::vector<Pixel>{pixels[2], pixels[1], pixels[0], pixels[5], pixels[4],
+                                      pixels[3]});
+    tests.push_back(pivoterPlanaireTest);
+
+    // Budget nul : seules tuilee::TUILES_MINIMUM tuiles restent en memoire
+    MatriceTuilee<int> rectangleTuile(2, 3, 0);
+    remplirMatrice(rectangleTuile, 3, nombres);
+    bool pivoterTuileeTest = estMatrice(pivoter(rectangleTuile, Direction::Right), 3, 2,
+                                        std::vector<int>{4, 1, 5, 2, 6, 3});
+    pivoterTuileeTest &= estMatrice(pivoter(rectangleTuile, Direction::Left), 3, 2,
+                                    std::vector<int>{3, 6, 2, 5, 1, 4});
+    pivoterTuileeTest &= estMatrice(pivoter(rectangleTuile, Direction::FlipVertical), 2, 3,
+                                    std::vector<int>{4, 5, 6, 1, 2, 3});
+    // 5 x 3 tuiles, plus que le cache : des tuiles passent par le fichier
+    MatriceTuilee<int> grandeTuilee(600, 300, 0);
+    for (size_t i = 0; i < 600 * 300; i++)
+        grandeTuilee.ajouterElement(int(i), i / 300, i % 300);
+    PivoterMatrice<MatriceTuilee<int>>(&grandeTuilee).pivoterMatrice(Direction::Left);
+    pivoterTuileeTest &= (grandeTuilee.getHeight() == 300) && (grandeTuilee.getWidth() == 600);
+    for (size_t i = 0; pivoterTuileeTest && i < 600 * 300; i++)
+        pivoterTuileeTest = grandeTuilee(299 - i % 300, i / 300) == int(i);
+    tests.push_back(pivoterTuileeTest);
+
+    Matrice<int, 2, 3> rectangleFixe(std::array<int, 6>{1, 2, 3, 4, 5, 6});
+    Matrice<int, 3, 3> carreFixe(std::array<int, 9>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+    bool pivoterFixeTest = estMatrice(rectangleFixe.pivotee<Direction::Right>(), 3, 2,
+                                      std::vector<int>{4, 1, 5, 2, 6, 3});
+    pivoterFixeTest &= estMatrice(rectangleFixe.pivotee<Direction::Left>(), 3, 2,
+                                  std::vector<int>{3, 6, 2, 5, 1, 4});
+    // Un quart de tour sur place ne peut pas echanger les dimensions fixes
+    pivoterFixeTest &=
+        !PivoterMatrice<Matrice<int, 2, 3>>(&rectangleFixe).pivoterMatrice(Direction::Right);
+    pivoterFixeTest &= estMatrice(pivoter(rectangleFixe, Direction::UpsideDown), 2, 3,
+                                  std::vector<int>{6, 5, 4, 3, 2, 1});
+    pivoterFixeTest &= estMatrice(pivoter(carreFixe, Direction::Right), 3, 3,
+                                  std::vector<int>{7, 4, 1, 8, 5, 2, 9, 6, 3});
+    pivoterFixeTest &= estMatrice(pivoter(carreFixe, Direction::Left), 3, 3,
+                                  std::vector<int>{3, 6, 9, 2, 5, 8, 1, 4, 7});
+    tests.push_back(pivoterFixeTest);
+#else
+    tests.push_back(false);
+    tests.push_back(false);
+    tests.push_back(false);
+    tests.push_back(false);
+    tests.push_back(false);
+#endif
+    // Tests du filtre Box : chaque element source pese la part qu'en couvre
+    // l'element destination, ici 2/3 et 1/3 de part et d'autre
+#if true
+    Matrice<int> ligneBoite(2, 3);
+    remplirMatrice(ligneBoite, 3, std::vector<int>{0, 30, 90, 300, 300, 0});
+    RedimensionnerMatrice<Matrice<int>>(&ligneBoite).redimensionner(2, 2, Filtre::Box);
+    bool boiteTest = estMatrice(ligneBoite, 2, 2, std::vector<int>{10, 70, 300, 100});
+    // Agrandissement de 2 a 4 elements : chaque source couvre deux destinations
+    RedimensionnerMatrice<Matrice<int>>(&ligneBoite).redimensionner(2, 4, Filtre::Box);
+    boiteTest &= estMatrice(ligneBoite, 2, 4, std::vector<int>{10, 10, 70, 70, 300, 300, 100, 100});
+    // Agrandissement vertical : chaque ligne source sert a deux lignes destination
+    Image<Matrice<int>> imageBoite(std::make_unique<Matrice<int>>(ligneBoite));
+    imageBoite.redimensionnerImage(size_t(4), size_t(4), Filtre::Box);
+    std::vector<int> colonnesDoublees = {10,  10,  70,  70,  10,  10,  70,  70,
+                                         300, 300, 100, 100, 300, 300, 100, 100};
+    boiteTest &= estMatrice(*imageBoite.getMatrice(), 4, 4, colonnesDoublees);
+    // Un facteur negatif ou NaN laisse l'image intacte
+    imageBoite.redimensionnerImage(-2.0f, Filtre::Box);
+    imageBoite.redimensionnerImage(std::nanf(""), Filtre::Bilinear);
+    boiteTest &= estMatrice(*imageBoite.getMatrice(), 4, 4, colonnesDoublees);
+    tests.push_back(boiteTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests du mode differe : pivotement, agrandissement x3 et miroir, appliques
+    // en une passe, donnent la meme image qu'appliques un a un
+#if true
+    // Resultat attendu : rectangle pivote a droite puis retourne, {1, 4; 2, 5; 3, 6},
+    // chaque element devenant un bloc de 3 x 3
+    std::vector<int> base = {1, 4, 2, 5, 3, 6};
+    std::vector<int> attendus(9 * 6);
+    for (size_t i = 0; i < attendus.size(); i++)
+        attendus[i] = base[i / 6 / 3 * 2 + i % 6 / 3];
+    auto transformer = [](auto& image, bool differe) {
+        image.setModeDiffere(differe);
+        image.pivoterMatrice(Direction::Right);
+        image.redimensionnerImage(3);
+        image.pivoterMatrice(Direction::FlipHorizontal);
+    };
+
+    Image<Matrice<int>> imageDifferee(std::make_unique<Matrice<int>>(rectangle));
+    Image<Matrice<int>> imageImmediate(std::make_unique<Matrice<int>>(rectangle));
+    transformer(imageDifferee, true);
+    transformer(imageImmediate, false);
+    bool differeTest = imageDifferee.estEgale(imageImmediate);
+    differeTest &= estMatrice(*imageDifferee.getMatrice(), 9, 6, attendus);
+
+    Image<Matrice<Pixel>> pixelsDifferes(std::make_unique<Matrice<Pixel>>(rectanglePixels));
+    Image<Matrice<Pixel>> pixelsImmediats(std::make_unique<Matrice<Pixel>>(rectanglePixels));
+    transformer(pixelsDifferes, true);
+    transformer(pixelsImmediats, false);
+    differeTest &= pixelsDifferes.estEgale(pixelsImmediats);
+    differeTest &= memeElement((*pixelsDifferes.getMatrice())(8, 5), pixels[5]);
+
+    // Les matrices non contigues sont remplies element par element
+    Image<MatriceTuilee<int>> tuileeDifferee(
+        std::make_unique<MatriceTuilee<int>>(rectangleTuile));
+    transformer(tuileeDifferee, true);
+    differeTest &= estMatrice(*tuileeDifferee.getMatrice(), 9, 6, attendus);
+    tests.push_back(differeTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la comparaison : nombre de cellules differentes et boite englobante
+#if true
+    Matrice<int> reference(4, 40);
+    for (size_t i = 0; i < 4 * 40; i++)
+        reference.ajouterElement(int(i % 7), i / 40, i % 40);
+    Matrice<int> modifiee(reference);
+    ComparerMatrices<Matrice<int>> comparaison(&reference);
+    bool comparaisonTest =
+        comparaison.estEgale(modifiee) && (comparaison.comparer(modifiee).nombre == 0);
+    modifiee.ajouterElement(100, 1, 33);
+    modifiee.ajouterElement(100, 3, 2);
+    Difference difference = comparaison.comparer(modifiee);
+    comparaisonTest &= !comparaison.estEgale(modifiee) && (difference.nombre == 2);
+    comparaisonTest &= (difference.debutY == 1) && (difference.debutX == 2) &&
+                       (difference.finY == 4) && (difference.finX == 34);
+    // Une colonne de plus : ses quatre cellules ne sont que dans une des matrices
+    Matrice<int> elargie(reference);
+    elargie.setWidth(41);
+    difference = comparaison.comparer(elargie);
+    comparaisonTest &= !comparaison.estEgale(elargie) && (difference.nombre == 4);
+    comparaisonTest &= (difference.debutY == 0) && (difference.debutX == 40) &&
+                       (difference.finY == 4) && (difference.finX == 41);
+
+    Matrice<Pixel> pixelsModifies(rectanglePixels);
+    pixelsModifies.ajouterElement(Pixel(40, 51, 60), 0, 1);
+    difference = ComparerMatrices<Matrice<Pixel>>(&rectanglePixels).comparer(pixelsModifies);
+    comparaisonTest &= (difference.nombre == 1) && (difference.debutY == 0) &&
+                       (difference.debutX == 1) && (difference.finY == 1) &&
+                       (difference.finX == 2);
+    tests.push_back(comparaisonTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la convolution : modes de bord, chemins separable et plein, arrondis
+#if true
+    // dest(y, x) = source(y - 2, x + 2) : les bords haut et droit sont lus
+    Noyau decalage = creerNoyauSeparable({1, 0, 0, 0, 0}, {0, 0, 0, 0, 1});
+    Noyau decalagePlein = decalage;
+    decalagePlein.vertical.clear();
+    decalagePlein.horizontal.clear();
+    std::vector<int> source(25);
+    std::iota(source.begin(), source.end(), 1);
+    std::vector<std::pair<Bord, std::vector<int>>> bords = {
+        {Bord::Etendre, {3,  4,  5,  5,  5,
+                         3,  4,  5,  5,  5,
+                         3,  4,  5,  5,  5,
+                         8,  9,  10, 10, 10,
+                         13, 14, 15, 15, 15}},
+        {Bord::Miroir, {13, 14, 15, 14, 13,
+                        8,  9,  10, 9,  8,
+                        3,  4,  5,  4,  3,
+                        8,  9,  10, 9,  8,
+                        13, 14, 15, 14, 13}},
+        {Bord::Periodique, {18, 19, 20, 16, 17,
+                            23, 24, 25, 21, 22,
+                            3,  4,  5,  1,  2,
+                            8,  9,  10, 6,  7,
+                            13, 14, 15, 11, 12}},
+        {Bord::Zero, {0,  0,  0,  0, 0,
+                      0,  0,  0,  0, 0,
+                      3,  4,  5,  0, 0,
+                      8,  9,  10, 0, 0,
+                      13, 14, 15, 0, 0}}};
+    bool convolutionTest = decalage.estSeparable() && !decalagePlein.estSeparable();
+    for (const auto& [bord, attendu] : bords)
+    {
+        Matrice<int> separable(5, 5);
+        remplirMatrice(separable, 5, source);
+        Matrice<int> plein(separable);
+        convolutionTest &= ConvoluerMatrice<Matrice<int>>(&separable).convoluer(decalage, bord);
+        convolutionTest &= ConvoluerMatrice<Matrice<int>>(&plein).convoluer(decalagePlein, bord);
+        convolutionTest &= estMatrice(separable, 5, 5, attendu) && estMatrice(plein, 5, 5, attendu);
+    }
+
+    // Un entier est arrondi au plus proche (moitie loin de zero) sans etre borne
+    Matrice<int> entiers(1, 4);
+    remplirMatrice(entiers, 4, std::vector<int>{5, -5, 3, 600});
+    convolutionTest &= ConvoluerMatrice<Matrice<int>>(&entiers).convoluer(creerNoyau(1, 1, {0.5f}));
+    convolutionTest &= estMatrice(entiers, 1, 4, std::vector<int>{3, -3, 2, 300});
+
+    // Un canal de Pixel est arrondi puis borne a [0, 255]
+    Matrice<Pixel> moities(1, 1);
+    remplirMatrice(moities, 1, std::vector<Pixel>{Pixel(5, 3, 200)});
+    Matrice<Pixel> bornes(moities);
+    ConvoluerMatrice<Matrice<Pixel>>(&moities).convoluer(creerNoyau(1, 1, {0.5f}));
+    ConvoluerMatrice<Matrice<Pixel>>(&bornes).convoluer(creerNoyau(1, 1, {2.0f}, -20.0f));
+    convolutionTest &= memeElement(moities(0, 0), Pixel(3, 2, 100));
+    convolutionTest &= memeElement(bornes(0, 0), Pixel(0, 0, 255));
+    tests.push_back(convolutionTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests des statistiques : minimum, maximum, moyenne, ecart type et histogramme
+#if true
+    auto estCanal = [](const StatistiquesCanal& canal, double minimum, double maximum,
+                       double moyenne, double ecartType) {
+        return canal.minimum == minimum && canal.maximum == maximum &&
+               std::abs(canal.moyenne - moyenne) < 1e-9 &&
+               std::abs(canal.ecartType - ecartType) < 1e-9;
+    };
+    // Huit lignes identiques, pour passer par les blocs vectoriels des entiers
+    const int serie[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    Matrice<int> mesures(8, 8);
+    for (size_t i = 0; i < 64; i++)
+        mesures.ajouterElement(serie[i % 8], i / 8, i % 8);
+    StatistiquesImage statistiques = StatistiquesMatrice<Matrice<int>>(&mesures).calculer();
+    bool statistiquesTest = statistiques.nombre == 64 && statistiques.canaux.size() == 1;
+    statistiquesTest = statistiquesTest && estCanal(statistiques.canaux[0], 2, 9, 5, 2) &&
+                       statistiques.canaux[0].histogramme.empty();
+
+    Matrice<Pixel> couleurs(2, 2);
+    remplirMatrice(couleurs, 2,
+                   std::vector<Pixel>{Pixel(0, 10, 255), Pixel(2, 10, 255), Pixel(4, 20, 0),
+                                      Pixel(6, 20, 0)});
+    statistiques = StatistiquesMatrice<Matrice<Pixel>>(&couleurs).calculer();
+    statistiquesTest &= statistiques.nombre == 4 && statistiques.canaux.size() == 3;
+    if (statistiquesTest)
+    {
+        const StatistiquesCanal& rouge = statistiques.canaux[0];
+        const StatistiquesCanal& vert = statistiques.canaux[1];
+        const StatistiquesCanal& bleu = statistiques.canaux[2];
+        statistiquesTest &= estCanal(rouge, 0, 6, 3, std::sqrt(5.0)) &&
+                            estCanal(vert, 10, 20, 15, 5) && estCanal(bleu, 0, 255, 127.5, 127.5);
+        statistiquesTest &= rouge.histogramme.size() == 256 && rouge.histogramme[0] == 1 &&
+                            rouge.histogramme[2] == 1 && rouge.histogramme[6] == 1 &&
+                            rouge.histogramme[1] == 0;
+        statistiquesTest &= vert.histogramme[10] == 2 && vert.histogramme[20] == 2 &&
+                            bleu.histogramme[0] == 2 && bleu.histogramme[255] == 2;
+    }
+
+    // Grandes valeurs presque egales : la moyenne des carres moins le carre
+    // de la moyenne s'annulerait ; un ou quatre threads donnent le meme resultat
+    Matrice<int> grandes(64, 64);
+    MatriceTuilee<int> grandesTuilees(64, 64);
+    for (size_t i = 0; i < 64 * 64; i++)
+    {
+        grandes.ajouterElement(1000000000 + int(i % 2), i / 64, i % 64);
+        grandesTuilees.ajouterElement(10000000 + int(i % 2), i / 64, i % 64);
+    }
+    for (size_t travailleurs : {size_t(0), size_t(4)})
+    {
+        PolitiqueExecution politique =
+            travailleurs == 0 ? PolitiqueExecution() : PolitiqueExecution(travailleurs);
+        statistiques = StatistiquesMatrice<Matrice<int>>(&grandes, politique).calculer();
+        statistiquesTest &= statistiques.canaux[0].moyenne == 1000000000.5 &&
+                            statistiques.canaux[0].ecartType == 0.5 &&
+                            statistiques.canaux[0].minimum == 1000000000 &&
+                            statistiques.canaux[0].maximum == 1000000001;
+    }
+    statistiques = StatistiquesMatrice<MatriceTuilee<int>>(&grandesTuilees).calculer();
+    statistiquesTest &= estCanal(statistiques.canaux[0], 10000000, 10000001, 10000000.5, 0.5);
+
+    Matrice<int> vide;
+    statistiques = StatistiquesMatrice<Matrice<int>>(&vide).calculer();
+    statistiquesTest &= statistiques.nombre == 0 && statistiques.canaux.size() == 1 &&
+                        estCanal(statistiques.canaux[0], 0, 0, 0, 0);
+    tests.push_back(statistiquesTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la table des sommes : sommes apres une modification et un redimensionnement
+#if true
+    Matrice<int> cumulee(4, 5);
+    std::vector<int> valeurs(20);
+    std::iota(valeurs.begin(), valeurs.end(), 1);
+    remplirMatrice(cumulee, 5, valeurs);
+    TableSommes<Matrice<int>> table(&cumulee);
+    // Lignes 1 et 2, colonnes 1 a 3 : 7 + 8 + 9 + 12 + 13 + 14
+    bool sommesTest = (table.somme(0, 0, 4, 5) == 210) && (table.somme(1, 1, 2, 3) == 63);
+
+    // 13 devient 100 par la table, 20 devient 0 directement dans la matrice
+    sommesTest &= table.ajouterElement(100, 2, 2);
+    sommesTest &= (table.somme(1, 1, 2, 3) == 150) && (table.somme(0, 0, 4, 5) == 297);
+    cumulee.ajouterElement(0, 3, 4);
+    table.invalider(3);
+    sommesTest &= (table.somme(0, 0, 4, 5) == 277) && (table.somme(3, 4, 1, 1) == 0);
+
+    // Deux lignes de moins : la table est reconstruite et les rectangles bornes
+    cumulee.setHeight(2);
+    sommesTest &= (table.somme(0, 0, 4, 5) == 55) && (table.somme(1, 0, 5, 5) == 40);
+    sommesTest &= (table.moyenne(0, 0, 2, 5) == 5.5);
+
+    TableSommes<Matrice<Pixel>> tablePixels(&rectanglePixels);
+    sommesTest &= (tablePixels.somme(0, 0, 2, 3, 2) == 322) &&
+                  (tablePixels.somme(0, 1, 2, 1, 0) == 40);
+    tests.push_back(sommesTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests du format PPM : aller-retour P3 et P6, commentaires et entetes invalides
+#if true
+    std::stringstream texte;
+    std::stringstream octets(std::ios::in | std::ios::out | std::ios::binary);
+    Matrice<Pixel> relue;
+    bool ppmTest = ecrirePPM(texte, rectanglePixels, FormatPPM::Texte) &&
+                   texte.str().compare(0, 3, "P3\n") == 0 && lirePPM(texte, relue) &&
+                   estMatrice(relue, 2, 3, pixels);
+    // Deux images P6 a la suite : la lecture s'arrete au debut de la seconde
+    ppmTest &= ecrirePPM(octets, rectanglePixels) && ecrirePPM(octets, pixelsModifies);
+    ppmTest &= lirePPM(octets, relue) && estMatrice(relue, 2, 3, pixels);
+    ppmTest &= lirePPM(octets, relue) && memeElement(relue(0, 1), Pixel(40, 51, 60));
+
+    std::stringstream commentee("P3\n# cree a la main\n2 1 # largeur hauteur\n15\n"
+                                "15 0 5 # premier pixel\n0 15 0\n");
+    ppmTest &= lirePPM(commentee, relue) &&
+               estMatrice(relue, 1, 2, std::vector<Pixel>{Pixel(255, 0, 85), Pixel(0, 255, 0)});
+
+    // Chaque entete invalide est refusee et laisse la matrice intacte
+    const char* invalides[] = {"P4\n1 1\n255\n0 0 0\n", "P3\n1 x\n255\n0 0 0\n",
+                               "P3\n1 1\n0\n0 0 0\n",   "P3\n1 1\n70000\n0 0 0\n",
+                               "P3\n1 1\n255\n256 0 0\n", "P6\n2 1\n255\nabc"};
+    for (const char* invalide : invalides)
+    {
+        std::stringstream flux(invalide);
+        ppmTest &= !lirePPM(flux, relue) && (relue.getWidth() == 2) &&
+                   memeElement(relue(0, 0), Pixel(255, 0, 85));
+    }
+    tests.push_back(ppmTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la rotation d'un angle quelconque : quarts de tour exacts et cadre conserve
+#if true
+    auto tourner = [](auto matrice, double degres, Cadre cadre = Cadre::Englober) {
+        PivoterMatrice<decltype(matrice)>(&matrice).pivoterAngle(degres, Filtre::NearestNeighbour,
+                                                                 cadre, {});
+        return matrice;
+    };
+    const std::pair<double, Direction> quarts[] = {{90, Direction::Right},
+                                                   {180, Direction::UpsideDown},
+                                                   {270, Direction::Left},
+                                                   {-90, Direction::Left},
+                                                   {450, Direction::Right}};
+    ComparerMatrices<Matrice<int>> comparerEntiers(&rectangle);
+    ComparerMatrices<Matrice<Pixel>> comparerPixels(&rectanglePixels);
+    bool rotationTest = comparerEntiers.estEgale(tourner(rectangle, 0)) &&
+                        comparerPixels.estEgale(tourner(rectanglePixels, 360));
+    for (const auto& [degres, direction] : quarts)
+    {
+        Matrice<int> entiersTournes = tourner(rectangle, degres);
+        Matrice<Pixel> pixelsTournes = tourner(rectanglePixels, degres);
+        rotationTest &= ComparerMatrices<Matrice<int>>(&entiersTournes)
+                            .estEgale(pivoter(rectangle, direction));
+        rotationTest &= ComparerMatrices<Matrice<Pixel>>(&pixelsTournes)
+                            .estEgale(pivoter(rectanglePixels, direction));
+    }
+
+    // Un quart de tour dans un cadre 3x5 conserve : les colonnes 0 et 4 sortent
+    // de la source et recoivent le fond, le centre (1, 2) ne bouge pas
+    Matrice<int> cadre(3, 5);
+    std::vector<int> elementsCadre(15);
+    std::iota(elementsCadre.begin(), elementsCadre.end(), 1);
+    remplirMatrice(cadre, 5, elementsCadre);
+    Matrice<int> quartConserve(cadre);
+    rotationTest &= PivoterMatrice<Matrice<int>>(&quartConserve)
+                        .pivoterAngle(90, Filtre::NearestNeighbour, Cadre::Conserver, -1);
+    rotationTest &= estMatrice(quartConserve, 3, 5,
+                               std::vector<int>{-1, 12, 7, 2, -1,
+                                                -1, 13, 8, 3, -1,
+                                                -1, 14, 9, 4, -1});
+    Matrice<int> oblique = tourner(cadre, 45, Cadre::Conserver);
+    rotationTest &= (oblique.getHeight() == 3) && (oblique.getWidth() == 5) && (oblique(1, 2) == 8);
+    tests.push_back(rotationTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la lecture texte : CRLF, espaces, signes, debordements et element orphelin
+#if true
+    auto ecrireTexte = [](const char* nomFichier, const char* contenu) {
+        std::ofstream(nomFichier, std::ios::binary) << contenu;
+    };
+    ecrireTexte("matrice_lecture.txt", "L\r\n+7  \r\n-3\t\r\nL\r\n12 \r\n\r\n99999999999\r\n");
+    Matrice<int> entiersLus;
+    bool lectureTest = entiersLus.chargerDepuisFichier("matrice_lecture.txt") &&
+                       estMatrice(entiersLus, 2, 2,
+                                  std::vector<int>{7, -3, 12, std::numeric_limits<int>::max()});
+
+    ecrireTexte("matrice_lecture.txt", "L\n-99999999999\n");
+    Matrice<int> minimum;
+    lectureTest &= minimum.chargerDepuisFichier("matrice_lecture.txt") &&
+                   estMatrice(minimum, 1, 1, std::vector<int>{std::numeric_limits<int>::min()});
+
+    // Chaque composante est bornee a [0, 255]
+    ecrireTexte("matrice_lecture.txt", "L\r\n300 -4 +20 \r\n");
+    Matrice<Pixel> pixelsLus;
+    lectureTest &= pixelsLus.chargerDepuisFichier("matrice_lecture.txt") &&
+                   estMatrice(pixelsLus, 1, 1, std::vector<Pixel>{Pixel(255, 0, 20)});
+
+    // Un element avant le premier "L" n'appartient a aucune ligne : echec
+    ecrireTexte("matrice_lecture.txt", "5\nL\n1\n");
+    Matrice<int> orpheline;
+    lectureTest &= !orpheline.chargerDepuisFichier("matrice_lecture.txt") &&
+                   (orpheline.getHeight() == 0) && (orpheline.getWidth() == 0);
+    std::remove("matrice_lecture.txt");
+    tests.push_back(lectureTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests des noyaux d'agrandissement : rapports 2, 3 et 4, largeurs hors des blocs vectoriels
+#if true
+    auto agrandiEstExact = [](const auto& source, unsigned int rapport) {
+        auto agrandie = source;
+        AgrandirMatrice<std::decay_t<decltype(source)>>(&agrandie).redimensionnerImage(rapport);
+        bool exact = (agrandie.getHeight() == source.getHeight() * rapport) &&
+                     (agrandie.getWidth() == source.getWidth() * rapport);
+        for (size_t y = 0; exact && y < agrandie.getHeight(); y++)
+            for (size_t x = 0; exact && x < agrandie.getWidth(); x++)
+                exact = memeElement(agrandie(y, x), source(y / rapport, x / rapport));
+        return exact;
+    };
+    // 13 et 7 colonnes : des blocs de 4 entiers, de 5 pixels ou de 16 octets plus une fin
+    Matrice<int> ligneEntiers(2, 13);
+    Matrice<Pixel> lignePixels(2, 13);
+    for (size_t i = 0; i < 26; i++)
+    {
+        ligneEntiers.ajouterElement(int(i) * 7 - 50, i / 13, i % 13);
+        lignePixels.ajouterElement(Pixel(int(i) * 3, 255 - int(i), int(i) * 11), i / 13, i % 13);
+    }
+    Matrice<int> colonnesEntiers(ligneEntiers);
+    colonnesEntiers.setWidth(7);
+    MatricePlanaire plansPixels(lignePixels);
+    bool agrandirTest = true;
+    for (unsigned int rapport = 2; rapport <= 4; rapport++)
+    {
+        agrandirTest &= agrandiEstExact(ligneEntiers, rapport);
+        agrandirTest &= agrandiEstExact(colonnesEntiers, rapport);
+        agrandirTest &= agrandiEstExact(lignePixels, rapport);
+        agrandirTest &= agrandiEstExact(plansPixels, rapport);
+    }
+    tests.push_back(agrandirTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la politique d'execution : le resultat ne depend pas du nombre de travailleurs
+#if true
+    auto transformerEnParallele = [](const Matrice<Pixel>& depart, PolitiqueExecution politique) {
+        Image<Matrice<Pixel>> image(std::make_unique<Matrice<Pixel>>(depart), politique);
+        image.pivoterMatrice(Direction::Right);
+        image.redimensionnerImage(3);
+        image.redimensionnerImage(size_t(50), size_t(41), Filtre::Bilinear);
+        image.redimensionnerImage(size_t(20), size_t(17), Filtre::Box);
+        image.pivoterAngle(30.0);
+        return Matrice<Pixel>(*image.getMatrice());
+    };
+    // 37 lignes : plusieurs bandes par travailleur, de tailles inegales
+    Matrice<Pixel> depart(37, 29);
+    for (size_t i = 0; i < 37 * 29; i++)
+        depart.ajouterElement(Pixel(int(i % 256), int(i * 7 % 256), int(i * 13 % 256)), i / 29,
+                              i % 29);
+    Matrice<Pixel> sequentielle = transformerEnParallele(depart, PolitiqueExecution());
+    ComparerMatrices<Matrice<Pixel>> comparerPolitiques(&sequentielle);
+    bool politiqueTest =
+        comparerPolitiques.estEgale(transformerEnParallele(depart, PolitiqueExecution(1))) &&
+        comparerPolitiques.estEgale(transformerEnParallele(depart, PolitiqueExecution(4)));
+    tests.push_back(politiqueTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests des operations de couleur : noyaux vectoriels compares a un calcul pixel par pixel,
+    // sur des largeurs qui couvrent les blocs vectoriels et leur fin
+#if true
+    auto canalDe = [](const Pixel& pixel, size_t canal) {
+        return int(canal == 0 ? pixel.getRouge() : canal == 1 ? pixel.getVert() : pixel.getBleu());
+    };
+    auto arrondir = [](float valeur) {
+        return int(std::min(std::max(valeur, 0.0f), 255.0f) + 0.5f);
+    };
+    auto ajuster = [](auto& matrice) {
+        return AjusterCouleurs<std::decay_t<decltype(matrice)>>(&matrice);
+    };
+    bool couleursTest = true;
+    for (size_t width : {15, 16, 17, 33})
+    {
+        Matrice<Pixel> source(2, width);
+        Matrice<Pixel> autres(2, width);
+        for (size_t i = 0; i < 2 * width; i++)
+        {
+            int n = int(i);
+            source.ajouterElement(Pixel((n * 97 + 13) % 256, (n * 61 + 200) % 256,
+                                        (n * 29 + 77) % 256),
+                                  i / width, i % width);
+            autres.ajouterElement(Pixel(n * 53 % 256, 255 - n * 7 % 256, n * 11 % 256), i / width,
+                                  i % width);
+        }
+        MatricePlanaire autresPlans(autres);
+
+        // operation(matrice, autres) est appliquee aux deux representations, puis
+        // chaque canal est compare a reference(pixel source, canal, posY, posX)
+        auto essayer = [&](auto operation, auto reference) {
+            Matrice<Pixel> entrelacee(source);
+            MatricePlanaire plans(source);
+            operation(entrelacee, autres);
+            operation(plans, autresPlans);
+            bool exact = true;
+            for (size_t y = 0; y < 2; y++)
+                for (size_t x = 0; x < width; x++)
+                    for (size_t canal = 0; canal < 3; canal++)
+                    {
+                        int attendu = reference(source(y, x), canal, y, x);
+                        exact &= canalDe(entrelacee(y, x), canal) == attendu &&
+                                 canalDe(plans(y, x), canal) == attendu;
+                    }
+            return exact;
+        };
+
+        couleursTest &= essayer(
+            [&](auto& matrice, const auto&) { ajuster(matrice).convertirEnGris(); },
+            [&](const Pixel& pixel, size_t, size_t, size_t) {
+                return (77 * canalDe(pixel, 0) + 150 * canalDe(pixel, 1) + 29 * canalDe(pixel, 2) +
+                        128) /
+                       256;
+            });
+        couleursTest &= essayer(
+            [&](auto& matrice, const auto& autre) { ajuster(matrice).additionner(autre); },
+            [&](const Pixel& pixel, size_t canal, size_t y, size_t x) {
+                return std::min(255, canalDe(pixel, canal) + canalDe(autres(y, x), canal));
+            });
+        for (int luminosite : {255, -255, 37, -37})
+            couleursTest &= essayer(
+                [&](auto& matrice, const auto&) {
+                    ajuster(matrice).ajusterLuminositeContraste(luminosite, 1.0f);
+                },
+                [&](const Pixel& pixel, size_t canal, size_t, size_t) {
+                    return std::min(255, std::max(0, canalDe(pixel, canal) + luminosite));
+                });
+        couleursTest &= essayer(
+            [&](auto& matrice, const auto&) {
+                ajuster(matrice).ajusterLuminositeContraste(-20, 1.5f);
+            },
+            [&](const Pixel& pixel, size_t canal, size_t, size_t) {
+                return arrondir((float(canalDe(pixel, canal)) - 128.0f) * 1.5f + 128.0f - 20.0f);
+            });
+        for (float gamma : {0.5f, 2.2f})
+            couleursTest &= essayer(
+                [&](auto& matrice, const auto&) { ajuster(matrice).appliquerGamma(gamma); },
+                [&](const Pixel& pixel, size_t canal, size_t, size_t) {
+                    float valeur = float(canalDe(pixel, canal)) / 255.0f;
+                    return arrondir(255.0f * std::pow(valeur, gamma));
+                });
+
+        // Une permutation et une permutation qui repete un canal
+        const std::array<Canal, 3> ordres[] = {{Canal::Vert, Canal::Bleu, Canal::Rouge},
+                                               {Canal::Bleu, Canal::Rouge, Canal::Rouge}};
+        for (const std::array<Canal, 3>& ordre : ordres)
+            couleursTest &= essayer(
+                [&](auto& matrice, const auto&) {
+                    ajuster(matrice).permuterCanaux(ordre[0], ordre[1], ordre[2]);
+                },
+                [&](const Pixel& pixel, size_t canal, size_t, size_t) {
+                    return canalDe(pixel, size_t(ordre[canal]));
+                });
+    }
+    tests.push_back(couleursTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de l'aller-retour texte : sauvegarde puis relecture de chaque type d'element
+#if true
+    auto relireTexte = [](const auto& matrice) {
+        std::decay_t<decltype(matrice)> relue;
+        bool relu = matrice.sauvegarderFichierTexte("matrice_aller_retour.txt") &&
+                    relue.chargerDepuisFichier("matrice_aller_retour.txt");
+        std::remove("matrice_aller_retour.txt");
+        return std::make_pair(relu, relue);
+    };
+    Matrice<int> entiersSauves(2, 3);
+    std::vector<int> entiersAttendus = {0, -7, std::numeric_limits<int>::min(), 42, 1, 100000};
+    remplirMatrice(entiersSauves, 3, entiersAttendus);
+    auto [entiersRelus, entiersRelue] = relireTexte(entiersSauves);
+    bool allerRetourTest = entiersRelus && estMatrice(entiersRelue, 2, 3, entiersAttendus);
+
+    auto [pixelsRelus, pixelsRelue] = relireTexte(rectanglePixels);
+    allerRetourTest &= pixelsRelus && estMatrice(pixelsRelue, 2, 3, pixels);
+
+    std::vector<Couleur> couleursAttendues = {Couleur("Abricot"), Couleur("Acajou"),
+                                              Couleur("L2"), Couleur("Amarante")};
+    Matrice<Couleur> couleursSauvees(2, 2);
+    remplirMatrice(couleursSauvees, 2, couleursAttendues);
+    auto [couleursRelues, couleursRelue] = relireTexte(couleursSauvees);
+    allerRetourTest &= couleursRelues && estMatrice(couleursRelue, 2, 2, couleursAttendues);
+
+    // Un nom vide ou "L" ne se relirait pas a sa place : la sauvegarde echoue
+    for (const char* nom : {"", "L", "  "})
+    {
+        Matrice<Couleur> illisible(couleursSauvees);
+        illisible.ajouterElement(Couleur(nom), 0, 1);
+        allerRetourTest &= !relireTexte(illisible).first;
+    }
+    tests.push_back(allerRetourTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests du deplacement et du double tampon : matrice deplacee vide et reutilisable,
+    // tampon partage qui alterne avec la matrice d'une operation a l'autre
+#if true
+    Matrice<int> aDeplacer(rectangle);
+    Matrice<int> deplacee(std::move(aDeplacer));
+    bool tamponTest = estMatrice(deplacee, 2, 3, nombres) && (aDeplacer.getHeight() == 0) &&
+                      (aDeplacer.getWidth() == 0);
+    aDeplacer.setHeight(1);
+    aDeplacer.setWidth(2);
+    tamponTest &= aDeplacer.ajouterElement(5, 0, 1) && (aDeplacer(0, 1) == 5);
+    Matrice<int> affectee(carre);
+    affectee = std::move(aDeplacer);
+    tamponTest &= (affectee.getHeight() == 1) && (affectee(0, 1) == 5) &&
+                  (aDeplacer.getHeight() == 0) && (aDeplacer.getWidth() == 0);
+    aDeplacer = std::move(deplacee);
+    tamponTest &= estMatrice(aDeplacer, 2, 3, nombres);
+
+    // Chaque operation ecrit dans l'autre tampon : deux adresses seulement,
+    // quelle que soit l'operation, tant que la taille ne grandit pas
+    Image<Matrice<int>> alternee(std::make_unique<Matrice<int>>(rectangle));
+    const int* premier = alternee.getMatrice()->getLigne(0);
+    alternee.pivoterMatrice(Direction::Right);
+    const int* second = alternee.getMatrice()->getLigne(0);
+    alternee.pivoterMatrice(Direction::Left);
+    tamponTest &= (second != premier) && (alternee.getMatrice()->getLigne(0) == premier);
+    alternee.redimensionnerImage(size_t(3), size_t(2), Filtre::Bilinear);
+    tamponTest &= alternee.getMatrice()->getLigne(0) == second;
+    // Un miroir se fait sur place, sans changer de tampon
+    alternee.pivoterMatrice(Direction::FlipHorizontal);
+    tamponTest &= alternee.getMatrice()->getLigne(0) == second;
+    alternee.pivoterMatrice(Direction::Right);
+    tamponTest &= (alternee.getMatrice()->getLigne(0) == premier) &&
+                  (alternee.getMatrice()->getHeight() == 2);
+    tests.push_back(tamponTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests des couleurs internees : identifiants, chargement, affichage et acces concurrents
+#if true
+    auto afficherPivotee = [](auto matrice) {
+        using M = std::decay_t<decltype(matrice)>;
+        Image<M> image(std::make_unique<M>(std::move(matrice)));
+        image.pivoterMatrice(Direction::Right);
+        std::stringstream affichage;
+        affichage << &image;
+        return affichage.str();
+    };
+    Matrice<Couleur> couleursTexte;
+    Matrice<CouleurInternee> internees;
+    size_t nomsAvant = CouleurInternee::getNombreNoms();
+    bool interneeTest = couleursTexte.chargerDepuisFichier("matrice_text.txt") &&
+                        internees.chargerDepuisFichier("matrice_text.txt");
+    // Chaque nom distinct du fichier, sauf "Noir" deja present, est range une fois
+    std::set<std::string> nomsDistincts;
+    for (size_t y = 0; y < couleursTexte.getHeight(); y++)
+        for (size_t x = 0; x < couleursTexte.getWidth(); x++)
+        {
+            std::string nom;
+            EcritureElement<Couleur>::ecrire(couleursTexte(y, x), nom);
+            if (nom != "Noir")
+                nomsDistincts.insert(nom);
+        }
+    interneeTest &= CouleurInternee::getNombreNoms() == nomsAvant + nomsDistincts.size();
+    Matrice<CouleurInternee> relues;
+    interneeTest &= relues.chargerDepuisFichier("matrice_text.txt") &&
+                    CouleurInternee::getNombreNoms() == nomsAvant + nomsDistincts.size();
+    interneeTest &= afficherPivotee(internees) == afficherPivotee(couleursTexte);
+
+    // Un meme nom donne un meme identifiant, et operator== ne compare que lui
+    CouleurInternee abricot("Abricot");
+    interneeTest &= (abricot == CouleurInternee(Couleur("Abricot"))) &&
+                    (abricot.getIdentifiant() == internees(0, 0).getIdentifiant()) &&
+                    (abricot != CouleurInternee("Acajou")) && (abricot.getNom() == "Abricot") &&
+                    (CouleurInternee().getNom() == "Noir") &&
+                    (CouleurInternee().getIdentifiant() == 0);
+
+    // Deux threads internent les memes noms nouveaux, dans des ordres opposes
+    std::vector<std::string> nouveaux(500);
+    for (size_t i = 0; i < nouveaux.size(); i++)
+        nouveaux[i] = "Teinte" + std::to_string(i);
+    std::vector<uint32_t> endroit(nouveaux.size());
+    std::vector<uint32_t> envers(nouveaux.size());
+    nomsAvant = CouleurInternee::getNombreNoms();
+    std::thread premierThread([&] {
+        for (size_t i = 0; i < nouveaux.size(); i++)
+            endroit[i] = CouleurInternee::interner(nouveaux[i].data(),
+                                                   nouveaux[i].data() + nouveaux[i].size());
+    });
+    for (size_t i = nouveaux.size(); i-- > 0;)
+        envers[i] = CouleurInternee::interner(nouveaux[i].data(),
+                                              nouveaux[i].data() + nouveaux[i].size());
+    premierThread.join();
+    interneeTest &= (endroit == envers) &&
+                    (CouleurInternee::getNombreNoms() == nomsAvant + nouveaux.size()) &&
+                    (std::set<uint32_t>(endroit.begin(), endroit.end()).size() == nouveaux.size());
+    tests.push_back(interneeTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests des vues : une region d'une matrice, ecrite et transformee sur place
+#if true
+    Matrice<int> grille(4, 5);
+    std::vector<int> elementsGrille(20);
+    std::iota(elementsGrille.begin(), elementsGrille.end(), 0);
+    remplirMatrice(grille, 5, elementsGrille);
+
+    // Ce qui est ecrit dans la vue l'est dans la matrice d'origine
+    MatriceVue<int> centre(grille, 1, 1, 2, 3);
+    bool vueTest = centre.estVue() && centre.getStride() == grille.getStride() &&
+                   estMatrice(centre, 2, 3, std::vector<int>{6, 7, 8, 11, 12, 13});
+    centre.ajouterElement(-1, 0, 0);
+    centre.getLigne(1)[2] = -2;
+    vueTest &= grille.getLigne(1)[1] == -1 && grille.getLigne(2)[3] == -2 &&
+               !centre.ajouterElement(0, 2, 0) && grille.getLigne(3)[1] == 16;
+
+    // La region est bornee aux bords de la matrice
+    MatriceVue<int> coin(grille, 2, 3, 10, 10);
+    MatriceVue<int> dehors(grille, 9, 9, 2, 2);
+    vueTest &= estMatrice(coin, 2, 2, std::vector<int>{-2, 14, 18, 19}) &&
+               dehors.getHeight() == 0 && dehors.getWidth() == 0;
+
+    // Une region carree pivote sur place, sans toucher au reste de la matrice
+    MatriceVue<int> carreVue(grille, 0, 0, 2, 2);
+    PivoterMatrice<MatriceVue<int>>(&carreVue).pivoterMatrice(Direction::Right);
+    vueTest &= carreVue.estVue() &&
+               estMatrice(grille, 4, 5,
+                          std::vector<int>{5, 0, 2, 3, 4, -1, 1, 7, 8, 9, 10, 11, 12, -2, 14,
+                                           15, 16, 17, 18, 19});
+
+    // Une region rectangulaire pivotee recoit son propre tampon
+    MatriceVue<int> bande(grille, 1, 0, 2, 5);
+    PivoterMatrice<MatriceVue<int>>(&bande).pivoterMatrice(Direction::Left);
+    vueTest &= !bande.estVue() &&
+               estMatrice(bande, 5, 2, std::vector<int>{9, 14, 8, -2, 7, 12, 1, 11, -1, 10}) &&
+               estMatrice(grille, 4, 5,
+                          std::vector<int>{5, 0, 2, 3, 4, -1, 1, 7, 8, 9, 10, 11, 12, -2, 14,
+                                           15, 16, 17, 18, 19});
+
+    // copierDepuis recopie le resultat dans une region de memes dimensions
+    PivoterMatrice<MatriceVue<int>>(&bande).pivoterMatrice(Direction::Left);
+    MatriceVue<int> regionBande(grille, 1, 0, 2, 5);
+    vueTest &= !regionBande.copierDepuis(carreVue) && regionBande.copierDepuis(bande) &&
+               estMatrice(grille, 4, 5,
+                          std::vector<int>{5, 0, 2, 3, 4, 14, -2, 12, 11, 10, 9, 8, 7, 1, -1,
+                                           15, 16, 17, 18, 19});
+    tests.push_back(vueTest);
+#else
+    tests.push_back(false);
+#endif
+    // Tests de la pyramide : niveaux choisis, reductions et memoire occupee
+#if true
+    // Rampe a coefficients pairs : chaque moyenne Box d'un bloc de 2^k x 2^k
+    // est entiere, une reduction depuis un niveau est donc exacte
+    Matrice<int> rampe(64, 64);
+    for (size_t i = 0; i < 64 * 64; i++)
+        rampe.ajouterElement(int(i / 64) * 6 + int(i % 64) * 2, i / 64, i % 64);
+
+    PyramideMatrice<Matrice<int>> pyramide(&rampe);
+    bool pyramideTest = pyramide.getNombreNiveaux() == 7 && pyramide.choisirNiveau(64, 64) == 0 &&
+                        pyramide.choisirNiveau(100, 10) == 0 &&
+                        pyramide.choisirNiveau(33, 32) == 0 &&
+                        pyramide.choisirNiveau(32, 32) == 1 && pyramide.choisirNiveau(5, 3) == 3 &&
+                        pyramide.choisirNiveau(1, 1) == 6;
+
+    // Les niveaux d'une matrice a peu pres carree occupent au plus le tiers
+    // de sa taille
+    const size_t dimensionsPleines[][2] = {{64, 64}, {37, 29}};
+    for (const auto& dimensions : dimensionsPleines)
+    {
+        Matrice<int> pleine(dimensions[0], dimensions[1]);
+        PyramideMatrice<Matrice<int>> niveaux(&pleine);
+        size_t occupes = 0;
+        for (size_t niveau = 1; niveau < niveaux.getNombreNiveaux(); niveau++)
+            occupes += niveaux.getNiveau(niveau).getHeight() * niveaux.getNiveau(niveau).getWidth();
+        const Matrice<int>& dernier = niveaux.getNiveau(niveaux.getNombreNiveaux() - 1);
+        pyramideTest &= 3 * occupes <= pleine.getHeight() * pleine.getWidth() &&
+                        dernier.getHeight() == 1 && dernier.getWidth() == 1;
+    }
+
+    // Une reduction servie par un niveau egale celle faite depuis la matrice
+    Image<Matrice<int>> depuisMatrice(std::make_unique<Matrice<int>>(rampe));
+    Image<Matrice<int>> depuisNiveaux(std::make_unique<Matrice<int>>(rampe));
+    depuisNiveaux.setPyramide(true);
+    for (size_t cote : {size_t(32), size_t(16), size_t(8), size_t(1)})
+    {
+        std::unique_ptr<Matrice<int>> attendue =
+            depuisMatrice.copieRedimensionnee(cote, cote, Filtre::Box);
+        pyramideTest &= ComparerMatrices<Matrice<int>>(attendue.get())
+                            .estEgale(*depuisNiveaux.copieRedimensionnee(cote, cote, Filtre::Box));
+    }
+
+    // Les niveaux calcules avant une transformation ne servent plus apres
+    Matrice<int> quart = *depuisMatrice.copieRedimensionnee(16, 16, Filtre::Box);
+    depuisNiveaux.pivoterMatrice(Direction::Right);
+    Matrice<int> quartPivote = pivoter(quart, Direction::Right);
+    ComparerMatrices<Matrice<int>> memeQuart(&quartPivote);
+    pyramideTest &= memeQuart.estEgale(*depuisNiveaux.copieRedimensionnee(16, 16, Filtre::Box));
+    depuisNiveaux.redimensionnerImage(2u);
+    pyramideTest &= memeQuart.estEgale(*depuisNiveaux.copieRedimensionnee(16, 16, Filtre::Box));
+    tests.push_back(pyramideTest);
+#else
+    tests.push_back(false);
+#endif
 
     // Affichage
-    std::vector<float> ponderationTests = {1, 1, 1, 1, 1, 1, 2, 1, 1, 3, 4};
+    std::vector<float> ponderationTests = {1, 1, 1, 1, 1, 1, 2, 1, 1, 3, 4, 1, 1, 1, 1, 1, 1, 1, 1,
+                                           1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
     float totalPoints = 0;
     for (std::size_t i = 0; i < tests.size(); i++)
     {
@@ -219,6 +1197,63 @@ int main()
         case 10:
             std::cout << "La classe PivoterMatrice -------------- /4" << std::endl;
             break;
+        case 11:
+            std::cout << "Le format binaire --------------------- /2" << std::endl;
+            break;
+        case 13:
+            std::cout << "Les pivotements ----------------------- /5" << std::endl;
+            break;
+        case 18:
+            std::cout << "Le redimensionnement ------------------ /1" << std::endl;
+            break;
+        case 19:
+            std::cout << "Le mode differe ----------------------- /1" << std::endl;
+            break;
+        case 20:
+            std::cout << "La comparaison ------------------------ /1" << std::endl;
+            break;
+        case 21:
+            std::cout << "La convolution ------------------------ /1" << std::endl;
+            break;
+        case 22:
+            std::cout << "Les statistiques ---------------------- /1" << std::endl;
+            break;
+        case 23:
+            std::cout << "La table des sommes ------------------- /1" << std::endl;
+            break;
+        case 24:
+            std::cout << "Le format PPM ------------------------- /1" << std::endl;
+            break;
+        case 25:
+            std::cout << "La rotation quelconque ---------------- /1" << std::endl;
+            break;
+        case 26:
+            std::cout << "La lecture texte ---------------------- /1" << std::endl;
+            break;
+        case 27:
+            std::cout << "Les noyaux d'agrandissement ----------- /1" << std::endl;
+            break;
+        case 28:
+            std::cout << "La politique d'execution -------------- /1" << std::endl;
+            break;
+        case 29:
+            std::cout << "Les operations de couleur ------------- /1" << std::endl;
+            break;
+        case 30:
+            std::cout << "L'aller-retour texte ------------------ /1" << std::endl;
+            break;
+        case 31:
+            std::cout << "Le double tampon ---------------------- /1" << std::endl;
+            break;
+        case 32:
+            std::cout << "Les couleurs internees ---------------- /1" << std::endl;
+            break;
+        case 33:
+            std::cout << "Les vues ------------------------------ /1" << std::endl;
+            break;
+        case 34:
+            std::cout << "La pyramide --------------------------- /1" << std::endl;
+            break;
         default:
             break;
         }